@@ -1,878 +1,263 @@
-// cb_movegen.c: generates a list of legal moves
-// 	getmovelist()
-//	is the only function which cb_movegen.c exports. it takes a Board8x8 as
-//  board with the following representation, color to move, and returns a
-//  list of CBmoves.
-
-#include "CB_movegen.h"
-#include "checkers_types.h"
-#include <assert.h> // For assert
-#include <string.h> // For memcpy
-
-/* exported functions */
-int getmovelist(int color, CBmove movelist[MAXMOVES], Board8x8 board, int *isjump);
-
-/* internal functions */
-static int makemovelist(int color, CBmove movelist[MAXMOVES], int b[12][12], int *isjump);
-static void board8toboard12(Board8x8 board, int board12[12][12]);
-static void whitecapture(int board[12][12], CBmove movelist[MAXMOVES], CBmove m, int x, int y, int d);
-static void blackcapture(int board[12][12], CBmove movelist[MAXMOVES], CBmove m, int x, int y, int d);
-static void whitekingcapture(int board[12][12], CBmove movelist[MAXMOVES], CBmove m, int x, int y, int d);
-static void blackkingcapture(int board[12][12], CBmove movelist[MAXMOVES], CBmove m, int x, int y, int d);
-
-static int n;
-
-static inline int cbcolor_to_getmovelistcolor(int cbcolor)
-{
-	if (cbcolor == CB_BLACK)
-		return(1);
-	else
-		return(-1);
-}
-
-int getmovelist(int color, CBmove m[MAXMOVES], Board8x8 b, int *isjump)
-{
-	int i, j;
-	int n;
-	int board12[12][12];
-
-	board8toboard12(b, board12);
-	assert(color == CB_BLACK || color == CB_WHITE);
-	n = makemovelist(cbcolor_to_getmovelistcolor(color), m, board12, isjump);
-
-	// now: do something to the coordinates, so that the moves are in a 8x8-format
-	for (i = 0; i < n; i++) {
-		m[i].from.x -= 2;
-		m[i].to.x -= 2;
-		m[i].from.y -= 2;
-		m[i].to.y -= 2;
-		for (j = 0; j < 11; j++) {
-			m[i].path[j].x -= 2;
-			m[i].path[j].y -= 2;
-			m[i].del[j].x -= 2;
-			m[i].del[j].y -= 2;
-		}
-	}
-
-	// and set the pieces to CB-format
-	for (i = 0; i < n; i++) {
-		switch (m[i].oldpiece) {
-		case -2:
-			m[i].oldpiece = (CB_WHITE | CB_KING);
-			break;
-
-		case -1:
-			m[i].oldpiece = (CB_WHITE | CB_MAN);
-			break;
-
-		case 1:
-			m[i].oldpiece = (CB_BLACK | CB_MAN);
-			break;
-
-		case 2:
-			m[i].oldpiece = (CB_BLACK | CB_KING);
-			break;
-		}
-
-		switch (m[i].newpiece) {
-		case -2:
-			m[i].newpiece = (CB_WHITE | CB_KING);
-			break;
-
-		case -1:
-			m[i].newpiece = (CB_WHITE | CB_MAN);
-			break;
-
-		case 1:
-			m[i].newpiece = (CB_BLACK | CB_MAN);
-			break;
-
-		case 2:
-			m[i].newpiece = (CB_BLACK | CB_KING);
-			break;
-		}
-
-		for (j = 0; j < m[i].jumps; j++) {
-			switch (m[i].delpiece[j]) {
-			case -2:
-				m[i].delpiece[j] = (CB_WHITE | CB_KING);
-				break;
-
-			case -1:
-				m[i].delpiece[j] = (CB_WHITE | CB_MAN);
-				break;
-
-			case 1:
-				m[i].delpiece[j] = (CB_BLACK | CB_MAN);
-				break;
-
-			case 2:
-				m[i].delpiece[j] = (CB_BLACK | CB_KING);
-				break;
-			}
-		}
-	}
-
-	return n;
-}
-
-void board8toboard12(Board8x8 board8, int board12[12][12])
-{
-	// checkerboard uses a 8x8 board representation, the move generator a 12x12
-	// this routine converts a 8x8 to a 12x12 board
-	int i, j;
-	for (i = 0; i <= 11; i++) {
-		for (j = 0; j <= 11; j++)
-			board12[i][j] = 10;
-	}
-
-	for (i = 2; i <= 9; i++) {
-		for (j = 2; j <= 9; j++)
-			board12[i][j] = 0;
-	}
-
-	for (i = 0; i <= 7; i++) {
-		for (j = 0; j <= 7; j++) {
-			if (board8[i][j] == (CB_BLACK | CB_MAN))
-				board12[i + 2][j + 2] = 1;
-			if (board8[i][j] == (CB_BLACK | CB_KING))
-				board12[i + 2][j + 2] = 2;
-			if (board8[i][j] == (CB_WHITE | CB_MAN))
-				board12[i + 2][j + 2] = -1;
-			if (board8[i][j] == (CB_WHITE | CB_KING))
-				board12[i + 2][j + 2] = -2;
-		}
-	}
-}
-
-int makemovelist(int color, CBmove movelist[MAXMOVES], int board[12][12], int *isjump)
-{
-	// produces a movelist for color to move on board
-	coor wk[12], bk[12], ws[12], bs[12];
-	int nwk = 0, nbk = 0, nws = 0, nbs = 0;
-	int i, j;
-	int x, y;
-	CBmove m;
-	*isjump = 0;
-
-	for (i = 0; i < MAXMOVES; i++)
-		movelist[i].jumps = 0;
-	n = 0;
-
-	// initialize list of stones
-	for (j = 2; j <= 8; j += 2) {
-		for (i = 2; i <= 8; i += 2) {
-			if (board[i][j] == 0)
-				continue;
-			if (board[i][j] == 1) {
-				ws[nws].x = i;
-				ws[nws].y = j;
-				nws++;
-				continue;
-			}
-
-			if (board[i][j] == 2) {
-				wk[nwk].x = i;
-				wk[nwk].y = j;
-				nwk++;
-				continue;
-			}
-
-			if (board[i][j] == -1) {
-				bs[nbs].x = i;
-				bs[nbs].y = j;
-				nbs++;
-				continue;
-			}
-
-			if (board[i][j] == -2) {
-				bk[nbk].x = i;
-				bk[nbk].y = j;
-				nbk++;
-				continue;
-			}
-		}
-	}
-
-	for (j = 3; j <= 9; j += 2) {
-		for (i = 3; i <= 9; i += 2) {
-			if (board[i][j] == 0)
-				continue;
-			if (board[i][j] == 1) {
-				ws[nws].x = i;
-				ws[nws].y = j;
-				nws++;
-				continue;
-			}
-
-			if (board[i][j] == 2) {
-				wk[nwk].x = i;
-				wk[nwk].y = j;
-				nwk++;
-				continue;
-			}
-
-			if (board[i][j] == -1) {
-				bs[nbs].x = i;
-				bs[nbs].y = j;
-				nbs++;
-				continue;
-			}
-
-			if (board[i][j] == -2) {
-				bk[nbk].x = i;
-				bk[nbk].y = j;
-				nbk++;
-				continue;
-			}
-		}
-	}
-
-	if (color == CB_WHITE) {
-
-		/* search for captures with white kings*/
-		if (nwk > 0) {
-			for (i = 0; i < nwk; i++) {
-				x = wk[i].x;
-				y = wk[i].y;
-				if
-				(
-					(board[x + 1][y + 1] < 0 && board[x + 2][y + 2] == 0) ||
-					(board[x - 1][y + 1] < 0 && board[x - 2][y + 2] == 0) ||
-					(board[x + 1][y - 1] < 0 && board[x + 2][y - 2] == 0) ||
-					(board[x - 1][y - 1] < 0 && board[x - 2][y - 2] == 0)
-				) {
-					m.from.x = x;
-					m.from.y = y;
-					m.path[0].x = x;
-					m.path[0].y = y;
-					whitekingcapture(board, movelist, m, x, y, 0);
-				}
-			}
-		}
-
-		/* search for captures with white stones */
-		if (nws > 0) {
-			for (i = 0; i < nws; i++) {
-				x = ws[i].x;
-				y = ws[i].y;
-				if
-				(
-					(board[x + 1][y + 1] < 0 && board[x + 2][y + 2] == 0) ||
-					(board[x - 1][y + 1] < 0 && board[x - 2][y + 2] == 0)
-				) {
-					m.from.x = x;
-					m.from.y = y;
-					m.path[0].x = x;
-					m.path[0].y = y;
-					whitecapture(board, movelist, m, x, y, 0);
-				}
-			}
-		}
-
-		/* if there are capture moves return. */
-		if (n > 0) {
-			*isjump = 1;
-			return(n);
-		}
-
-		/* search for moves with white kings */
-		if (nwk > 0) {
-			for (i = 0; i < nwk; i++) {
-				x = wk[i].x;
-				y = wk[i].y;
-				if (board[x + 1][y + 1] == 0) {
-					movelist[n].jumps = 0;
-					movelist[n].from.x = x;
-					movelist[n].from.y = y;
-					movelist[n].to.x = x + 1;
-					movelist[n].to.y = y + 1;
-					movelist[n].path[0].x = x;
-					movelist[n].path[0].y = y;
-					movelist[n].path[1].x = x + 1;
-					movelist[n].path[1].y = y + 1;
-					movelist[n].del[0].x = -1;
-					movelist[n].newpiece = 2;
-					movelist[n].oldpiece = 2;
-					n++;
-				}
-
-				if (board[x + 1][y - 1] == 0) {
-					movelist[n].jumps = 0;
-					movelist[n].from.x = x;
-					movelist[n].from.y = y;
-					movelist[n].to.x = x + 1;
-					movelist[n].to.y = y - 1;
-					movelist[n].path[0].x = x;
-					movelist[n].path[0].y = y;
-					movelist[n].path[1].x = x + 1;
-					movelist[n].path[1].y = y - 1;
-					movelist[n].del[0].x = -1;
-					movelist[n].newpiece = 2;
-					movelist[n].oldpiece = 2;
-					n++;
-				}
-
-				if (board[x - 1][y + 1] == 0) {
-					movelist[n].jumps = 0;
-					movelist[n].from.x = x;
-					movelist[n].from.y = y;
-					movelist[n].to.x = x - 1;
-					movelist[n].to.y = y + 1;
-					movelist[n].path[0].x = x;
-					movelist[n].path[0].y = y;
-					movelist[n].path[1].x = x - 1;
-					movelist[n].path[1].y = y + 1;
-					movelist[n].del[0].x = -1;
-					movelist[n].newpiece = 2;
-					movelist[n].oldpiece = 2;
-					n++;
-				}
-
-				if (board[x - 1][y - 1] == 0) {
-					movelist[n].jumps = 0;
-					movelist[n].from.x = x;
-					movelist[n].from.y = y;
-					movelist[n].to.x = x - 1;
-					movelist[n].to.y = y - 1;
-					movelist[n].path[0].x = x;
-					movelist[n].path[0].y = y;
-					movelist[n].path[1].x = x - 1;
-					movelist[n].path[1].y = y - 1;
-					movelist[n].del[0].x = -1;
-					movelist[n].newpiece = 2;
-					movelist[n].oldpiece = 2;
-					n++;
-				}
-			}
-		}
-
-		/* search for moves with white stones */
-		if (nws > 0) {
-			for (i = nws - 1; i >= 0; i--) {
-				x = ws[i].x;
-				y = ws[i].y;
-				if (board[x + 1][y + 1] == 0) {
-					movelist[n].jumps = 0;
-					movelist[n].from.x = x;
-					movelist[n].from.y = y;
-					movelist[n].to.x = x + 1;
-					movelist[n].to.y = y + 1;
-					movelist[n].path[0].x = x;
-					movelist[n].path[0].y = y;
-					movelist[n].path[1].x = x + 1;
-					movelist[n].path[1].y = y + 1;
-					movelist[n].del[0].x = -1;
-					if (y == 8) {
-						movelist[n].newpiece = 2;
-					}
-					else
-						movelist[n].newpiece = 1;
-					movelist[n].oldpiece = 1;
-					n++;
-				}
-
-				if (board[x - 1][y + 1] == 0) {
-					movelist[n].jumps = 0;
-					movelist[n].from.x = x;
-					movelist[n].from.y = y;
-					movelist[n].to.x = x - 1;
-					movelist[n].to.y = y + 1;
-					movelist[n].path[0].x = x;
-					movelist[n].path[0].y = y;
-					movelist[n].path[1].x = x - 1;
-					movelist[n].path[1].y = y + 1;
-					movelist[n].del[0].x = -1;
-					if (y == 8) {
-						movelist[n].newpiece = 2;
-					}
-					else
-						movelist[n].newpiece = 1;
-					movelist[n].oldpiece = 1;
-					n++;
-				}
-			}
-		}
-
-		if (n > 0)
-			return(n);
-	}
-	else {
-
-		/* search for captures with black kings*/
-		n = 0;
-		if (nbk > 0) {
-			for (i = 0; i < nbk; i++) {
-				x = bk[i].x;
-				y = bk[i].y;
-				if
-				(
-					((board[x + 1][y + 1] > 0) && (board[x + 1][y + 1] < 3) && (board[x + 2][y + 2] == 0)) ||
-					((board[x - 1][y + 1] > 0) && (board[x - 1][y + 1] < 3) && (board[x - 2][y + 2] == 0)) ||
-					((board[x + 1][y - 1] > 0) && (board[x + 1][y - 1] < 3) && (board[x + 2][y - 2] == 0)) ||
-					((board[x - 1][y - 1] > 0) && (board[x - 1][y - 1] < 3) && (board[x - 2][y - 2] == 0))
-				) {
-					m.from.x = x;
-					m.from.y = y;
-					m.path[0].x = x;
-					m.path[0].y = y;
-					blackkingcapture(board, movelist, m, x, y, 0);
-				}
-			}
-		}
-
-		/* search for captures with black stones */
-		if (nbs > 0) {
-			for (i = nbs - 1; i >= 0; i--) {
-				x = bs[i].x;
-				y = bs[i].y;
-				if
-				(
-					(board[x + 1][y - 1] > 0 && board[x + 2][y - 2] == 0) ||
-					(board[x - 1][y - 1] > 0 && board[x - 2][y - 2] == 0)
-				) {
-					m.from.x = x;
-					m.from.y = y;
-					m.path[0].x = x;
-					m.path[0].y = y;
-					blackcapture(board, movelist, m, x, y, 0);
-				}
-			}
-		}
-
-		/* search for moves with black kings */
-		if (n > 0) {
-			*isjump = 1;
-			return(n);
-		}
-
-		if (nbk > 0) {
-			for (i = 0; i < nbk; i++) {
-				x = bk[i].x;
-				y = bk[i].y;
-				if (board[x + 1][y + 1] == 0) {
-					movelist[n].jumps = 0;
-					movelist[n].from.x = x;
-					movelist[n].from.y = y;
-					movelist[n].to.x = x + 1;
-					movelist[n].to.y = y + 1;
-					movelist[n].path[0].x = x;
-					movelist[n].path[0].y = y;
-					movelist[n].path[1].x = x + 1;
-					movelist[n].path[1].y = y + 1;
-					movelist[n].del[0].x = -1;
-					movelist[n].newpiece = -2;
-					movelist[n].oldpiece = -2;
-					n++;
-				}
-
-				if (board[x + 1][y - 1] == 0) {
-					movelist[n].jumps = 0;
-					movelist[n].from.x = x;
-					movelist[n].from.y = y;
-					movelist[n].to.x = x + 1;
-					movelist[n].to.y = y - 1;
-					movelist[n].path[0].x = x;
-					movelist[n].path[0].y = y;
-					movelist[n].path[1].x = x + 1;
-					movelist[n].path[1].y = y - 1;
-					movelist[n].del[0].x = -1;
-					movelist[n].newpiece = -2;
-					movelist[n].oldpiece = -2;
-					n++;
-				}
-
-				if (board[x - 1][y + 1] == 0) {
-					movelist[n].jumps = 0;
-					movelist[n].from.x = x;
-					movelist[n].from.y = y;
-					movelist[n].to.x = x - 1;
-					movelist[n].to.y = y + 1;
-					movelist[n].path[0].x = x;
-					movelist[n].path[0].y = y;
-					movelist[n].path[1].x = x - 1;
-					movelist[n].path[1].y = y + 1;
-					movelist[n].del[0].x = -1;
-					movelist[n].newpiece = -2;
-					movelist[n].oldpiece = -2;
-					n++;
-				}
-
-				if (board[x - 1][y - 1] == 0) {
-					movelist[n].jumps = 0;
-					movelist[n].from.x = x;
-					movelist[n].from.y = y;
-					movelist[n].to.x = x - 1;
-					movelist[n].to.y = y - 1;
-					movelist[n].path[0].x = x;
-					movelist[n].path[0].y = y;
-					movelist[n].path[1].x = x - 1;
-					movelist[n].path[1].y = y - 1;
-					movelist[n].del[0].x = -1;
-					movelist[n].newpiece = -2;
-					movelist[n].oldpiece = -2;
-					n++;
-				}
-			}
-		}
-
-		/* search for moves with black stones */
-		if (nbs > 0) {
-			for (i = 0; i < nbs; i++) {
-				x = bs[i].x;
-				y = bs[i].y;
-				if (board[x + 1][y - 1] == 0) {
-					movelist[n].jumps = 0;
-					movelist[n].from.x = x;
-					movelist[n].from.y = y;
-					movelist[n].to.x = x + 1;
-					movelist[n].to.y = y - 1;
-					movelist[n].path[0].x = x;
-					movelist[n].path[0].y = y;
-					movelist[n].path[1].x = x + 1;
-					movelist[n].path[1].y = y - 1;
-					movelist[n].del[0].x = -1;
-					if (y == 3) {
-						movelist[n].newpiece = -2;
-					}
-					else
-						movelist[n].newpiece = -1;
-					movelist[n].oldpiece = -1;
-					n++;
-				}
-
-				if (board[x - 1][y - 1] == 0) {
-					movelist[n].jumps = 0;
-					movelist[n].from.x = x;
-					movelist[n].from.y = y;
-					movelist[n].to.x = x - 1;
-					movelist[n].to.y = y - 1;
-					movelist[n].path[0].x = x;
-					movelist[n].path[0].y = y;
-					movelist[n].path[1].x = x - 1;
-					movelist[n].path[1].y = y - 1;
-					movelist[n].del[0].x = -1;
-					if (y == 3) {
-						movelist[n].newpiece = -2;
-					}
-					else
-						movelist[n].newpiece = -1;
-					movelist[n].oldpiece = -1;
-					n++;
-				}
-			}
-		}
-	}
-
-	return(n);
-}
-
-void whitecapture(int board[12][12], CBmove movelist[MAXMOVES], CBmove m, int x, int y, int d)
-{
-	int b[12][12];
-	CBmove mm;
-	int end = 1;
-
-	mm = m;
-	if (y < 8) {
-		if (board[x + 1][y + 1] < 0 && board[x + 2][y + 2] == 0) {
-			memcpy(b, board, 144 * sizeof(int));
-			b[x][y] = 0;
-			b[x + 1][y + 1] = 0;
-			b[x + 2][y + 2] = 1;
-			mm.to.x = x + 2;
-			mm.to.y = y + 2;
-			mm.path[d + 1].x = x + 2;
-			mm.path[d + 1].y = y + 2;
-			mm.del[d].x = x + 1;
-			mm.del[d].y = y + 1;
-			mm.delpiece[d] = board[x + 1][y + 1];
-			mm.del[d + 1].x = -1;
-			if (y == 7)
-				mm.newpiece = 2;
-			else
-				mm.newpiece = 1;
-
-			whitecapture(b, movelist, mm, x + 2, y + 2, d + 1);
-			end = 0;
-		}
-
-		mm = m;
-		if (board[x - 1][y + 1] < 0 && board[x - 2][y + 2] == 0) {
-			memcpy(b, board, 144 * sizeof(int));
-			b[x][y] = 0;
-			b[x - 1][y + 1] = 0;
-			b[x - 2][y + 2] = 1;
-			mm.to.x = x - 2;
-			mm.to.y = y + 2;
-			mm.path[d + 1].x = x - 2;
-			mm.path[d + 1].y = y + 2;
-			mm.del[d].x = x - 1;
-			mm.del[d].y = y + 1;
-			mm.del[d + 1].x = -1;
-			mm.delpiece[d] = board[x - 1][y + 1];
-			if (y == 7)
-				mm.newpiece = 2;
-			else
-				mm.newpiece = 1;
-
-			whitecapture(b, movelist, mm, x - 2, y + 2, d + 1);
-			end = 0;
-		}
-	}
-
-	if (end) {
-		m.jumps = d;
-		movelist[n] = m;
-		movelist[n].oldpiece = 1;
-		n++;
-	}
-}
-
-void whitekingcapture(int board[12][12], CBmove movelist[MAXMOVES], CBmove m, int x, int y, int d)
-{
-	int b[12][12];
-	CBmove mm;
-	int end = 1;
-
-	mm = m;
-	if (board[x + 1][y + 1] < 0 && board[x + 2][y + 2] == 0) {
-		memcpy(b, board, 144 * sizeof(int));
-		b[x][y] = 0;
-		b[x + 1][y + 1] = 0;
-		b[x + 2][y + 2] = 2;
-		mm.to.x = x + 2;
-		mm.to.y = y + 2;
-		mm.path[d + 1].x = x + 2;
-		mm.path[d + 1].y = y + 2;
-		mm.del[d].x = x + 1;
-		mm.del[d].y = y + 1;
-		mm.del[d + 1].x = -1;
-		mm.delpiece[d] = board[x + 1][y + 1];
-		mm.newpiece = 2;
-
-		whitekingcapture(b, movelist, mm, x + 2, y + 2, d + 1);
-		end = 0;
-	}
-
-	mm = m;
-	if (board[x - 1][y + 1] < 0 && board[x - 2][y + 2] == 0) {
-		memcpy(b, board, 144 * sizeof(int));
-		b[x][y] = 0;
-		b[x - 1][y + 1] = 0;
-		b[x - 2][y + 2] = 2;
-		mm.to.x = x - 2;
-		mm.to.y = y + 2;
-		mm.path[d + 1].x = x - 2;
-		mm.path[d + 1].y = y + 2;
-		mm.del[d].x = x - 1;
-		mm.del[d].y = y + 1;
-		mm.delpiece[d] = board[x - 1][y + 1];
-		mm.del[d + 1].x = -1;
-		mm.newpiece = 2;
-
-		whitekingcapture(b, movelist, mm, x - 2, y + 2, d + 1);
-		end = 0;
-	}
-
-	if (board[x + 1][y - 1] < 0 && board[x + 2][y - 2] == 0) {
-		memcpy(b, board, 144 * sizeof(int));
-		b[x][y] = 0;
-		b[x + 1][y - 1] = 0;
-		b[x + 2][y - 2] = 2;
-		mm.to.x = x + 2;
-		mm.to.y = y - 2;
-		mm.path[d + 1].x = x + 2;
-		mm.path[d + 1].y = y - 2;
-		mm.del[d].x = x + 1;
-		mm.del[d].y = y - 1;
-		mm.delpiece[d] = board[x + 1][y - 1];
-		mm.del[d + 1].x = -1;
-		mm.newpiece = 2;
-
-		whitekingcapture(b, movelist, mm, x + 2, y - 2, d + 1);
-		end = 0;
-	}
-
-	mm = m;
-	if (board[x - 1][y - 1] < 0 && board[x - 2][y - 2] == 0) {
-		memcpy(b, board, 144 * sizeof(int));
-		b[x][y] = 0;
-		b[x - 1][y - 1] = 0;
-		b[x - 2][y - 2] = 2;
-		mm.to.x = x - 2;
-		mm.to.y = y - 2;
-		mm.path[d + 1].x = x - 2;
-		mm.path[d + 1].y = y - 2;
-		mm.del[d].x = x - 1;
-		mm.del[d].y = y - 1;
-		mm.delpiece[d] = board[x - 1][y - 1];
-		mm.del[d + 1].x = -1;
-		mm.newpiece = 2;
-
-		whitekingcapture(b, movelist, mm, x - 2, y - 2, d + 1);
-		end = 0;
-	}
-
-	if (end) {
-		m.jumps = d;
-		movelist[n] = m;
-		movelist[n].oldpiece = 2;
-		n++;
-	}
-}
-
-void blackcapture(int board[12][12], CBmove movelist[MAXMOVES], CBmove m, int x, int y, int d)
-{
-	int b[12][12];
-	CBmove mm;
-	int end = 1;
-
-	mm = m;
-	if (y > 3) {
-		if (board[x + 1][y - 1] > 0 && board[x + 2][y - 2] == 0) {
-			memcpy(b, board, 144 * sizeof(int));
-			b[x][y] = 0;
-			b[x + 1][y - 1] = 0;
-			b[x + 2][y - 2] = -1;
-			mm.to.x = x + 2;
-			mm.to.y = y - 2;
-			mm.path[d + 1].x = x + 2;
-			mm.path[d + 1].y = y - 2;
-			mm.del[d].x = x + 1;
-			mm.del[d].y = y - 1;
-			mm.delpiece[d] = board[x + 1][y - 1];
-			mm.del[d + 1].x = -1;
-			if (y == 4)
-				mm.newpiece = -2;
-			else
-				mm.newpiece = -1;
-
-			blackcapture(b, movelist, mm, x + 2, y - 2, d + 1);
-			end = 0;
-		}
-
-		mm = m;
-		if (board[x - 1][y - 1] > 0 && board[x - 2][y - 2] == 0) {
-			memcpy(b, board, 144 * sizeof(int));
-			b[x][y] = 0;
-			b[x - 1][y - 1] = 0;
-			b[x - 2][y - 2] = -1;
-			mm.to.x = x - 2;
-			mm.to.y = y - 2;
-			mm.path[d + 1].x = x - 2;
-			mm.path[d + 1].y = y - 2;
-			mm.del[d].x = x - 1;
-			mm.del[d].y = y - 1;
-			mm.delpiece[d] = board[x - 1][y - 1];
-			mm.del[d + 1].x = -1;
-			if (y == 4)
-				mm.newpiece = -2;
-			else
-				mm.newpiece = -1;
-
-			blackcapture(b, movelist, mm, x - 2, y - 2, d + 1);
-			end = 0;
-		}
-	}
-
-	if (end) {
-		m.jumps = d;
-		movelist[n] = m;
-		movelist[n].oldpiece = -1;
-		n++;
-	}
-}
-
-void blackkingcapture(int board[12][12], CBmove movelist[MAXMOVES], CBmove m, int x, int y, int d)
-{
-	int b[12][12];
-	CBmove mm;
-	int end = 1;
-
-	mm = m;
-	if (board[x + 1][y + 1] > 0 && board[x + 2][y + 2] == 0) {
-		memcpy(b, board, 144 * sizeof(int));
-		b[x][y] = 0;
-		b[x + 1][y + 1] = 0;
-		b[x + 2][y + 2] = 2;
-		mm.to.x = x + 2;
-		mm.to.y = y + 2;
-		mm.path[d + 1].x = x + 2;
-		mm.path[d + 1].y = y + 2;
-		mm.del[d].x = x + 1;
-		mm.del[d].y = y + 1;
-		mm.delpiece[d] = board[x + 1][y + 1];
-		mm.del[d + 1].x = -1;
-		mm.newpiece = -2;
-
-		blackkingcapture(b, movelist, mm, x + 2, y + 2, d + 1);
-		end = 0;
-	}
-
-	mm = m;
-	if (board[x - 1][y + 1] > 0 && board[x - 2][y + 2] == 0) {
-		memcpy(b, board, 144 * sizeof(int));
-		b[x][y] = 0;
-		b[x - 1][y + 1] = 0;
-		b[x - 2][y + 2] = 2;
-		mm.to.x = x - 2;
-		mm.to.y = y + 2;
-		mm.path[d + 1].x = x - 2;
-		mm.path[d + 1].y = y + 2;
-		mm.del[d].x = x - 1;
-		mm.del[d].y = y + 1;
-		mm.delpiece[d] = board[x - 1][y + 1];
-		mm.del[d + 1].x = -1;
-		mm.newpiece = -2;
-
-		blackkingcapture(b, movelist, mm, x - 2, y + 2, d + 1);
-		end = 0;
-	}
-
-	if (board[x + 1][y - 1] > 0 && board[x + 2][y - 2] == 0) {
-		memcpy(b, board, 144 * sizeof(int));
-		b[x][y] = 0;
-		b[x + 1][y - 1] = 0;
-		b[x + 2][y - 2] = 2;
-		mm.to.x = x + 2;
-		mm.to.y = y - 2;
-		mm.path[d + 1].x = x + 2;
-		mm.path[d + 1].y = y - 2;
-		mm.del[d].x = x + 1;
-		mm.del[d].y = y - 1;
-		mm.delpiece[d] = board[x + 1][y - 1];
-		mm.del[d + 1].x = -1;
-		mm.newpiece = -2;
-
-		blackkingcapture(b, movelist, mm, x + 2, y - 2, d + 1);
-		end = 0;
-	}
-
-	mm = m;
-	if (board[x - 1][y - 1] > 0 && board[x - 2][y - 2] == 0) {
-		memcpy(b, board, 144 * sizeof(int));
-		b[x][y] = 0;
-		b[x - 1][y - 1] = 0;
-		b[x - 2][y - 2] = 2;
-		mm.to.x = x - 2;
-		mm.to.y = y - 2;
-		mm.path[d + 1].x = x - 2;
-		mm.path[d + 1].y = y - 2;
-		mm.del[d].x = x - 1;
-		mm.del[d].y = y - 1;
-		mm.delpiece[d] = board[x - 1][y - 1];
-		mm.del[d + 1].x = -1;
-		mm.newpiece = -2;
-
-		blackkingcapture(b, movelist, mm, x - 2, y - 2, d + 1);
-		end = 0;
-	}
-
-	if (end) {
-		m.jumps = d;
-		movelist[n] = m;
-		movelist[n].oldpiece = -2;
-		n++;
-	}
-}
+// cb_movegen.c: generates a list of legal moves
+// 	getmovelist()
+//	is the only function which cb_movegen.c exports. it takes a Board8x8 as
+//  board, color to move, and returns a list of CBmoves.
+//  the moves are generated on the bitboard representation of bitboard.c and
+//  are written to the CBmoves in 8x8 coordinates right away. all state lives
+//  on the stack, so getmovelist() may be called from several threads at once.
+
+#include "CB_movegen.h"
+#include "bitboard.h"
+#include "CBconsts.h"
+#include "checkers_types.h"
+#include <assert.h> // For assert
+#include <stdint.h>
+
+/* exported functions */
+int getmovelist(int color, CBmove movelist[MAXMOVES], Board8x8 board, int *isjump);
+
+/* directions on the bitboard, see the board diagram in bitboard.c. NE and NW
+   go towards CB_WHITE's side of the board, SE and SW towards CB_BLACK's. */
+enum { NE, NW, SE, SW };
+
+/* squares on which the men of either side become kings */
+#define BLACKKINGROW 0xF0000000u
+#define WHITEKINGROW 0x0000000Fu
+
+/* state of the capture search, one per getmovelist() call */
+typedef struct capturestate {
+	CBmove *movelist;
+	int n;
+	uint32_t opponent;		/* opponent pieces which have not been jumped yet */
+	uint32_t opponentkings;
+	uint32_t empty;
+	int opponentcolor;
+	int firstdir, lastdir;	/* directions the capturing piece may jump in */
+	uint32_t kingrow;		/* promotion squares of the capturing piece, 0 for a king */
+	int piece;				/* the capturing piece in CB format */
+} capturestate;
+
+/* internal functions */
+static void piecedirections(int piece, int *firstdir, int *lastdir);
+static void generatecaptures(capturestate *s, uint32_t pieces, int piece);
+static void capture(capturestate *s, CBmove *m, uint32_t from, int d);
+static void addcapture(capturestate *s, const CBmove *m, int jumps, int newpiece);
+static int generatemoves(CBmove movelist[MAXMOVES], int n, uint32_t pieces, int piece, uint32_t empty);
+
+static inline int lsb(uint32_t x)
+{
+	// index of the lowest bit set in x, x must not be 0
+#if defined(__GNUC__) || defined(__clang__)
+	return(__builtin_ctz(x));
+#else
+	int i = 0;
+
+	while (!(x & 1)) {
+		x >>= 1;
+		i++;
+	}
+	return(i);
+#endif
+}
+
+static inline uint32_t neighbor(uint32_t squares, int dir)
+{
+	// moves every square in squares one step in direction dir. squares which
+	// would leave the board are dropped.
+	switch (dir) {
+	case NE:
+		return(((squares & 0x0F0F0F0Fu) << 4) | ((squares & 0x70707070u) << 5));
+
+	case NW:
+		return(((squares & 0x0E0E0E0Eu) << 3) | ((squares & 0xF0F0F0F0u) << 4));
+
+	case SE:
+		return(((squares & 0x0F0F0F0Fu) >> 4) | ((squares & 0x70707070u) >> 3));
+
+	default:
+		return(((squares & 0x0E0E0E0Eu) >> 5) | ((squares & 0xF0F0F0F0u) >> 4));
+	}
+}
+
+static inline void squaretocoor(uint32_t square, coor *c)
+{
+	// 8x8 coordinates of the single square bit in square
+	int i = lsb(square);
+
+	c->x = 2 * (i & 3) + ((i >> 2) & 1);
+	c->y = i >> 2;
+}
+
+int getmovelist(int color, CBmove movelist[MAXMOVES], Board8x8 b, int *isjump)
+{
+	pos p;
+	capturestate s;
+	uint32_t men, kings, kingrow;
+	int n;
+
+	assert(color == CB_BLACK || color == CB_WHITE);
+	boardtobitboard(b, &p);
+	if (color == CB_BLACK) {
+		men = p.bm;
+		kings = p.bk;
+		kingrow = BLACKKINGROW;
+		s.opponent = p.wm | p.wk;
+		s.opponentkings = p.wk;
+		s.opponentcolor = CB_WHITE;
+	}
+	else {
+		men = p.wm;
+		kings = p.wk;
+		kingrow = WHITEKINGROW;
+		s.opponent = p.bm | p.bk;
+		s.opponentkings = p.bk;
+		s.opponentcolor = CB_BLACK;
+	}
+
+	s.movelist = movelist;
+	s.n = 0;
+	s.empty = ~(p.bm | p.bk | p.wm | p.wk);
+
+	// captures are compulsory: only if there are none, look for normal moves
+	s.kingrow = 0;
+	generatecaptures(&s, kings, color | CB_KING);
+	s.kingrow = kingrow;
+	generatecaptures(&s, men, color | CB_MAN);
+	if (s.n > 0) {
+		*isjump = 1;
+		return(s.n);
+	}
+
+	*isjump = 0;
+	n = generatemoves(movelist, 0, kings, color | CB_KING, s.empty);
+	n = generatemoves(movelist, n, men, color | CB_MAN, s.empty);
+	return(n);
+}
+
+void piecedirections(int piece, int *firstdir, int *lastdir)
+{
+	// kings move in all four directions, men only forward
+	if (piece & CB_KING) {
+		*firstdir = NE;
+		*lastdir = SW;
+	}
+	else if (piece & CB_BLACK) {
+		*firstdir = NE;
+		*lastdir = NW;
+	}
+	else {
+		*firstdir = SE;
+		*lastdir = SW;
+	}
+}
+
+void generatecaptures(capturestate *s, uint32_t pieces, int piece)
+{
+	// adds all captures of the pieces in pieces to s->movelist
+	CBmove m;
+	uint32_t from;
+
+	piecedirections(piece, &s->firstdir, &s->lastdir);
+	s->piece = piece;
+	m.oldpiece = piece;
+	while (pieces) {
+		from = pieces & (0 - pieces);
+		pieces ^= from;
+		squaretocoor(from, &m.from);
+		m.path[0] = m.from;
+		capture(s, &m, from, 0);
+	}
+}
+
+void capture(capturestate *s, CBmove *m, uint32_t from, int d)
+{
+	// continues the capture in m, which has made d jumps so far and stands on
+	// from. jumped pieces are taken off the board at once, so that they can
+	// not be jumped twice and their squares may be crossed again.
+	uint32_t over, to, changed;
+	int dir, end = 1;
+
+	for (dir = s->firstdir; dir <= s->lastdir; dir++) {
+		over = neighbor(from, dir) & s->opponent;
+		if (!over)
+			continue;
+		to = neighbor(over, dir) & s->empty;
+		if (!to)
+			continue;
+
+		end = 0;
+		squaretocoor(over, &m->del[d]);
+		m->delpiece[d] = s->opponentcolor | ((over & s->opponentkings) ? CB_KING : CB_MAN);
+		squaretocoor(to, &m->path[d + 1]);
+
+		changed = from | over | to;
+		s->opponent ^= over;
+		s->empty ^= changed;
+
+		// a man which reaches the last row is crowned and its move ends
+		if (to & s->kingrow)
+			addcapture(s, m, d + 1, (s->piece & ~CB_MAN) | CB_KING);
+		else
+			capture(s, m, to, d + 1);
+
+		s->opponent ^= over;
+		s->empty ^= changed;
+	}
+
+	if (end && d > 0)
+		addcapture(s, m, d, s->piece);
+}
+
+void addcapture(capturestate *s, const CBmove *m, int jumps, int newpiece)
+{
+	CBmove *move = &s->movelist[s->n++];
+
+	*move = *m;
+	move->to = m->path[jumps];
+	move->jumps = jumps;
+	move->newpiece = newpiece;
+	if (jumps < 12)
+		move->del[jumps].x = -1;
+}
+
+int generatemoves(CBmove movelist[MAXMOVES], int n, uint32_t pieces, int piece, uint32_t empty)
+{
+	// appends the non-capture moves of the pieces in pieces to movelist,
+	// which holds n moves already. returns the new number of moves.
+	uint32_t from, to, kingrow;
+	int dir, firstdir, lastdir;
+	CBmove *m;
+
+	piecedirections(piece, &firstdir, &lastdir);
+	if (piece & CB_KING)
+		kingrow = 0;
+	else if (piece & CB_BLACK)
+		kingrow = BLACKKINGROW;
+	else
+		kingrow = WHITEKINGROW;
+
+	while (pieces) {
+		from = pieces & (0 - pieces);
+		pieces ^= from;
+		for (dir = firstdir; dir <= lastdir; dir++) {
+			to = neighbor(from, dir) & empty;
+			if (!to)
+				continue;
+
+			m = &movelist[n++];
+			m->jumps = 0;
+			squaretocoor(from, &m->from);
+			squaretocoor(to, &m->to);
+			m->path[0] = m->from;
+			m->path[1] = m->to;
+			m->del[0].x = -1;
+			m->oldpiece = piece;
+			if (to & kingrow)
+				m->newpiece = (piece & ~CB_MAN) | CB_KING;
+			else
+				m->newpiece = piece;
+		}
+	}
+
+	return(n);
+}
@@ -23,3 +23,13 @@
 #define CB_WIN 1
 #define CB_LOSS 2
 #define CB_UNKNOWN 3
+
+#define CB_CHANGECOLOR(color) ((color) ^ (CB_WHITE | CB_BLACK))
+
+// game types, as the PDN GameType header has them
+#define GT_ENGLISH 21
+#define GT_ITALIAN 22
+#define GT_SPANISH 24
+#define GT_RUSSIAN 25
+#define GT_BRAZILIAN 26
+#define GT_CZECH 29
@@ -3,6 +3,8 @@
 #include <QDebug>
 #include <QFileDialog>
 #include <QMessageBox>
+#include "bitboard.h"
+#include "pdnfind.h"
 
 MainWindow::MainWindow(QWidget *parent) : QMainWindow(parent)
 {
@@ -612,15 +614,67 @@ void MainWindow::gameDatabase()
 void MainWindow::gameFind()
 {
     qDebug() << "Find action triggered";
-    QMessageBox::information(this, tr("Find"), tr("Find functionality will be implemented here."));
-    // TODO: Implement actual find logic here
+    findPosition(false);
 }
 
 void MainWindow::gameFindCR()
 {
     qDebug() << "Find CR action triggered";
-    QMessageBox::information(this, tr("Find CR"), tr("Find CR functionality will be implemented here."));
-    // TODO: Implement actual find CR logic here
+    findPosition(true);
+}
+
+// Finds the games of the game database which contain the current position, or
+// with colorsReversed the position with black and white swapped. The database
+// is indexed by pdnopen() the first time, after that a search is a lookup in
+// its hash table.
+void MainWindow::findPosition(bool colorsReversed)
+{
+    QString title = colorsReversed ? tr("Find CR") : tr("Find");
+    std::vector<int> games;
+    RESULT_COUNTS counts;
+    pos position;
+    int color, ngames;
+
+    if (m_databaseName.isEmpty()) {
+        m_databaseName = QFileDialog::getOpenFileName(this, tr("Select Game Database"), "", tr("PDN Files (*.pdn);;All Files (*)"));
+        if (m_databaseName.isEmpty()) {
+            qDebug() << title << "cancelled";
+            return;
+        }
+    }
+
+    if (m_databaseName != m_openDatabase) {
+        QByteArray filename = m_databaseName.toUtf8();
+        if (filename.size() >= MAX_PATH || !pdnopen(filename.data(), gametype())) {
+            QMessageBox::warning(this, title, tr("Could not read the game database %1").arg(m_databaseName));
+            m_databaseName.clear();
+            m_openDatabase.clear();
+            return;
+        }
+        m_openDatabase = m_databaseName;
+    }
+
+    if (colorsReversed) {
+        boardtocrbitboard(cbboard8, &position);
+        color = CB_CHANGECOLOR(cbcolor);
+    } else {
+        boardtobitboard(cbboard8, &position);
+        color = cbcolor;
+    }
+
+    ngames = pdnfind(&position, color, games, counts);
+    if (ngames == 0) {
+        QMessageBox::information(this, title, tr("The position does not occur in %1").arg(m_databaseName));
+        return;
+    }
+
+    QMessageBox::information(this, title,
+                             tr("%1 games found: %2 black wins, %3 white wins, %4 draws, %5 unknown")
+                                 .arg(ngames)
+                                 .arg(counts.black_wins)
+                                 .arg(counts.white_wins)
+                                 .arg(counts.draws)
+                                 .arg(counts.unknowns));
 }
 
 void MainWindow::gameFindTheme()
@@ -4,6 +4,7 @@
 #include <QMenuBar>
 #include <QMenu>
 #include <QAction>
+#include <QString>
 
 #include "CheckerBoardWidget.h"
 #include "CheckerBoard.h" // Include for newgame() function
@@ -132,9 +133,14 @@ private slots:
 
 private:
     void createMenus();
+    void findPosition(bool colorsReversed);
 
     CheckerBoardWidget *checkerBoardWidget;
 
+    // Game database searched by Find and Find CR, and the one pdnopen() indexed
+    QString m_databaseName;
+    QString m_openDatabase;
+
     // Menus
     QMenu *gameMenu;
     QMenu *movesMenu;
@@ -1,62 +1,759 @@
-// ... existing code ...
-#include <vector>
-#include "standardheader.h"
-#include "cb_interface.h"
-// ... existing code ...
-#include "pdnfind.h"
-#include "PDNparser.h"
-#include "bitboard.h"
-
-// --- Qt Includes ---
-#include <QDebug>
-#include <QString>
-// --- End Qt Includes ---
-
-std::vector<PDN_position> pdn_positions;
-
-// ... existing code ...
-
-int pdnopen(char filename[256], int gametype)
-{
-	// parses a pdn file and makes it ready to be used by PDNfind
-// ... existing code ...
-	Board8x8 board8;
-	READ_TEXT_FILE_ERROR_TYPE etype;
-	PDN_position position;
-
-// ... existing code ...
-		return(0);
-	}
-
-	// Use the Qt version to read the file
-	buffer = read_text_file_qt(QString::fromUtf8(filename), etype); // Pass QString
-	if (!buffer) {
-		// Use qDebug for errors in Qt context
-		if (etype == RTF_FILE_ERROR)
-// ... existing code ...
-		if (etype == RTF_MALLOC_ERROR)
-			qDebug() << "malloc error for file:" << filename; // Use qDebug
-		return(0);
-	}
-
-// ... existing code ...
-			pdn_positions.push_back(position);
-		}
-		catch(...) {
-			qDebug() << "Failed to allocate memory for pdn_positions vector"; // Use qDebug
-			free(buffer);
-			return(0);
-		}
-
-// ... existing code ...
-			pdn_positions.push_back(position);
-			}
-			catch(...) {
-				qDebug() << "Failed to allocate memory for pdn_positions vector (in loop)"; // Use qDebug
-				free(buffer);
-				return(0);
-			}
-
-// ... existing code ...
-}
-
+// ... existing code ...
+#include <vector>
+#include "standardheader.h"
+#include "cb_interface.h"
+// ... existing code ...
+#include "pdnfind.h"
+#include "PDNparser.h"
+#include "bitboard.h"
+#include "CheckerBoard.h"
+#include "utility.h"
+#include <stdio.h>
+#include <string.h>
+#include <algorithm>
+#include <atomic>
+#include <new>
+#include <string_view>
+#include <thread>
+#include <utility>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define PDNFIND_X86 // SSE2 is always there, AVX2 is checked at run time
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+// --- Qt Includes ---
+#include <QDateTime>
+#include <QDebug>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QString>
+// --- End Qt Includes ---
+
+#define PDNCHUNKGAMES 1024	// games per chunk of work when pdnopen indexes a database
+
+/* the position index of a database is kept next to it, e.g. in games.pdn.idx,
+   so that it is only built again when the database changes. the index file
+   is a PDN_index_header followed by the position columns, the slots of the
+   hash table, the postings and one result per game. */
+#define PDNINDEXMAGIC 0x78646950	// "Pidx"
+#define PDNINDEXVERSION 3
+
+struct PDN_index_header {
+	uint32_t magic;
+	uint32_t version;
+	int32_t gametype;
+	uint32_t reserved;			// 0
+	uint64_t pdnsize;			// size and modification time (ms since 1970) of the database
+	int64_t pdnmtime;
+	uint64_t npositions;
+	uint64_t nslots;
+	uint64_t npostings;
+	uint64_t ngames;
+};
+
+/* pdnfind looks positions up in an open addressing hash table on
+   positionkey(). a slot holds the key of one distinct position and the
+   games it occurs in: count game indexes from pdn_postings[first] on,
+   in ascending order. a key of 0 marks an empty slot. */
+struct PDN_slot {
+	uint64_t key;
+	uint32_t first;
+	uint32_t count;
+};
+
+std::vector<PDN_position> pdn_positions;	// the index while pdnopen builds it
+static std::vector<uint32_t> pdn_columnlist;
+static std::vector<PDN_slot> pdn_slotlist;
+static std::vector<uint32_t> pdn_postinglist;
+static std::vector<uint8_t> pdn_resultlist;
+static MappedTextFile pdn_indexfile;		// the index file, once it is mapped
+
+// the positions of the open database, in pdn_indexfile or in pdn_columnlist.
+// pdnfindtheme scans them, so they are kept as one column per field: the
+// black, white and kings masks and the game of position i.
+static const uint32_t *pdn_black;
+static const uint32_t *pdn_white;
+static const uint32_t *pdn_kings;
+static const uint32_t *pdn_games;
+static size_t pdn_npositions;
+
+// its hash table, in pdn_indexfile or in the lists above
+static const PDN_slot *pdn_slots;
+static size_t pdn_nslots;
+static const uint32_t *pdn_postings;
+static const uint8_t *pdn_results;			// PDN_RESULT of every game
+static size_t pdn_ngames;
+
+// ... existing code ...
+
+static void addposition(Board8x8 board8, int color, int gameindex, PDN_RESULT result, std::vector<PDN_position> &positions)
+{
+	pos p;
+	PDN_position position;
+
+	boardtobitboard(board8, &p);
+	position.black = p.bm | p.bk;
+	position.white = p.wm | p.wk;
+	position.kings = p.bk | p.wk;
+	position.gameindex = gameindex;
+	position.result = result;
+	position.color = color;
+	positions.push_back(position);
+}
+
+static int pdnindexgame(std::string_view game, int gameindex, int gametype, std::vector<PDN_position> &positions)
+{
+	// replays one game of the database and appends all its positions to
+	// positions. the game is parsed in place, only the values of the Result
+	// and FEN headers are copied to pass them on. returns the number of
+	// positions, or 0 if the game has an invalid FEN.
+	std::string_view rest, header, name, tag, token;
+	char value[MAXNAME];
+	Board8x8 board8;
+	Squarelist squares;
+	CBmove move;
+	PDN_RESULT result;
+	int color, n;
+
+	InitCheckerBoard(board8);
+	color = get_startcolor(gametype);
+	result = PDN_RESULT_UNKNOWN;
+
+	rest = game;
+	while (PDNparseGetnextheader(rest, header)) {
+		name = header.substr(0, header.find_first_of(" \t"));
+		if (!PDNparseGetnexttag(header, tag))
+			continue;
+
+		snprintf(value, sizeof(value), "%.*s", (int)tag.size(), tag.data());
+		if (name == "Result")
+			result = string_to_pdn_result(value, gametype);
+		else if (name == "FEN") {
+			if (!FENtoboard8(board8, value, &color, gametype))
+				return(0);
+		}
+	}
+
+	addposition(board8, color, gameindex, result, positions);
+	n = 1;
+	while (PDNparseGetnextPDNtoken(rest, token)) {
+
+		// skip move numbers, comments and the result
+		if (PDNparseMove(token, squares) == 0)
+			continue;
+
+		// the game ends at the first illegal move
+		if (!islegal_check(board8, color, squares, &move, gametype))
+			break;
+
+		domove(move, board8);
+		color = CB_CHANGECOLOR(color);
+		addposition(board8, color, gameindex, result, positions);
+		n++;
+	}
+
+	return(n);
+}
+
+static int pdnbuildindex(char filename[256], int gametype)
+{
+	// parses a pdn file and builds its positions in pdn_positions.
+	// the file is memory mapped and read in place: games, headers and
+	// moves are views into the mapping, nothing is copied.
+	// finding the games is a quick scan, replaying them is what takes the
+	// time. the games are therefore cut into chunks of PDNCHUNKGAMES which
+	// are replayed by all cores, each chunk into its own buffer. the buffers
+	// are joined in game order, so the index is the same as a serial one.
+	MappedTextFile file;
+	std::string_view rest, game;
+	std::vector<std::string_view> games;
+	std::vector<std::vector<PDN_position>> chunks;
+	std::vector<std::thread> workers;
+	std::atomic<size_t> next(0);
+	std::atomic<bool> failed(false);
+	READ_TEXT_FILE_ERROR_TYPE etype;
+	size_t k, npositions;
+	int i, threads;
+
+	if (!file.open(QString::fromUtf8(filename), etype)) {
+		// Use qDebug for errors in Qt context
+		if (etype == RTF_FILE_ERROR)
+			qDebug() << "could not open file:" << filename;
+		if (etype == RTF_MALLOC_ERROR)
+			qDebug() << "could not map file:" << filename;
+		return(0);
+	}
+
+	try {
+		rest = file.text();
+		while (PDNparseGetnextgame(rest, game))
+			games.push_back(game);
+		chunks.resize((games.size() + PDNCHUNKGAMES - 1) / PDNCHUNKGAMES);
+	}
+	catch(...) {
+		qDebug() << "Failed to allocate memory for the games of" << filename; // Use qDebug
+		return(0);
+	}
+
+	auto work = [&]() {
+		size_t k, g, last;
+
+		while (!failed && (k = next++) < chunks.size()) {
+			last = std::min(games.size(), (k + 1) * PDNCHUNKGAMES);
+			try {
+				for (g = k * PDNCHUNKGAMES; g < last; g++)
+					pdnindexgame(games[g], (int)g, gametype, chunks[k]);
+			}
+			catch(...) {
+				failed = true;
+			}
+		}
+	};
+
+	threads = (int)std::thread::hardware_concurrency();
+	for (i = 1; i < threads && i < (int)chunks.size(); i++) {
+		try {
+			workers.emplace_back(work);
+		}
+		catch(...) {
+			// could not create another thread, index with fewer
+			break;
+		}
+	}
+	work();
+	for (i = 0; i < (int)workers.size(); i++)
+		workers[i].join();
+
+	try {
+		if (failed)
+			throw std::bad_alloc();
+
+		npositions = 0;
+		for (k = 0; k < chunks.size(); k++)
+			npositions += chunks[k].size();
+		pdn_positions.reserve(npositions);
+
+		// release every chunk as soon as it is copied
+		for (k = 0; k < chunks.size(); k++) {
+			pdn_positions.insert(pdn_positions.end(), chunks[k].begin(), chunks[k].end());
+			std::vector<PDN_position>().swap(chunks[k]);
+		}
+	}
+	catch(...) {
+		qDebug() << "Failed to allocate memory for pdn_positions vector"; // Use qDebug
+		pdn_positions.clear();
+		return(0);
+	}
+
+	return(1);
+}
+
+static inline uint64_t mix64(uint64_t z)
+{
+	z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+	z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+	return(z ^ (z >> 31));
+}
+
+static inline uint64_t positionkey(uint32_t black, uint32_t white, uint32_t kings, int color)
+{
+	// 64 bit key of a position with color to move, never 0
+	uint64_t key;
+
+	key = mix64((((uint64_t)black << 32) | white) ^ mix64((((uint64_t)kings << 2) | color) + 0x9e3779b97f4a7c15ull));
+	return(key ? key : 1);
+}
+
+static void pdnbuildhash(void)
+{
+	// builds the hash table of pdn_positions and notes the result of every
+	// game. throws std::bad_alloc if there is not enough memory.
+	std::vector<std::pair<uint64_t, uint32_t>> keys;
+	size_t i, j, nslots, distinct, slot, ngames;
+
+	ngames = 0;
+	keys.reserve(pdn_positions.size());
+	for (i = 0; i < pdn_positions.size(); i++) {
+		const PDN_position &p = pdn_positions[i];
+
+		keys.emplace_back(positionkey(p.black, p.white, p.kings, p.color), p.gameindex);
+		ngames = std::max(ngames, (size_t)p.gameindex + 1);
+	}
+
+	pdn_resultlist.assign(ngames, PDN_RESULT_UNKNOWN);
+	for (i = 0; i < pdn_positions.size(); i++)
+		pdn_resultlist[pdn_positions[i].gameindex] = pdn_positions[i].result;
+
+	// a position which occurs twice in one game lists the game once
+	std::sort(keys.begin(), keys.end());
+	keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+
+	// at most 3/4 of the slots are used, so a probe soon finds an empty one
+	distinct = 0;
+	for (i = 0; i < keys.size(); i++)
+		if (i == 0 || keys[i].first != keys[i - 1].first)
+			distinct++;
+	for (nslots = 16; nslots < distinct + distinct / 3; nslots *= 2)
+		;
+
+	pdn_slotlist.assign(nslots, PDN_slot());
+	pdn_postinglist.resize(keys.size());
+	for (i = 0; i < keys.size(); i = j) {
+		for (slot = keys[i].first & (nslots - 1); pdn_slotlist[slot].key != 0; slot = (slot + 1) & (nslots - 1))
+			;
+		pdn_slotlist[slot].key = keys[i].first;
+		pdn_slotlist[slot].first = (uint32_t)i;
+		for (j = i; j < keys.size() && keys[j].first == keys[i].first; j++)
+			pdn_postinglist[j] = keys[j].second;
+		pdn_slotlist[slot].count = (uint32_t)(j - i);
+	}
+}
+
+static void pdnbuildcolumns(void)
+{
+	// copies pdn_positions to the columns in pdn_columnlist
+	size_t i, n = pdn_positions.size();
+
+	pdn_columnlist.resize(4 * n);
+	for (i = 0; i < n; i++) {
+		pdn_columnlist[i] = pdn_positions[i].black;
+		pdn_columnlist[n + i] = pdn_positions[i].white;
+		pdn_columnlist[2 * n + i] = pdn_positions[i].kings;
+		pdn_columnlist[3 * n + i] = pdn_positions[i].gameindex;
+	}
+}
+
+static void pdnsetcolumns(const uint32_t *columns, size_t npositions)
+{
+	pdn_black = columns;
+	pdn_white = columns + npositions;
+	pdn_kings = columns + 2 * npositions;
+	pdn_games = columns + 3 * npositions;
+	pdn_npositions = npositions;
+}
+
+static bool pdnindexsize(const PDN_index_header &header, size_t size)
+{
+	// true if size is the size of the index file which header describes.
+	// the counts come from the file, each is checked against what is left
+	// before it is multiplied, so that a damaged header can not overflow.
+	uint64_t rest;
+
+	if (size < sizeof(header))
+		return(false);
+	rest = size - sizeof(header);
+	if (header.npositions > rest / (4 * sizeof(uint32_t)))
+		return(false);
+	rest -= header.npositions * 4 * sizeof(uint32_t);
+	if (header.nslots > rest / sizeof(PDN_slot))
+		return(false);
+	rest -= header.nslots * sizeof(PDN_slot);
+	if (header.npostings > rest / sizeof(uint32_t))
+		return(false);
+	rest -= header.npostings * sizeof(uint32_t);
+	return(header.ngames == rest);
+}
+
+static bool pdnvalidindex(const PDN_index_header &header, const uint32_t *columns, const PDN_slot *slots,
+		const uint32_t *postings)
+{
+	// pdnfind and pdnfindtheme use the game indexes and the slots without
+	// looking at them again: every game index must be less than ngames,
+	// every slot must point into the postings, and the hash table needs an
+	// empty slot to end a search for a key which is not in it.
+	const uint32_t *games = columns + 3 * header.npositions;
+	uint64_t i;
+	bool empty = false;
+
+	for (i = 0; i < header.npositions; i++) {
+		if (games[i] >= header.ngames)
+			return(false);
+	}
+	for (i = 0; i < header.nslots; i++) {
+		if (slots[i].key == 0)
+			empty = true;
+		else if ((uint64_t)slots[i].first + slots[i].count > header.npostings)
+			return(false);
+	}
+	for (i = 0; i < header.npostings; i++) {
+		if (postings[i] >= header.ngames)
+			return(false);
+	}
+	return(empty);
+}
+
+static bool pdnmapindex(const QString &indexname, const PDN_index_header &expected)
+{
+	// maps the index file if it is the index of the database described by
+	// expected. the position columns and the hash table are used right
+	// from the mapping, so they are checked once here.
+	PDN_index_header header;
+	std::string_view data;
+	READ_TEXT_FILE_ERROR_TYPE etype;
+	const char *p;
+	const uint32_t *columns, *postings;
+	const PDN_slot *slots;
+
+	if (!QFileInfo::exists(indexname) || !pdn_indexfile.open(indexname, etype))
+		return(false);
+
+	data = pdn_indexfile.text();
+	if (data.size() < sizeof(header)) {
+		pdn_indexfile.close();
+		return(false);
+	}
+
+	memcpy(&header, data.data(), sizeof(header));
+	if (header.magic != expected.magic || header.version != expected.version ||
+			header.gametype != expected.gametype ||
+			header.pdnsize != expected.pdnsize || header.pdnmtime != expected.pdnmtime ||
+			header.nslots == 0 || (header.nslots & (header.nslots - 1)) != 0 ||
+			!pdnindexsize(header, data.size())) {
+		pdn_indexfile.close();
+		return(false);
+	}
+
+	p = data.data() + sizeof(header);
+	columns = reinterpret_cast<const uint32_t *>(p);
+	p += header.npositions * 4 * sizeof(uint32_t);
+	slots = reinterpret_cast<const PDN_slot *>(p);
+	p += header.nslots * sizeof(PDN_slot);
+	postings = reinterpret_cast<const uint32_t *>(p);
+	p += header.npostings * sizeof(uint32_t);
+	if (!pdnvalidindex(header, columns, slots, postings)) {
+		qDebug() << "damaged index file:" << indexname;
+		pdn_indexfile.close();
+		return(false);
+	}
+
+	pdnsetcolumns(columns, (size_t)header.npositions);
+	pdn_slots = slots;
+	pdn_nslots = (size_t)header.nslots;
+	pdn_postings = postings;
+	pdn_results = reinterpret_cast<const uint8_t *>(p);
+	pdn_ngames = (size_t)header.ngames;
+	return(true);
+}
+
+static bool pdnwrite(QSaveFile &file, const void *data, size_t size)
+{
+	return(file.write(reinterpret_cast<const char *>(data), (qint64)size) == (qint64)size);
+}
+
+static bool pdnsaveindex(const QString &indexname, const PDN_index_header &header)
+{
+	// writes the index in the lists to the index file.
+	// QSaveFile writes to a temporary file which only replaces the index
+	// once it is complete.
+	QSaveFile file(indexname);
+
+	if (!file.open(QIODevice::WriteOnly)) {
+		qDebug() << "could not write index file:" << indexname;
+		return(false);
+	}
+
+	if (!pdnwrite(file, &header, sizeof(header)) ||
+			!pdnwrite(file, pdn_columnlist.data(), pdn_columnlist.size() * sizeof(uint32_t)) ||
+			!pdnwrite(file, pdn_slotlist.data(), pdn_slotlist.size() * sizeof(PDN_slot)) ||
+			!pdnwrite(file, pdn_postinglist.data(), pdn_postinglist.size() * sizeof(uint32_t)) ||
+			!pdnwrite(file, pdn_resultlist.data(), pdn_resultlist.size())) {
+		qDebug() << "could not write index file:" << indexname;
+		file.cancelWriting();
+		return(false);
+	}
+
+	return(file.commit());
+}
+
+int pdnopen(char filename[256], int gametype)
+{
+	// makes a pdn file ready to be used by PDNfind. if the index file next to
+	// it was built from the same database, it is mapped and ready at once.
+	// else the index is built and written, and then mapped as well.
+	QFileInfo info(QString::fromUtf8(filename));
+	QString indexname = QString::fromUtf8(filename) + ".idx";
+	PDN_index_header header;
+
+	pdn_indexfile.close();
+	pdn_positions.clear();
+	pdn_columnlist.clear();
+	pdn_slotlist.clear();
+	pdn_postinglist.clear();
+	pdn_resultlist.clear();
+	pdnsetcolumns(nullptr, 0);
+	pdn_slots = nullptr;
+	pdn_nslots = 0;
+	pdn_postings = nullptr;
+	pdn_results = nullptr;
+	pdn_ngames = 0;
+
+	memset(&header, 0, sizeof(header));
+	header.magic = PDNINDEXMAGIC;
+	header.version = PDNINDEXVERSION;
+	header.gametype = gametype;
+	header.pdnsize = (uint64_t)info.size();
+	header.pdnmtime = info.lastModified().toMSecsSinceEpoch();
+	if (info.exists() && pdnmapindex(indexname, header))
+		return(1);
+
+	if (!pdnbuildindex(filename, gametype))
+		return(0);
+
+	try {
+		pdnbuildhash();
+		pdnbuildcolumns();
+	}
+	catch(...) {
+		qDebug() << "Failed to allocate memory for the hash table of" << filename; // Use qDebug
+		pdn_positions.clear();
+		pdn_columnlist.clear();
+		pdn_slotlist.clear();
+		pdn_postinglist.clear();
+		pdn_resultlist.clear();
+		return(0);
+	}
+
+	// if the index can not be saved, e.g. in a read-only directory, it is
+	// used from memory
+	header.npositions = pdn_positions.size();
+	std::vector<PDN_position>().swap(pdn_positions);
+	header.nslots = pdn_slotlist.size();
+	header.npostings = pdn_postinglist.size();
+	header.ngames = pdn_resultlist.size();
+	if (pdnsaveindex(indexname, header) && pdnmapindex(indexname, header)) {
+		std::vector<uint32_t>().swap(pdn_columnlist);
+		std::vector<PDN_slot>().swap(pdn_slotlist);
+		std::vector<uint32_t>().swap(pdn_postinglist);
+		std::vector<uint8_t>().swap(pdn_resultlist);
+	}
+	else {
+		pdnsetcolumns(pdn_columnlist.data(), (size_t)header.npositions);
+		pdn_slots = pdn_slotlist.data();
+		pdn_nslots = pdn_slotlist.size();
+		pdn_postings = pdn_postinglist.data();
+		pdn_results = pdn_resultlist.data();
+		pdn_ngames = pdn_resultlist.size();
+	}
+
+	return(1);
+}
+
+int pdnfind(pos *position, int color, std::vector<int> &preview_to_game_index_map, RESULT_COUNTS &counts)
+{
+	// finds the games of the open database in which position occurs with
+	// color to move. their indexes are returned in preview_to_game_index_map
+	// in ascending order, and their results are counted in counts.
+	// returns the number of games.
+	const PDN_slot *slot;
+	uint64_t key;
+	size_t i, mask;
+	uint32_t k, game;
+
+	preview_to_game_index_map.clear();
+	memset(&counts, 0, sizeof(counts));
+	if (pdn_nslots == 0)
+		return(0);
+
+	key = positionkey(position->bm | position->bk, position->wm | position->wk, position->bk | position->wk, color);
+	mask = pdn_nslots - 1;
+	for (i = key & mask; pdn_slots[i].key != key; i = (i + 1) & mask) {
+		if (pdn_slots[i].key == 0)
+			return(0);
+	}
+
+	slot = &pdn_slots[i];
+	preview_to_game_index_map.reserve(slot->count);
+	for (k = 0; k < slot->count; k++) {
+		game = pdn_postings[slot->first + k];
+		preview_to_game_index_map.push_back((int)game);
+		switch (pdn_results[game]) {
+		case PDN_RESULT_BLACK_WINS:
+			counts.black_wins++;
+			break;
+
+		case PDN_RESULT_WHITE_WINS:
+			counts.white_wins++;
+			break;
+
+		case PDN_RESULT_DRAW:
+			counts.draws++;
+			break;
+
+		default:
+			counts.unknowns++;
+			break;
+		}
+	}
+
+	return((int)slot->count);
+}
+
+/* pdnfindtheme looks for the positions which contain all pieces of the
+   theme: a position matches if none of these bits is set
+	   (theme black & ~black) | (theme white & ~white) |
+	   (theme kings & ~kings) | (theme men & kings)
+   the scan goes through the position columns, on x86 with SSE2 4 and with
+   AVX2 16 positions at a time. a scan calls addtheme() with the index of
+   every matching position. */
+struct PDN_theme {
+	uint32_t black, white, kings, men;
+	std::vector<int> *games;
+};
+
+static inline void addtheme(PDN_theme &theme, size_t i)
+{
+	// a game is listed once, however many of its positions match. the
+	// positions are in game order, so it is enough to look at the last one.
+	int game = (int)pdn_games[i];
+
+	if (theme.games->empty() || theme.games->back() != game)
+		theme.games->push_back(game);
+}
+
+static inline bool thememiss(const PDN_theme &theme, size_t i)
+{
+	return(((theme.black & ~pdn_black[i]) | (theme.white & ~pdn_white[i]) |
+			(theme.kings & ~pdn_kings[i]) | (theme.men & pdn_kings[i])) != 0);
+}
+
+static void scantheme(PDN_theme &theme, size_t first, size_t last)
+{
+	size_t i;
+
+	for (i = first; i < last; i++) {
+		if (!thememiss(theme, i))
+			addtheme(theme, i);
+	}
+}
+
+#ifdef PDNFIND_X86
+static inline int lsb(unsigned int x)
+{
+	// index of the lowest bit set in x, x must not be 0
+#if defined(__GNUC__) || defined(__clang__)
+	return(__builtin_ctz(x));
+#else
+	unsigned long bitpos;
+
+	_BitScanForward(&bitpos, x);
+	return((int)bitpos);
+#endif
+}
+
+static size_t scantheme_sse2(PDN_theme &theme)
+{
+	// scans 4 positions at a time, returns how many it has scanned
+	const __m128i black = _mm_set1_epi32((int)theme.black);
+	const __m128i white = _mm_set1_epi32((int)theme.white);
+	const __m128i kings = _mm_set1_epi32((int)theme.kings);
+	const __m128i men = _mm_set1_epi32((int)theme.men);
+	const __m128i zero = _mm_setzero_si128();
+	__m128i b, w, k, miss;
+	size_t i;
+	int match;
+
+	for (i = 0; i + 4 <= pdn_npositions; i += 4) {
+		b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pdn_black + i));
+		w = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pdn_white + i));
+		k = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pdn_kings + i));
+		miss = _mm_or_si128(_mm_or_si128(_mm_andnot_si128(b, black), _mm_andnot_si128(w, white)),
+							_mm_or_si128(_mm_andnot_si128(k, kings), _mm_and_si128(k, men)));
+		match = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(miss, zero)));
+		while (match) {
+			addtheme(theme, i + lsb(match));
+			match &= match - 1;
+		}
+	}
+	return(i);
+}
+
+#if defined(__GNUC__) || defined(__clang__)
+__attribute__((target("avx2")))
+#endif
+static inline __m256i thememiss_avx2(const PDN_theme &theme, size_t i)
+{
+	const __m256i black = _mm256_set1_epi32((int)theme.black);
+	const __m256i white = _mm256_set1_epi32((int)theme.white);
+	const __m256i kings = _mm256_set1_epi32((int)theme.kings);
+	const __m256i men = _mm256_set1_epi32((int)theme.men);
+	__m256i b, w, k;
+
+	b = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(pdn_black + i));
+	w = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(pdn_white + i));
+	k = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(pdn_kings + i));
+	return(_mm256_or_si256(_mm256_or_si256(_mm256_andnot_si256(b, black), _mm256_andnot_si256(w, white)),
+						   _mm256_or_si256(_mm256_andnot_si256(k, kings), _mm256_and_si256(k, men))));
+}
+
+#if defined(__GNUC__) || defined(__clang__)
+__attribute__((target("avx2")))
+#endif
+static size_t scantheme_avx2(PDN_theme &theme)
+{
+	// scans 16 positions at a time, returns how many it has scanned
+	const __m256i zero = _mm256_setzero_si256();
+	size_t i;
+	int match;
+
+	for (i = 0; i + 16 <= pdn_npositions; i += 16) {
+		match = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(thememiss_avx2(theme, i), zero)));
+		match |= _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(thememiss_avx2(theme, i + 8), zero))) << 8;
+		while (match) {
+			addtheme(theme, i + lsb(match));
+			match &= match - 1;
+		}
+	}
+	return(i);
+}
+
+static bool has_avx2(void)
+{
+#if defined(__GNUC__) || defined(__clang__)
+	return(__builtin_cpu_supports("avx2"));
+#elif defined(_MSC_VER)
+	// AVX2 needs the cpu flag and an OS which saves the ymm registers
+	int info[4];
+
+	__cpuid(info, 1);
+	if (!(info[2] & (1 << 27)) || (_xgetbv(0) & 6) != 6)
+		return(false);
+	__cpuidex(info, 7, 0);
+	return((info[1] & (1 << 5)) != 0);
+#else
+	return(false);
+#endif
+}
+#endif
+
+int pdnfindtheme(pos *position, std::vector<int> &preview_to_game_index_map)
+{
+	// finds the games of the open database which have a position that contains
+	// all pieces of position, on the same squares. their indexes are returned
+	// in preview_to_game_index_map in ascending order. returns the number of
+	// games.
+	PDN_theme theme;
+	size_t scanned;
+
+	preview_to_game_index_map.clear();
+	theme.black = position->bm | position->bk;
+	theme.white = position->wm | position->wk;
+	theme.kings = position->bk | position->wk;
+	theme.men = position->bm | position->wm;
+	theme.games = &preview_to_game_index_map;
+
+#ifdef PDNFIND_X86
+	static const bool avx2 = has_avx2();
+
+	scanned = avx2 ? scantheme_avx2(theme) : scantheme_sse2(theme);
+#else
+	scanned = 0;
+#endif
+	scantheme(theme, scanned, pdn_npositions);
+	return((int)preview_to_game_index_map.size());
+}
+
+// ... existing code ...
@@ -1,4 +1,6 @@
 #include "checkers_types.h"
+#include "PDNparser.h"
+#include "utility.h" // For MappedTextFile
 #include <stdlib.h> // For free
 #include <ctype.h> // For isdigit
 #include <string.h> // For strncpy
@@ -8,22 +10,19 @@
 int PDNparseGetnumberofgames(char *filename)
 {
 	// returns the number of games in a PDN file
-	char *buffer;
-	char game[1024]; // Simplified from std::string
-	char *p;
+	MappedTextFile file;
+	std::string_view rest, game;
 	int ngames;
 	READ_TEXT_FILE_ERROR_TYPE etype;
 
-	buffer = read_text_file(filename, &etype);
-	if (buffer == NULL)
+	if (!file.open(QString::fromLocal8Bit(filename), etype))
 		return -1;
 
-	p = buffer;
+	rest = file.text();
 	ngames = 0;
-	while (PDNparseGetnextgame(&p, game, sizeof(game)))
+	while (PDNparseGetnextgame(rest, game))
 		++ngames;
 
-	free(buffer);
 	return(ngames);
 }
 
@@ -169,6 +168,115 @@ int PDNparseGetnextgame(char **start, char *game, int maxlen)
 	return 0;
 }
 
+static inline char pdnchar(const char *p, const char *end)
+{
+	// the character at p, 0 at the end of the text
+	return(p < end ? *p : 0);
+}
+
+int PDNparseGetnextgame(std::string_view &rest, std::string_view &game)
+{
+	/* the same as PDNparseGetnextgame above, but on a view of the text,
+		e.g. of a memory mapped file, which need not end with a 0.
+		game is set to the span of the next game in rest, and rest to
+		what follows it. nothing is copied. */
+	const char *p, *start, *end;
+	int headersdone = 0, found = 0;
+
+	game = std::string_view();
+	start = rest.data();
+	end = start + rest.size();
+	p = start;
+	while (pdnchar(p, end) != 0) {
+
+		/* skip headers */
+		if (*p == '[' && !headersdone) {
+			p++;
+			while (pdnchar(p, end) != ']' && pdnchar(p, end) != 0) {
+
+				/* Ignore anything inside quotes (e.g. ']') within headers. */
+				if (is_pdnquote(*p)) {
+					++p;
+					while (pdnchar(p, end) != 0 && !is_pdnquote(*p))
+						++p;
+
+					if (pdnchar(p, end) == 0)
+						break;
+				}
+
+				p++;
+			}
+		}
+
+		if (pdnchar(p, end) == 0)
+			break;
+
+		/* skip comments */
+		if (*p == '{') {
+			p++;
+			while (pdnchar(p, end) != '}' && pdnchar(p, end) != 0)
+				p++;
+		}
+
+#ifdef NEMESIS
+		// skip comments, nemesis style
+		if (pdnchar(p, end) == '(') {
+			p++;
+			while (pdnchar(p, end) != ')' && pdnchar(p, end) != 0)
+				p++;
+		}
+#endif
+		if (pdnchar(p, end) == 0)
+			break;
+
+		// try to detect whether we are through with the headers
+		if (isdigit((uint8_t) *p))
+			headersdone = 1;
+
+		/* check for game terminators*/
+		if (p[0] == '[' && headersdone) {
+			p--;
+			found = 1;
+			break;
+		}
+
+		if (p[0] == '1' && pdnchar(p + 1, end) == '-' && pdnchar(p + 2, end) == '0') {
+			p += 3;
+			found = 1;
+			break;
+		}
+
+		if (p[0] == '0' && pdnchar(p + 1, end) == '-' && pdnchar(p + 2, end) == '1' && !isdigit((uint8_t) pdnchar(p + 3, end))) {
+			p += 3;
+			found = 1;
+			break;
+		}
+
+		if (p[0] == '*') {
+			p++;
+			found = 1;
+			break;
+		}
+
+		if (p[0] == '1' && pdnchar(p + 1, end) == '/' && pdnchar(p + 2, end) == '2' && pdnchar(p + 3, end) == '-' &&
+				pdnchar(p + 4, end) == '1' && pdnchar(p + 5, end) == '/' && pdnchar(p + 6, end) == '2') {
+			p += 7;
+			found = 1;
+			break;
+		}
+
+		p++;
+	}
+
+	/* at the end of the text, the rest is a game if it has moves */
+	if (!found && !headersdone)
+		return 0;
+
+	game = std::string_view(start, p - start);
+	rest.remove_prefix(p - start);
+	return (int)(p - start);
+}
+
 int PDNparseGetnextheader(const char **start, char *header, int maxlen)
 {
 	/* getnextheader */
@@ -263,4 +371,242 @@ int PDNparseGetnexttag(const char **start, char *tag, int maxlen)
 		we set the start pointer */
 	(*start) = q + 1;
 	return 1;
-}
\ No newline at end of file
+}
+int PDNparseGetnexttoken(const char **start, char *token, int maxlen)
+{
+	/* getnexttoken */
+
+	/* searches the next token in buffer, starting at **start. a token
+	is a sequence of characters which are not white space.
+	if no token is found, getnexttoken returns 0.
+	if a token is found, getnexttoken sets **start to the next
+	character after the token. the token is returned in *token */
+	const char *p;
+	int i;
+
+	if ((*start) == 0)
+		return 0;
+	p = (*start);
+	while (isspace((uint8_t) *p))
+		p++;
+	if (*p == 0)
+		return 0;
+
+	i = 0;
+	while (*p != 0 && !isspace((uint8_t) *p)) {
+		if (i < maxlen - 1)
+			token[i++] = *p;
+		p++;
+	}
+	token[i] = 0;
+	(*start) = p;
+	return 1;
+}
+
+int PDNparseGetnextPDNtoken(const char **start, char *token, int maxlen)
+{
+	/* getnextPDNtoken */
+
+	/* like getnexttoken, but knows about PDN: a comment {COMMENT}
+	is one token even if it contains blanks, and so is a nemesis
+	comment (COMMENT). a move number like 12. ends its token, also
+	if the move follows without a blank. */
+	const char *p;
+	char close;
+	int i;
+
+	if ((*start) == 0)
+		return 0;
+	p = (*start);
+	while (isspace((uint8_t) *p))
+		p++;
+	if (*p == 0)
+		return 0;
+
+	i = 0;
+	close = 0;
+	if (*p == '{')
+		close = '}';
+#ifdef NEMESIS
+	if (*p == '(')
+		close = ')';
+#endif
+	if (close) {
+		while (*p != 0 && *p != close) {
+			if (i < maxlen - 1)
+				token[i++] = *p;
+			p++;
+		}
+		if (*p == close) {
+			if (i < maxlen - 1)
+				token[i++] = *p;
+			p++;
+		}
+		token[i] = 0;
+		(*start) = p;
+		return 1;
+	}
+
+	do {
+		if (i < maxlen - 1)
+			token[i++] = *p;
+		p++;
+		if (p[-1] == '.' && isdigit((uint8_t) token[0]))
+			break;
+	} while (*p != 0 && !isspace((uint8_t) *p) && *p != '{' && *p != '(');
+	token[i] = 0;
+	(*start) = p;
+	return 1;
+}
+
+int PDNparseMove(char *token, Squarelist &move)
+{
+	/* parsemove */
+
+	/* gets the squares of a move like 11-15 or 15x24x31 from token.
+	returns the number of squares, or 0 if token is not a move,
+	e.g. a move number, a result or a comment. */
+	char *p;
+	int square;
+
+	move.clear();
+	p = token;
+	while (isdigit((uint8_t) *p)) {
+		square = 0;
+		while (isdigit((uint8_t) *p))
+			square = 10 * square + *p++ - '0';
+		if (square < 1 || square > 32)
+			return 0;
+		move.append(square);
+		if (*p != '-' && *p != 'x' && *p != ':')
+			break;
+		p++;
+	}
+
+	/* anything but a move annotation after the last square */
+	if (*p != 0 && *p != '!' && *p != '?' && *p != '*')
+		return 0;
+	if (move.size() < 2)
+		return 0;
+	return(move.size());
+}
+
+int PDNparseGetnextheader(std::string_view &rest, std::string_view &header)
+{
+	/* the same as PDNparseGetnextheader above on a view of the text:
+	header is set to what is between the next [ and ], and rest to
+	what follows the header. */
+	size_t open, i;
+	int quotecount;
+
+	open = rest.find('[');
+	if (open == std::string_view::npos)
+		return 0;
+
+	quotecount = 0;
+	for (i = open + 1; i < rest.size() && rest[i] != 0; i++) {
+		if (quotecount >= 2 && rest[i] == ']')
+			break;
+		if (rest[i] == '"')
+			++quotecount;
+	}
+
+	/* if no closing brace is found */
+	if (i >= rest.size() || rest[i] == 0)
+		return 0;
+
+	header = rest.substr(open + 1, i - open - 1);
+	rest.remove_prefix(i + 1);
+	return 1;
+}
+
+int PDNparseGetnexttag(std::string_view &rest, std::string_view &tag)
+{
+	/* the same as PDNparseGetnexttag above on a view of the text:
+	tag is set to what is between the next pair of "s, and rest to
+	what follows the closing ". */
+	size_t open, close;
+
+	for (open = 0; open < rest.size() && rest[open] != 0 && !is_pdnquote(rest[open]); open++)
+		;
+	if (open >= rest.size() || rest[open] == 0)
+		return 0;
+
+	for (close = open + 1; close < rest.size() && rest[close] != 0 && !is_pdnquote(rest[close]); close++)
+		;
+	if (close >= rest.size() || rest[close] == 0)
+		return 0;
+
+	tag = rest.substr(open + 1, close - open - 1);
+	rest.remove_prefix(close + 1);
+	return 1;
+}
+
+int PDNparseGetnextPDNtoken(std::string_view &rest, std::string_view &token)
+{
+	/* the same as PDNparseGetnextPDNtoken above on a view of the text:
+	token is set to the next token, and rest to what follows it. */
+	const char *p, *start, *end;
+	char close;
+
+	p = rest.data();
+	end = p + rest.size();
+	while (p < end && isspace((uint8_t) *p))
+		p++;
+	if (pdnchar(p, end) == 0)
+		return 0;
+
+	start = p;
+	close = 0;
+	if (*p == '{')
+		close = '}';
+#ifdef NEMESIS
+	if (*p == '(')
+		close = ')';
+#endif
+	if (close) {
+		while (pdnchar(p, end) != 0 && *p != close)
+			p++;
+		if (pdnchar(p, end) == close)
+			p++;
+	}
+	else {
+		do {
+			p++;
+			if (p[-1] == '.' && isdigit((uint8_t) *start))
+				break;
+		} while (pdnchar(p, end) != 0 && !isspace((uint8_t) *p) && *p != '{' && *p != '(');
+	}
+
+	token = std::string_view(start, p - start);
+	rest.remove_prefix(p - rest.data());
+	return 1;
+}
+
+int PDNparseMove(std::string_view token, Squarelist &move)
+{
+	/* the same as PDNparseMove above on a view of the token */
+	size_t i;
+	int square;
+
+	move.clear();
+	i = 0;
+	while (i < token.size() && isdigit((uint8_t) token[i])) {
+		square = 0;
+		while (i < token.size() && isdigit((uint8_t) token[i]))
+			square = 10 * square + token[i++] - '0';
+		if (square < 1 || square > 32)
+			return 0;
+		move.append(square);
+		if (i == token.size() || (token[i] != '-' && token[i] != 'x' && token[i] != ':'))
+			break;
+		i++;
+	}
+
+	/* anything but a move annotation after the last square */
+	if (i < token.size() && token[i] != '!' && token[i] != '?' && token[i] != '*')
+		return 0;
+	if (move.size() < 2)
+		return 0;
+	return(move.size());
+}
@@ -8,11 +8,20 @@
 #include "utility.h"      // For cblog, writefile (needs replacing)
 #include "bitboard.h"     // For boardtobitboard
 #include "checkerboard.h" // For global state access (BAD)
+#include "PDNparser.h"    // For PDNparseMove
+
+
+// Time limit for a ponder search. The search is stopped through the playnow
+// shim, either on a ponder miss or at the deadline set by ponderHit().
+#define PONDER_MAXTIME 3600.0
 
 
 SearchThreadWorker::SearchThreadWorker(QObject *parent) : QObject(parent)
 {
     m_abortRequested.store(0);
+    m_ponderState.store(PONDER_NONE);
+    m_ponderDeadlineMs.store(0);
+    m_ponderClock.start();
 }
 
 void SearchThreadWorker::setSearchParameters(const Board8x8 board, int color, double maxtime,
@@ -31,6 +40,8 @@ void SearchThreadWorker::setSearchParameters(const Board8x8 board, int color, do
     m_gametype = gametype;
     m_abortRequested.store(0); // Reset abort flag
     m_playnow_shim = 0; // Reset shim
+    m_gameHistory.clear(); // Set again by setGameHistory() for this position
+    m_incrementalTime = false; // Set again by setIncrementalTime() for this search
 
     // TODO: Copy necessary options (like userbook enabled) or pass them
     // TODO: Query userbook *before* calling this, pass relevant move if found
@@ -42,6 +53,43 @@ void SearchThreadWorker::requestAbort()
     m_playnow_shim = 1; // Set the shim variable the engine checks
 }
 
+void SearchThreadWorker::setIncrementalTime(double increment, double remaining)
+{
+    m_incrementalTime = true;
+    m_increment = increment;
+    m_remaining = remaining;
+}
+
+void SearchThreadWorker::setPonder(bool enable)
+{
+    m_ponderEnabled = enable;
+}
+
+bool SearchThreadWorker::opponentMoved(const Board8x8 board, double maxtime)
+{
+    // Called from the main thread with the board after the opponent's move.
+    // A ponder search which is not on this position, or one which is just
+    // about to start, is stopped.
+    {
+        QMutexLocker locker(&m_ponderMutex);
+        if (m_ponderState.load() == PONDER_SEARCHING &&
+            memcmp(m_ponderBoard, board, sizeof(Board8x8)) == 0 && ponderHit(maxtime))
+            return true;
+    }
+    if (m_ponderEnabled)
+        requestAbort();
+    return false;
+}
+
+bool SearchThreadWorker::ponderHit(double maxtime)
+{
+    // The opponent played the predicted move. The running ponder search
+    // continues with what it has already searched and is stopped maxtime
+    // seconds from now. Returns false if no ponder search is running.
+    m_ponderDeadlineMs.store((int)(m_ponderClock.elapsed() + (qint64)(maxtime * 1000)));
+    return m_ponderState.testAndSetOrdered(PONDER_SEARCHING, PONDER_HIT);
+}
+
 void SearchThreadWorker::doSearch()
 {
     qDebug() << "SearchThreadWorker starting search...";
@@ -72,13 +120,15 @@ void SearchThreadWorker::doSearch()
     // QThread::currentThread()->setPriority(QThread::LowPriority); // Example
 
 
-    // --- TODO: Handle Timing Logic (Incremental vs Fixed) ---
-    // This logic depends heavily on shared state (cboptions, time_ctrl, CBstate)
-    // It needs to be refactored to either:
-    // 1. Pass all necessary timing info into setSearchParameters
-    // 2. Have the main thread calculate the correct maxtime and pass *that*
-    // For now, using the passed m_maxtime directly, which might be incorrect for some modes.
-    // calculated_maxtime = ... calculate based on m_info, m_moreinfo, game state ...
+    // --- Timing ---
+    // With an incremental time control the engine also gets the clock, and
+    // manages its time itself. Engines which ignore CB_INCR_TIME use maxtime.
+    if (m_incrementalTime) {
+        uint32_t info, moreinfo;
+        format_time_args(m_increment, m_remaining, &info, &moreinfo);
+        m_info = (m_info & ~(CB_INCR_TIME | CB_INCR_TIME_DECISECONDS)) | (int)info;
+        m_moreinfo = (int)moreinfo;
+    }
 
 
     // --- Check for Forced Moves / No Moves ---
@@ -147,11 +197,8 @@ void SearchThreadWorker::doSearch()
         // Update toolbar icon to "thinking" state
         emit updateToolbarIcon(MOVESPLAY, 19); // Assuming 19 is the red/thinking icon index
 
-        // --- TODO: send_game_history ---
-        // This needs access to the global cbgame, which is problematic.
-        // The history string should ideally be generated by MainWindow and passed
-        // via setSearchParameters or another method.
-        // send_game_history(*m_cbgame, m_board, m_color);
+        // Reversible moves since the last irreversible one, for repetitions
+        send_game_history();
 
         // Call the engine
         qDebug() << "Calling engine getmove...";
@@ -181,23 +228,8 @@ void SearchThreadWorker::doSearch()
         // --- Determine the move made ---
         // If the engine modified m_board directly (as per API doc)
         if (have_valid_movelist) {
-            bool foundMatch = false;
-            for (int i = 0; i < nmoves; ++i) {
-                Board8x8 tempBoard;
-                memcpy(tempBoard, boardBeforeMove, sizeof(Board8x8));
-                domove(movelist[i], tempBoard); // Assuming domove is accessible
-                if (memcmp(m_board, tempBoard, sizeof(Board8x8)) == 0) {
-                    bestMove = movelist[i];
-                    moveFound = true;
-                    // Generate PDN text
-                    char pdn_c[40] = {0};
-                    move_to_pdn_english(nmoves, movelist, &bestMove, pdn_c, m_gametype);
-                    pdnMoveText = QString::fromUtf8(pdn_c);
-                    qDebug() << "Move identified:" << pdnMoveText;
-                    break;
-                }
-            }
-            if (!foundMatch) {
+            moveFound = identifyEngineMove(boardBeforeMove, movelist, nmoves, &bestMove, pdnMoveText);
+            if (!moveFound) {
                 qWarning() << "Engine returned board doesn't match any generated legal move!";
                 // Restore board? Signal error?
                  emit searchFinished(false, false, bestMove, "Engine move mismatch", gameResult, "");
@@ -250,6 +282,185 @@ void SearchThreadWorker::doSearch()
     qDebug() << "Search finished. Found:" << moveFound << "PDN:" << pdnMoveText << "Status:" << statusText;
     emit searchFinished(moveFound, false, bestMove, statusText, gameResult, pdnMoveText);
 
+    // Think on the opponent's time. A game result means the game is over.
+    // Keep pondering for as long as the predictions hold.
+    if (m_ponderEnabled && moveFound && gameResult == CB_UNKNOWN) {
+        while (!m_abortRequested.load() && ponder(statusText))
+            ;
+    }
+}
+
+bool SearchThreadWorker::identifyEngineMove(const Board8x8 boardBeforeMove, CBmove movelist[], int nmoves, CBmove *bestMove, QString &pdnMoveText)
+{
+    // Find the legal move which turns boardBeforeMove into the board the
+    // engine returned in m_board.
+    for (int i = 0; i < nmoves; ++i) {
+        Board8x8 tempBoard;
+        memcpy(tempBoard, boardBeforeMove, sizeof(Board8x8));
+        domove(movelist[i], tempBoard); // Assuming domove is accessible
+        if (memcmp(m_board, tempBoard, sizeof(Board8x8)) == 0) {
+            *bestMove = movelist[i];
+            // Generate PDN text
+            char pdn_c[40] = {0};
+            move_to_pdn_english(nmoves, movelist, bestMove, pdn_c, m_gametype);
+            pdnMoveText = QString::fromUtf8(pdn_c);
+            qDebug() << "Move identified:" << pdnMoveText;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool SearchThreadWorker::predictReply(const QString& statusText, CBmove *reply, QString &replyPdn)
+{
+    // The predicted reply is the second move of the principal variation at
+    // the end of the engine's status string, "... pv 11-15 23-19 ...".
+    // Only English checkers, where the built-in move generator can check it.
+    if (m_gametype != GT_ENGLISH)
+        return false;
+
+    std::string status = statusText.toStdString();
+    size_t pos = status.rfind(" pv ");
+    if (pos == std::string::npos)
+        return false;
+
+    // Engines pad the square numbers, " 9-13" or "22x 6"; join them first.
+    std::string pv;
+    for (size_t i = pos + 4; i < status.size(); ++i) {
+        char c = status[i];
+        if (c == ' ' && ((!pv.empty() && (pv.back() == '-' || pv.back() == 'x')) ||
+                         (i + 1 < status.size() && (status[i + 1] == '-' || status[i + 1] == 'x'))))
+            continue;
+        pv += c;
+    }
+
+    char token[64];
+    int ntokens = 0;
+    size_t i = 0;
+    while (ntokens < 2) {
+        while (i < pv.size() && pv[i] == ' ')
+            ++i;
+        if (i == pv.size())
+            return false;
+        size_t end = pv.find(' ', i);
+        if (end == std::string::npos)
+            end = pv.size();
+        if (end - i >= sizeof(token))
+            return false;
+        memcpy(token, pv.data() + i, end - i);
+        token[end - i] = 0;
+        i = end;
+        ++ntokens;
+    }
+
+    Squarelist squares;
+    if (PDNparseMove(token, squares) < 2)
+        return false;
+
+    // m_board already holds the position after the engine's move.
+    CBmove movelist[MAXMOVES];
+    int iscapture = 0;
+    int opponent = CB_CHANGECOLOR(m_color);
+    int nmoves = getmovelist(opponent, movelist, m_board, &iscapture);
+    int match = -1;
+    for (int k = 0; k < nmoves; ++k) {
+        if (coorstonumber(movelist[k].from.x, movelist[k].from.y, m_gametype) != squares.first() ||
+            coorstonumber(movelist[k].to.x, movelist[k].to.y, m_gametype) != squares.last())
+            continue;
+        if (match >= 0)
+            return false; // Ambiguous capture, don't guess
+        match = k;
+    }
+    if (match < 0)
+        return false;
+
+    *reply = movelist[match];
+    replyPdn = QString::fromUtf8(token);
+    return true;
+}
+
+bool SearchThreadWorker::ponder(QString& statusText)
+{
+    // Returns true on a ponder hit, the move has then been reported with
+    // searchFinished and statusText holds the new status for the next
+    // prediction.
+    CBmove reply;
+    QString replyPdn;
+    if (!predictReply(statusText, &reply, replyPdn))
+        return false;
+
+    // Search the position after the predicted reply. The engine is told it
+    // has PONDER_MAXTIME, so it keeps deepening until it is stopped through
+    // the playnow shim: on a ponder miss by requestAbort(), on a ponder hit
+    // by the watchdog below, once the time given to ponderHit() is used up.
+    Board8x8 boardBeforeMove;
+    domove(reply, m_board);
+    memcpy(boardBeforeMove, m_board, sizeof(Board8x8));
+
+    CBmove movelist[MAXMOVES];
+    int iscapture = 0;
+    int nmoves = getmovelist(m_color, movelist, m_board, &iscapture);
+    if (nmoves == 0)
+        return false;
+
+    m_playnow_shim = 0;
+    {
+        QMutexLocker locker(&m_ponderMutex);
+        memcpy(m_ponderBoard, m_board, sizeof(Board8x8));
+        m_ponderState.store(PONDER_SEARCHING);
+    }
+    // The opponent may have moved while the reply was predicted
+    if (m_abortRequested.load()) {
+        m_ponderState.store(PONDER_NONE);
+        return false;
+    }
+    qDebug() << "Pondering on" << replyPdn;
+
+    QThread *watchdog = QThread::create([this]() {
+        while (m_ponderState.load() != PONDER_NONE) {
+            if (m_ponderState.load() == PONDER_HIT && m_ponderClock.elapsed() >= m_ponderDeadlineMs.load())
+                m_playnow_shim = 1;
+            QThread::msleep(5);
+        }
+    });
+    watchdog->start();
+
+    char statusBuffer[1024] = {0};
+    CBmove bestMove;
+    memset(&bestMove, 0, sizeof(bestMove));
+    emit updateToolbarIcon(MOVESPLAY, 19);
+    int gameResult = m_engineGetMoveFunc(m_board, m_color, PONDER_MAXTIME, statusBuffer, &m_playnow_shim,
+                                         m_info & ~(CB_INCR_TIME | CB_INCR_TIME_DECISECONDS), 0, &bestMove);
+    emit updateToolbarIcon(MOVESPLAY, 2);
+
+    bool hit = (m_ponderState.fetchAndStoreOrdered(PONDER_NONE) == PONDER_HIT);
+    watchdog->wait();
+    delete watchdog;
+
+    if (!hit || m_abortRequested.load()) {
+        qDebug() << "Ponder miss, search result discarded.";
+        return false;
+    }
+
+    QString pdnMoveText;
+    if (nmoves == 1) {
+        // The engine may return a forced move without changing the board
+        bestMove = movelist[0];
+        memcpy(m_board, boardBeforeMove, sizeof(Board8x8));
+        domove(bestMove, m_board);
+        char pdn_c[40] = {0};
+        move_to_pdn_english(nmoves, movelist, &bestMove, pdn_c, m_gametype);
+        pdnMoveText = QString::fromUtf8(pdn_c);
+    } else if (!identifyEngineMove(boardBeforeMove, movelist, nmoves, &bestMove, pdnMoveText)) {
+        qWarning() << "Engine returned board doesn't match any generated legal move!";
+        emit searchFinished(false, false, bestMove, "Engine move mismatch", gameResult, "");
+        return false;
+    }
+
+    statusText = QString::fromUtf8(statusBuffer);
+    qDebug() << "Ponder hit. PDN:" << pdnMoveText << "Status:" << statusText;
+    emit searchFinished(true, false, bestMove, statusText, gameResult, pdnMoveText);
+    return gameResult == CB_UNKNOWN;
 }
 
 
@@ -325,16 +536,64 @@ void SearchThreadWorker::detectNonConversionDraws(PDNgame &game, bool *is_draw_b
      // This logic MUST run in the main thread with access to the full game history.
 }
 
-void SearchThreadWorker::send_game_history(PDNgame &game, const Board8x8 board, int color) {
-     qDebug() << "Placeholder: send_game_history - Cannot access cbgame safely here.";
-     // History string should be generated in main thread and passed to engine command.
+void SearchThreadWorker::setGameHistory(const PDNgame &game) {
+    // Build the "set gamehist" command for m_board: the FEN of the position
+    // after the last irreversible move of the game, followed by the reversible
+    // moves (non-capture king moves) played since. Runs in the main thread,
+    // the command is sent by doSearch right before getmove.
+    m_gameHistory.clear();
+    int last = qMin(game.movesindex, (int)game.moves.size());
+    int first = last;
+    while (first > 0) {
+        const CBmove &move = game.moves[first - 1].move;
+        if (move.jumps != 0 || !(move.oldpiece & CB_KING))
+            break;
+        --first;
+    }
+
+    Board8x8 board;
+    memcpy(board, m_board, sizeof(Board8x8));
+    for (int i = last - 1; i >= first; --i) {
+        CBmove move = game.moves[i].move;
+        undomove(move, board);
+    }
+    int color = m_color;
+    if ((last - first) & 1)
+        color = CB_CHANGECOLOR(color);
+
+    char fen_c[256];
+    board8toFEN(board, fen_c, color, m_gametype);
+    m_gameHistory = std::string("set gamehist ") + fen_c;
+    for (int i = first; i < last; ++i) {
+        m_gameHistory += ' ';
+        m_gameHistory += game.moves[i].PDN;
+    }
+}
+
+void SearchThreadWorker::send_game_history() {
+    if (!m_engineCommandFunc || m_gameHistory.empty())
+        return;
+
+    std::string command = m_gameHistory; // The engine API takes a non-const string
+    char reply_c[ENGINECOMMAND_REPLY_SIZE] = {0};
+    if (!m_engineCommandFunc(&command[0], reply_c))
+        qDebug() << "Engine does not support 'set gamehist'";
 }
 
 void SearchThreadWorker::format_time_args(double increment, double remaining, uint32_t *info, uint32_t *moreinfo) {
-    qDebug() << "Placeholder: format_time_args called";
-    // TODO: Port logic from CheckerBoard.c
-    *info = 0;
-    *moreinfo = 0;
+    // Pack an incremental time control into the getmove() info/moreinfo
+    // arguments, see cb_interface.h. Times are sent in milliseconds unless one
+    // of them does not fit in 16 bits, then in units of 0.1 seconds. Values
+    // are rounded down, so the engine never sees more time than it has.
+    double unit = 0.001;
+    *info = CB_INCR_TIME;
+    if (remaining / unit > CB_INCR_TIME_MAX || increment / unit > CB_INCR_TIME_MAX) {
+        unit = 0.1;
+        *info |= CB_INCR_TIME_DECISECONDS;
+    }
+    uint32_t remaining_units = (uint32_t)qBound(0.0, remaining / unit, (double)CB_INCR_TIME_MAX);
+    uint32_t increment_units = (uint32_t)qBound(0.0, increment / unit, (double)CB_INCR_TIME_MAX);
+    *moreinfo = remaining_units | (increment_units << 16);
 }
 
 double SearchThreadWorker::maxtime_for_incremental_tc(double remaining) {
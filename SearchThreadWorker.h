@@ -6,6 +6,7 @@
 #include <QMutex>
 #include <QAtomicInt>
 #include <QString>
+#include <string>
 #include "checkers_types.h" // For Board8x8, CBmove, game state etc.
 #include "cb_interface.h"   // For engine function pointer types (CB_GETMOVE etc.)
 
@@ -25,6 +26,27 @@ public:
 
     void requestAbort(); // Method for main thread to signal abortion
 
+    // Call after setSearchParameters() if the game has an incremental time
+    // control: the increment per move and the time left on the engine's
+    // clock, in seconds. doSearch() passes both to the engine in info and
+    // moreinfo, see CB_INCR_TIME in cb_interface.h.
+    void setIncrementalTime(double increment, double remaining);
+
+    // Call after setSearchParameters(): game is the game that led to the
+    // search position, its reversible moves are sent to the engine with
+    // "set gamehist" so that it can detect repetitions.
+    void setGameHistory(const PDNgame &game);
+
+    // Pondering: after each move the worker predicts the opponent's reply
+    // from the engine's PV and searches the position after it. The code which
+    // applies the opponent's move calls opponentMoved() with the board after
+    // it. If that is the position being pondered, the ponder search becomes
+    // the real search, stopped maxtime seconds from now, and reports its move
+    // with searchFinished(). Otherwise the ponder search is stopped and
+    // opponentMoved() returns false: the caller starts a normal search.
+    void setPonder(bool enable);
+    bool opponentMoved(const Board8x8 board, double maxtime);
+
 public slots:
     void doSearch(); // Main execution slot
 
@@ -48,6 +70,23 @@ private:
 
     QAtomicInt m_abortRequested; // Flag for graceful termination
     int m_playnow_shim = 0; // Shim variable to pass its address to getmove
+    std::string m_gameHistory; // "set gamehist" command for the search position, empty if unknown
+    bool m_incrementalTime = false; // Set by setIncrementalTime() for this search
+    double m_increment = 0;
+    double m_remaining = 0;
+
+    enum { PONDER_NONE, PONDER_SEARCHING, PONDER_HIT };
+    bool m_ponderEnabled = false;
+    QAtomicInt m_ponderState; // PONDER_NONE, PONDER_SEARCHING or PONDER_HIT
+    QAtomicInt m_ponderDeadlineMs; // After a ponder hit: stop when m_ponderClock reaches this
+    QElapsedTimer m_ponderClock;
+    QMutex m_ponderMutex; // Guards m_ponderBoard
+    Board8x8 m_ponderBoard; // The position after the predicted reply
+
+    bool identifyEngineMove(const Board8x8 boardBeforeMove, CBmove movelist[], int nmoves, CBmove *bestMove, QString &pdnMoveText);
+    bool predictReply(const QString& statusText, CBmove *reply, QString &replyPdn);
+    bool ponder(QString& statusText);
+    bool ponderHit(double maxtime);
 
     // --- Helper functions moved/adapted from CheckerBoard.c ---
     // These need safe access to shared state if they depend on it outside search params
@@ -56,7 +95,7 @@ private:
     bool move_to_pdn_english(Board8x8 board8, int color, CBmove *move, char *pdn, int gametype);
     void addMoveToGameLogically(CBmove &move, const QString& pdn); // Placeholder for game logic update signal
     void detectNonConversionDraws(PDNgame &game, bool *is_draw_by_repetition, bool *is_draw_by_40move_rule); // Needs cbgame access (problematic here)
-    void send_game_history(PDNgame &game, const Board8x8 board, int color); // Needs cbgame access
+    void send_game_history(); // Sends m_gameHistory to the engine
     void format_time_args(double increment, double remaining, uint32_t *info, uint32_t *moreinfo);
     double maxtime_for_incremental_tc(double remaining);
     double maxtime_for_non_incremental_tc(double remaining, double increment);
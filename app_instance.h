@@ -1,2 +1,2 @@
-int get_app_instance(char *name, int *app_instance);
-void close_app_instance();
+int get_app_instance(char *name, int *app_instance);
+void close_app_instance();
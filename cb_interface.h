@@ -1,13 +1,39 @@
-#pragma once
-
-#include <stdbool.h>
-#include <stdint.h>
-#include "checkers_types.h" // Include all common types and structs
-#include "CBconsts.h" // Include for CB_BLACK, CB_MAN, etc.
-
-/* Prevent name mangling of exported dll publics. */
-#ifdef __cplusplus
-#define EXTERNC extern "C"
-#else
-#define EXTERNC
-#endif
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "checkers_types.h" // Include all common types and structs
+#include "CBconsts.h" // Include for CB_BLACK, CB_MAN, etc.
+
+/* Prevent name mangling of exported dll publics. */
+#ifdef __cplusplus
+#define EXTERNC extern "C"
+#else
+#define EXTERNC
+#endif
+
+/* getmove() info bits 2 and 3: incremental (fischer) time control. If
+ * CB_INCR_TIME is set, moreinfo holds the time left on the engine's clock in
+ * bits 0-15 and the increment per move in bits 16-31. Both are in milliseconds,
+ * or in units of 0.1 seconds if CB_INCR_TIME_DECISECONDS is also set. The
+ * GUI uses the larger unit when a value does not fit in 16 bits of milliseconds.
+ */
+#define CB_INCR_TIME 4
+#define CB_INCR_TIME_DECISECONDS 8
+#define CB_INCR_TIME_MAX 0xffff
+
+/* Unpack the incremental time control arguments of getmove(), in seconds.
+ * Returns false if the time control is not incremental.
+ */
+static inline bool get_incremental_times(int info, int moreinfo, double *increment, double *remaining)
+{
+	double unit;
+
+	if (!(info & CB_INCR_TIME))
+		return(false);
+
+	unit = (info & CB_INCR_TIME_DECISECONDS) ? 0.1 : 0.001;
+	*remaining = unit * (double)(moreinfo & CB_INCR_TIME_MAX);
+	*increment = unit * (double)(((unsigned int)moreinfo >> 16) & CB_INCR_TIME_MAX);
+	return(true);
+}
@@ -18,3 +18,23 @@ int generatemovelist(int b[46], move2 movelist[MAXMOVES], int color);
 int generatecapturelist(int b[46], move2 movelist[MAXMOVES], int color);
 void domove(int b[46], move2 &move);
 void undomove(int b[46], move2 &move);
+
+/* Bitboard move generator. Positions are struct pos from checkers_types.h,
+ * bit i of each bitboard is square 4 * (i / 4) + 4 - (i % 4) in standard
+ * notation. A move is stored as the set of bits that change in each of the
+ * four bitboards, so doing and undoing a move are the same xor operation.
+ */
+struct bitmove {
+	unsigned int bm;		/* black men that change. */
+	unsigned int bk;		/* black kings that change. */
+	unsigned int wm;		/* white men that change. */
+	unsigned int wk;		/* white kings that change. */
+	char from;				/* bit index of the from square. */
+	char to;				/* bit index of the to square. */
+};
+
+int generatebitmovelist(pos *p, bitmove movelist[MAXMOVES], int color);
+int generatebitcapturelist(pos *p, bitmove movelist[MAXMOVES], int color);
+int testbitcapture(pos *p, int color);
+void dobitmove(pos *p, bitmove &move);
+void undobitmove(pos *p, bitmove &move);
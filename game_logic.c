@@ -1,34 +1,149 @@
 #include "checkers_types.h"
 #include "CBconsts.h"
+#include "CheckerBoard.h"
+#include <string.h>
 
-// Initialize the global board state with a standard checkers starting position
+// Initialize the global board state with a standard checkers starting position.
+// The board is indexed [x][y], with black's men on rows 0 to 2, see bitboard.c.
 Board8x8 cbboard8 = {
-    {EMPTY, BLACK_MAN, EMPTY, BLACK_MAN, EMPTY, BLACK_MAN, EMPTY, BLACK_MAN},
-    {BLACK_MAN, EMPTY, BLACK_MAN, EMPTY, BLACK_MAN, EMPTY, BLACK_MAN, EMPTY},
-    {EMPTY, BLACK_MAN, EMPTY, BLACK_MAN, EMPTY, BLACK_MAN, EMPTY, BLACK_MAN},
-    {EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY},
-    {EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY},
-    {WHITE_MAN, EMPTY, WHITE_MAN, EMPTY, WHITE_MAN, EMPTY, WHITE_MAN, EMPTY},
-    {EMPTY, WHITE_MAN, EMPTY, WHITE_MAN, EMPTY, WHITE_MAN, EMPTY, WHITE_MAN},
-    {WHITE_MAN, EMPTY, WHITE_MAN, EMPTY, WHITE_MAN, EMPTY, WHITE_MAN, EMPTY}
+    {BLACK_MAN, EMPTY, BLACK_MAN, EMPTY, EMPTY, EMPTY, WHITE_MAN, EMPTY},
+    {EMPTY, BLACK_MAN, EMPTY, EMPTY, EMPTY, WHITE_MAN, EMPTY, WHITE_MAN},
+    {BLACK_MAN, EMPTY, BLACK_MAN, EMPTY, EMPTY, EMPTY, WHITE_MAN, EMPTY},
+    {EMPTY, BLACK_MAN, EMPTY, EMPTY, EMPTY, WHITE_MAN, EMPTY, WHITE_MAN},
+    {BLACK_MAN, EMPTY, BLACK_MAN, EMPTY, EMPTY, EMPTY, WHITE_MAN, EMPTY},
+    {EMPTY, BLACK_MAN, EMPTY, EMPTY, EMPTY, WHITE_MAN, EMPTY, WHITE_MAN},
+    {BLACK_MAN, EMPTY, BLACK_MAN, EMPTY, EMPTY, EMPTY, WHITE_MAN, EMPTY},
+    {EMPTY, BLACK_MAN, EMPTY, EMPTY, EMPTY, WHITE_MAN, EMPTY, WHITE_MAN}
 };
 
+// Side to move on cbboard8. Whatever changes cbboard8 sets it too.
+int cbcolor = CB_BLACK;
+
 void newgame(void)
 {
     // Reset the board to the initial state
-    Board8x8 initialBoard = {
-        {EMPTY, BLACK_MAN, EMPTY, BLACK_MAN, EMPTY, BLACK_MAN, EMPTY, BLACK_MAN},
-        {BLACK_MAN, EMPTY, BLACK_MAN, EMPTY, BLACK_MAN, EMPTY, BLACK_MAN, EMPTY},
-        {EMPTY, BLACK_MAN, EMPTY, BLACK_MAN, EMPTY, BLACK_MAN, EMPTY, BLACK_MAN},
-        {EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY},
-        {EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY},
-        {WHITE_MAN, EMPTY, WHITE_MAN, EMPTY, WHITE_MAN, EMPTY, WHITE_MAN, EMPTY},
-        {EMPTY, WHITE_MAN, EMPTY, WHITE_MAN, EMPTY, WHITE_MAN, EMPTY, WHITE_MAN},
-        {WHITE_MAN, EMPTY, WHITE_MAN, EMPTY, WHITE_MAN, EMPTY, WHITE_MAN, EMPTY}
-    };
-    for (int r = 0; r < 8; ++r) {
-        for (int c = 0; c < 8; ++c) {
-            cbboard8[r][c] = initialBoard[r][c];
+    InitCheckerBoard(cbboard8);
+    cbcolor = get_startcolor(gametype());
+}
+
+int gametype(void)
+{
+    // The board, the move generator and the square numbers of this port only
+    // know English checkers.
+    return(GT_ENGLISH);
+}
+
+int get_startcolor(int gametype)
+{
+    // English checkers starts with black, all other game types with white
+    if (gametype == GT_ENGLISH)
+        return(CB_BLACK);
+    return(CB_WHITE);
+}
+
+void InitCheckerBoard(Board8x8 board)
+{
+    // Sets up the starting position: men on squares 1 to 12 for black and
+    // 21 to 32 for white.
+    int n, x, y;
+
+    memset(board, 0, sizeof(Board8x8));
+    for (n = 1; n <= 12; n++) {
+        numbertocoors(n, &x, &y, GT_ENGLISH);
+        board[x][y] = CB_BLACK | CB_MAN;
+        numbertocoors(n + 20, &x, &y, GT_ENGLISH);
+        board[x][y] = CB_WHITE | CB_MAN;
+    }
+}
+
+char *pdn_result_to_string(PDN_RESULT result, int gametype)
+{
+    // The result as the PDN Result header writes it. English checkers
+    // scores 1-0, the other game types score 2-0 and name white first.
+    switch (result) {
+    case PDN_RESULT_BLACK_WINS:
+        return((char *)(gametype == GT_ENGLISH ? "1-0" : "0-2"));
+    case PDN_RESULT_WHITE_WINS:
+        return((char *)(gametype == GT_ENGLISH ? "0-1" : "2-0"));
+    case PDN_RESULT_DRAW:
+        return((char *)(gametype == GT_ENGLISH ? "1/2-1/2" : "1-1"));
+    default:
+        return((char *)"*");
+    }
+}
+
+PDN_RESULT string_to_pdn_result(char *resultstr, int gametype)
+{
+    // The inverse of pdn_result_to_string(). Anything else is unknown.
+    int result;
+
+    for (result = PDN_RESULT_WHITE_WINS; result <= PDN_RESULT_DRAW; result++) {
+        if (strcmp(resultstr, pdn_result_to_string((PDN_RESULT)result, gametype)) == 0)
+            return((PDN_RESULT)result);
+    }
+    return(PDN_RESULT_UNKNOWN);
+}
+
+int num_matching_moves(Board8x8 board, int color, Squarelist &squares, CBmove &move, int gametype)
+{
+    // Counts the legal moves which go from the first to the last square of
+    // squares. If squares has more squares, a capture also has to pass
+    // through them in that order. move gets the last matching move.
+    CBmove movelist[MAXMOVES];
+    int i, j, n, isjump, nmatches = 0;
+
+    if (squares.size() < 2)
+        return(0);
+
+    n = getmovelist(color, movelist, board, &isjump);
+    for (i = 0; i < n; i++) {
+        if (coorstonumber(movelist[i].from.x, movelist[i].from.y, gametype) != squares.first())
+            continue;
+        if (coorstonumber(movelist[i].to.x, movelist[i].to.y, gametype) != squares.last())
+            continue;
+        if (squares.size() > 2) {
+            if (squares.size() != movelist[i].jumps + 1)
+                continue;
+            for (j = 1; j < squares.size() - 1; j++) {
+                if (coorstonumber(movelist[i].path[j].x, movelist[i].path[j].y, gametype) != squares.read(j))
+                    break;
+            }
+            if (j < squares.size() - 1)
+                continue;
         }
+        move = movelist[i];
+        nmatches++;
     }
+    return(nmatches);
+}
+
+int islegal_check(Board8x8 board, int color, Squarelist &squares, CBmove *move, int gametype)
+{
+    // Returns 1 and the move in move if squares names exactly one legal move
+    // for color on board.
+    return(num_matching_moves(board, color, squares, *move, gametype) == 1);
+}
+
+int domove(const CBmove &m, Board8x8 board)
+{
+    // Plays m on board. The side to move is up to the caller.
+    int i;
+
+    board[m.from.x][m.from.y] = CB_FREE;
+    for (i = 0; i < m.jumps; i++)
+        board[m.del[i].x][m.del[i].y] = CB_FREE;
+    board[m.to.x][m.to.y] = m.newpiece;
+    return(1);
+}
+
+int undomove(CBmove &move, Board8x8 board)
+{
+    // Takes back move, which was the last move played on board
+    int i;
+
+    board[move.to.x][move.to.y] = CB_FREE;
+    for (i = 0; i < move.jumps; i++)
+        board[move.del[i].x][move.del[i].y] = move.delpiece[i];
+    board[move.from.x][move.from.y] = move.oldpiece;
+    return(1);
 }
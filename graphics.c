@@ -37,9 +37,6 @@ void setanimationbusy(bool state) {}
 // Dummy setenginestarting (from CheckerBoard.c, not included yet)
 void setenginestarting(bool state) {}
 
-// Dummy domove (from CheckerBoard.c, not included yet)
-void domove(CBmove move, Board8x8 board) {}
-
 // Dummy coorstocoors (defined in coordinates.c)
 extern void coorstocoors(int *x, int *y, int invert, int mirror);
 
@@ -0,0 +1,772 @@
+// perft.c: move generator benchmark and test
+//	counts the leaf nodes of the tree of all legal move sequences of a given
+//	depth from a position. the counts are known for the start position, so
+//	this tests a move generator, and the time it takes measures its speed.
+//
+//	usage: perft [-g generator] [-t threads] [-m hashmb] [-n] [-c games] depth [fen]
+//		-g	simplech (generatemovelist/generatecapturelist on the 46-square
+//			board, the default), bitboard (simplech's bitboard generator) or
+//			cb (getmovelist of CB_movegen.c)
+//		-t	number of threads, the positions after the first two plies are
+//			shared out among them
+//		-m	size of the hashtable in MB, 0 (the default) for none. with a
+//			hashtable, the count of a position which was already counted
+//			with the same depth is taken from there
+//		-n	no bulk counting: also make the moves at the last ply instead of
+//			counting them
+//		-c	compare the generators instead of counting: every position of
+//			the tree to depth, and of games random games from the position,
+//			gets its moves from all three. the moves are compared by from and
+//			to square and captured squares, differences are reported with
+//			the FEN of the position
+//	perft prints the count, time and speed for every depth from 1 to depth.
+//
+//	build: compile this file with simplech.c, CB_movegen.c, bitboard.c, fen.c,
+//	coordinates.c, PDNparser.c and utility.c, which has the MappedTextFile
+//	PDNparser.c reads files with, and link with QtCore.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+#include "checkers_types.h"
+#include "CBconsts.h"
+#include "CB_movegen.h"
+#include "fen.h"
+
+/* getmovelist() fills lists of checkers_types.h's MAXMOVES, the simplech
+   generators the shorter lists of enginedefs.h */
+enum { CB_MAXMOVES = MAXMOVES };
+#undef MAXMOVES
+#include "enginedefs.h"
+
+#define BLACK CB_BLACK
+#define WHITE CB_WHITE
+#define MAN CB_MAN
+#define KING CB_KING
+#define FREE 16						/* empty square of the 46-square board */
+#define OCCUPIED 0					/* square off the 46-square board */
+
+#define SPLITPLIES 2				/* the positions after this many plies are shared out among the threads */
+#define MAXTHREADS 256
+#define START_FEN "B:W21-32:B1-12"
+#define MAXGAMEPLIES 200			/* random games of the generator comparison are stopped after this many moves */
+#define MAXREPORTS 10				/* differences which are printed in full */
+
+typedef enum {
+	GEN_SIMPLECH, GEN_BITBOARD, GEN_CB
+} GENERATOR;
+
+/* hashtable: the count of a position for one depth. like the hashtable of
+   simplech, the lock is the key xor'ed with the count, so that an entry
+   which was torn by a concurrent write does not match. */
+typedef struct {
+	uint64_t lock;
+	uint64_t count;
+} PERFTENTRY;
+
+static PERFTENTRY *perfttable;
+static uint64_t perftmask;
+static int bulkcounting = 1;
+
+/* zobrist keys: for a piece on a square of the 46-square board, on a square
+   of the 8x8 board, for white to move and for the remaining depth */
+static uint64_t zobrist46[46][16];
+static uint64_t zobrist8[8][8][16];
+static uint64_t zobrist_white;
+static uint64_t zobrist_depth[64];
+
+static uint64_t splitmix64(uint64_t *state)
+{
+	/* deterministic pseudo random numbers for the zobrist keys */
+	uint64_t z = (*state += 0x9e3779b97f4a7c15ull);
+
+	z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+	z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+	return(z ^ (z >> 31));
+}
+
+static void initkeys(void)
+{
+	int i, j, k;
+	uint64_t state = 1;
+
+	for (i = 0; i < 46; i++) {
+		for (k = 0; k < 16; k++)
+			zobrist46[i][k] = splitmix64(&state);
+	}
+	for (i = 0; i < 8; i++) {
+		for (j = 0; j < 8; j++) {
+			for (k = 0; k < 16; k++)
+				zobrist8[i][j][k] = splitmix64(&state);
+		}
+	}
+	zobrist_white = splitmix64(&state);
+	for (i = 0; i < 64; i++)
+		zobrist_depth[i] = splitmix64(&state);
+}
+
+/*----------> the positions of the three generators. each has the same
+              interface: generate() returns the legal moves, make() and
+              unmake() play and take back one of them and key is the
+              zobrist key of the position including the side to move. */
+
+/* simplech's 46-square board:
+				(white)
+   				37  38  39  40
+              32  33  34  35
+                28  29  30  31
+              23  24  25  26
+                19  20  21  22
+              14  15  16  17
+                10  11  12  13
+               5   6   7   8
+					(black)   */
+struct SIMPLECHPOSITION {
+	typedef move2 MOVE;
+	enum { MAXLIST = MAXMOVES };
+	int b[46];
+	int color;
+	uint64_t key;
+
+	void set(Board8x8 board, int tomove) {
+		int i, x, y;
+
+		for (i = 0; i < 46; i++)
+			b[i] = OCCUPIED;
+		for (i = 5; i <= 40; i++)
+			b[i] = FREE;
+		for (i = 9; i <= 36; i += 9)
+			b[i] = OCCUPIED;
+		color = tomove;
+		key = color == WHITE ? zobrist_white : 0;
+		for (i = 0; i < 32; i++) {
+			y = i / 4;
+			x = 2 * (i % 4) + (y & 1);
+			if (board[x][y]) {
+				b[i + 5 + (i / 4 + 1) / 2] = board[x][y];
+				key ^= zobrist46[i + 5 + (i / 4 + 1) / 2][(int)board[x][y]];
+			}
+		}
+	}
+	int generate(MOVE movelist[MAXMOVES]) {
+		int n = generatecapturelist(b, movelist, color);
+
+		if (n == 0)
+			n = generatemovelist(b, movelist, color);
+		return(n);
+	}
+	void make(MOVE &move) {
+		updatekey(move);
+		domove(b, move);
+		color ^= BLACK | WHITE;
+	}
+	void unmake(MOVE &move) {
+		updatekey(move);
+		undomove(b, move);
+		color ^= BLACK | WHITE;
+	}
+	void updatekey(MOVE &move) {
+		/* the same for make and unmake: every changed square's piece before
+		   and after the move */
+		int i, square, before, after;
+
+		for (i = 0; i < move.n; i++) {
+			square = move.m[i] & 255;
+			before = (move.m[i] >> 8) & 255;
+			after = (move.m[i] >> 16) & 255;
+			if (before != FREE)
+				key ^= zobrist46[square][before & 15];
+			if (after != FREE)
+				key ^= zobrist46[square][after & 15];
+		}
+		key ^= zobrist_white;
+	}
+};
+
+/* simplech's bitboards, see enginedefs.h */
+struct BITBOARDPOSITION {
+	typedef bitmove MOVE;
+	enum { MAXLIST = MAXMOVES };
+	pos p;
+	int color;
+	uint64_t key;
+
+	void set(Board8x8 board, int tomove) {
+		int i, x, y;
+
+		p.bm = p.bk = p.wm = p.wk = 0;
+		for (i = 0; i < 32; i++) {
+			y = i / 4;
+			x = 2 * (i % 4) + (y & 1);
+			if (board[x][y] == (BLACK | MAN))
+				p.bm |= 1u << i;
+			if (board[x][y] == (BLACK | KING))
+				p.bk |= 1u << i;
+			if (board[x][y] == (WHITE | MAN))
+				p.wm |= 1u << i;
+			if (board[x][y] == (WHITE | KING))
+				p.wk |= 1u << i;
+		}
+		color = tomove;
+		setkey();
+	}
+	void setkey(void) {
+		/* the bitboards are the position, mixing them is enough for a key */
+		uint64_t state = ((uint64_t)p.bm << 32 | p.wm) ^ (color == WHITE ? zobrist_white : 0);
+
+		key = splitmix64(&state);
+		state ^= (uint64_t)p.bk << 32 | p.wk;
+		key ^= splitmix64(&state);
+	}
+	int generate(MOVE movelist[MAXMOVES]) {
+		int n = generatebitcapturelist(&p, movelist, color);
+
+		if (n == 0)
+			n = generatebitmovelist(&p, movelist, color);
+		return(n);
+	}
+	void make(MOVE &move) {
+		dobitmove(&p, move);
+		color ^= BLACK | WHITE;
+		setkey();
+	}
+	void unmake(MOVE &move) {
+		undobitmove(&p, move);
+		color ^= BLACK | WHITE;
+		setkey();
+	}
+};
+
+/* CheckerBoard's 8x8 board and getmovelist() */
+struct CBPOSITION {
+	typedef CBmove MOVE;
+	enum { MAXLIST = CB_MAXMOVES };
+	Board8x8 b;
+	int color;
+	uint64_t key;
+
+	void set(Board8x8 board, int tomove) {
+		int x, y;
+
+		memcpy(b, board, sizeof(Board8x8));
+		color = tomove;
+		key = color == WHITE ? zobrist_white : 0;
+		for (x = 0; x < 8; x++) {
+			for (y = 0; y < 8; y++) {
+				if (b[x][y])
+					key ^= zobrist8[x][y][(int)b[x][y]];
+			}
+		}
+	}
+	int generate(MOVE movelist[MAXLIST]) {
+		int isjump;
+
+		return(getmovelist(color, movelist, b, &isjump));
+	}
+	void make(MOVE &move) {
+		int i;
+
+		for (i = 0; i < move.jumps; i++) {
+			b[move.del[i].x][move.del[i].y] = CB_FREE;
+			key ^= zobrist8[move.del[i].x][move.del[i].y][move.delpiece[i]];
+		}
+		b[move.from.x][move.from.y] = CB_FREE;
+		b[move.to.x][move.to.y] = move.newpiece;
+		key ^= zobrist8[move.from.x][move.from.y][move.oldpiece] ^ zobrist8[move.to.x][move.to.y][move.newpiece] ^ zobrist_white;
+		color ^= BLACK | WHITE;
+	}
+	void unmake(MOVE &move) {
+		int i;
+
+		b[move.to.x][move.to.y] = CB_FREE;
+		b[move.from.x][move.from.y] = move.oldpiece;
+		for (i = 0; i < move.jumps; i++) {
+			b[move.del[i].x][move.del[i].y] = move.delpiece[i];
+			key ^= zobrist8[move.del[i].x][move.del[i].y][move.delpiece[i]];
+		}
+		key ^= zobrist8[move.from.x][move.from.y][move.oldpiece] ^ zobrist8[move.to.x][move.to.y][move.newpiece] ^ zobrist_white;
+		color ^= BLACK | WHITE;
+	}
+};
+
+/*----------> hashtable */
+static int hashtable_allocate(int mbytes)
+{
+	uint64_t entries = 1;
+
+	free(perfttable);
+	perfttable = NULL;
+	if (mbytes <= 0)
+		return(1);
+	while (2 * entries * sizeof(PERFTENTRY) <= (uint64_t)mbytes << 20)
+		entries *= 2;
+	perfttable = (PERFTENTRY *)calloc(entries, sizeof(PERFTENTRY));
+	if (perfttable == NULL)
+		return(0);
+	perftmask = entries - 1;
+	return(1);
+}
+
+static inline int hashlookup(uint64_t key, uint64_t *count)
+{
+	PERFTENTRY *e = &perfttable[key & perftmask];
+	uint64_t lock = e->lock, data = e->count;
+
+	if ((lock ^ data) != key)
+		return(0);
+	*count = data;
+	return(1);
+}
+
+static inline void hashstore(uint64_t key, uint64_t count)
+{
+	PERFTENTRY *e = &perfttable[key & perftmask];
+
+	e->count = count;
+	e->lock = key ^ count;
+}
+
+/*----------> perft */
+template <class POSITION>
+static uint64_t perft(POSITION *p, int depth)
+{
+	typename POSITION::MOVE movelist[POSITION::MAXLIST];
+	uint64_t count, key;
+	int i, n;
+
+	if (depth == 0)
+		return(1);
+
+	key = p->key ^ zobrist_depth[depth];
+	if (perfttable && depth > 1 && hashlookup(key, &count))
+		return(count);
+
+	n = p->generate(movelist);
+	if (depth == 1 && bulkcounting)
+		return(n);
+
+	count = 0;
+	for (i = 0; i < n; i++) {
+		p->make(movelist[i]);
+		count += perft(p, depth - 1);
+		p->unmake(movelist[i]);
+	}
+
+	if (perfttable && depth > 1)
+		hashstore(key, count);
+	return(count);
+}
+
+template <class POSITION>
+static void splitpositions(POSITION *p, int plies, std::vector<POSITION> &positions)
+{
+	/* all positions after plies moves from p, transpositions included, so
+	   that their counts add up to the count of p */
+	typename POSITION::MOVE movelist[POSITION::MAXLIST];
+	int i, n;
+
+	if (plies == 0) {
+		positions.push_back(*p);
+		return;
+	}
+	n = p->generate(movelist);
+	for (i = 0; i < n; i++) {
+		p->make(movelist[i]);
+		splitpositions(p, plies - 1, positions);
+		p->unmake(movelist[i]);
+	}
+}
+
+template <class POSITION>
+static uint64_t parallelperft(Board8x8 board, int color, int depth, int threads)
+{
+	/* the first SPLITPLIES plies are searched here, the positions after
+	   them are taken by the threads one at a time */
+	POSITION root;
+	std::vector<POSITION> positions;
+	std::vector<std::thread> workers;
+	std::atomic<size_t> next(0);
+	std::atomic<uint64_t> total(0);
+	int i, plies;
+
+	root.set(board, color);
+	plies = depth > SPLITPLIES ? SPLITPLIES : 0;
+	if (threads == 1)
+		plies = 0;
+	splitpositions(&root, plies, positions);
+
+	auto work = [&]() {
+		size_t k;
+		uint64_t count = 0;
+
+		while ((k = next++) < positions.size()) {
+			POSITION p = positions[k];
+
+			count += perft(&p, depth - plies);
+		}
+		total += count;
+	};
+
+	for (i = 1; i < threads; i++) {
+		try {
+			workers.emplace_back(work);
+		}
+		catch (...) {
+			/* could not create another thread, count with fewer */
+			break;
+		}
+	}
+	work();
+	for (i = 0; i < (int)workers.size(); i++)
+		workers[i].join();
+	return(total);
+}
+
+/*----------> generator comparison. a move is compared by its from and to
+              square and the squares it captures, all as bit indices of the
+              bitboards. */
+typedef struct {
+	int from, to;
+	unsigned int captures;
+} CANONICALMOVE;
+
+static std::mutex reportmutex;
+static int reports;
+
+static inline bool canonicalless(const CANONICALMOVE &a, const CANONICALMOVE &b)
+{
+	if (a.from != b.from)
+		return(a.from < b.from);
+	if (a.to != b.to)
+		return(a.to < b.to);
+	return(a.captures < b.captures);
+}
+
+static inline int bitof46(int square)
+{
+	/* square of the 46-square board as a bit index */
+	return(square - 5 - square / 9);
+}
+
+static inline int bitof8(coor c)
+{
+	return(4 * c.y + c.x / 2);
+}
+
+static void postoboard8(pos *p, Board8x8 board)
+{
+	int i, x, y;
+
+	memset(board, 0, sizeof(Board8x8));
+	for (i = 0; i < 32; i++) {
+		y = i / 4;
+		x = 2 * (i % 4) + (y & 1);
+		if (p->bm & (1u << i))
+			board[x][y] = BLACK | MAN;
+		if (p->bk & (1u << i))
+			board[x][y] = BLACK | KING;
+		if (p->wm & (1u << i))
+			board[x][y] = WHITE | MAN;
+		if (p->wk & (1u << i))
+			board[x][y] = WHITE | KING;
+	}
+}
+
+static void printmoves(const char *name, std::vector<CANONICALMOVE> &moves)
+{
+	/* the squares are numbered like in the FEN of board8toFEN(), bit + 1 */
+	size_t i;
+	int k;
+
+	printf("  %-8s %2i:", name, (int)moves.size());
+	for (i = 0; i < moves.size(); i++) {
+		printf(" %i%c%i", moves[i].from + 1, moves[i].captures ? 'x' : '-', moves[i].to + 1);
+		if (moves[i].captures) {
+			printf("(");
+			for (k = 0; k < 32; k++) {
+				if (moves[i].captures & (1u << k))
+					printf("%s%i", moves[i].captures & ((1u << k) - 1) ? "," : "", k + 1);
+			}
+			printf(")");
+		}
+	}
+	printf("\n");
+}
+
+static int checkposition(pos *p, int color)
+{
+	/* generate the moves of p with all three generators. returns 1 if they
+	   agree, else prints the position and returns 0 */
+	Board8x8 board;
+	SIMPLECHPOSITION s46;
+	BITBOARDPOSITION sbb;
+	CBPOSITION scb;
+	move2 list46[MAXMOVES];
+	bitmove listbb[MAXMOVES];
+	CBmove listcb[CB_MAXMOVES];
+	std::vector<CANONICALMOVE> moves46, movesbb, movescb;
+	CANONICALMOVE m;
+	char fen[256];
+	int i, k, n;
+
+	postoboard8(p, board);
+	s46.set(board, color);
+	sbb.set(board, color);
+	scb.set(board, color);
+
+	n = s46.generate(list46);
+	for (i = 0; i < n; i++) {
+		m.from = bitof46(list46[i].m[0] & 255);
+		m.to = bitof46(list46[i].m[1] & 255);
+		m.captures = 0;
+		for (k = 2; k < list46[i].n; k++)
+			m.captures |= 1u << bitof46(list46[i].m[k] & 255);
+		moves46.push_back(m);
+	}
+
+	n = sbb.generate(listbb);
+	for (i = 0; i < n; i++) {
+		m.from = listbb[i].from;
+		m.to = listbb[i].to;
+		m.captures = color == BLACK ? listbb[i].wm | listbb[i].wk : listbb[i].bm | listbb[i].bk;
+		movesbb.push_back(m);
+	}
+
+	n = scb.generate(listcb);
+	for (i = 0; i < n; i++) {
+		m.from = bitof8(listcb[i].from);
+		m.to = bitof8(listcb[i].to);
+		m.captures = 0;
+		for (k = 0; k < listcb[i].jumps; k++)
+			m.captures |= 1u << bitof8(listcb[i].del[k]);
+		movescb.push_back(m);
+	}
+
+	std::sort(moves46.begin(), moves46.end(), canonicalless);
+	std::sort(movesbb.begin(), movesbb.end(), canonicalless);
+	std::sort(movescb.begin(), movescb.end(), canonicalless);
+	auto same = [](std::vector<CANONICALMOVE> &a, std::vector<CANONICALMOVE> &b) {
+		size_t j;
+
+		if (a.size() != b.size())
+			return(false);
+		for (j = 0; j < a.size(); j++) {
+			if (canonicalless(a[j], b[j]) || canonicalless(b[j], a[j]))
+				return(false);
+		}
+		return(true);
+	};
+	if (same(moves46, movesbb) && same(moves46, movescb))
+		return(1);
+
+	std::lock_guard<std::mutex> lock(reportmutex);
+	if (++reports <= MAXREPORTS) {
+		board8toFEN(board, fen, color, GT_ENGLISH);
+		printf("generators differ in %s\n", fen);
+		printmoves("simplech", moves46);
+		printmoves("bitboard", movesbb);
+		printmoves("cb", movescb);
+	}
+	return(0);
+}
+
+static uint64_t checktree(BITBOARDPOSITION *p, int depth, uint64_t *differences)
+{
+	/* compare the generators in p and in all positions up to depth plies
+	   after it. returns the number of positions */
+	bitmove movelist[MAXMOVES];
+	uint64_t count = 1;
+	int i, n;
+
+	if (!checkposition(&p->p, p->color))
+		(*differences)++;
+	if (depth == 0)
+		return(count);
+
+	n = p->generate(movelist);
+	for (i = 0; i < n; i++) {
+		p->make(movelist[i]);
+		count += checktree(p, depth - 1, differences);
+		p->unmake(movelist[i]);
+	}
+	return(count);
+}
+
+static uint64_t checkgame(BITBOARDPOSITION p, uint64_t seed, uint64_t *differences)
+{
+	/* compare the generators along a game of random moves from p */
+	bitmove movelist[MAXMOVES];
+	std::mt19937_64 random(seed);
+	uint64_t count = 0;
+	int ply, n;
+
+	for (ply = 0; ply < MAXGAMEPLIES; ply++) {
+		count++;
+		if (!checkposition(&p.p, p.color))
+			(*differences)++;
+		n = p.generate(movelist);
+		if (n == 0)
+			break;
+		p.make(movelist[random() % n]);
+	}
+	return(count);
+}
+
+static int comparegenerators(Board8x8 board, int color, int depth, int games, int threads)
+{
+	/* the positions after the first SPLITPLIES plies and the random games
+	   are taken by the threads one at a time. returns the number of
+	   positions in which the generators differ */
+	BITBOARDPOSITION root;
+	std::vector<BITBOARDPOSITION> positions;
+	std::vector<std::thread> workers;
+	std::atomic<size_t> next(0);
+	std::atomic<uint64_t> checked(0), differences(0);
+	uint64_t count, diff;
+	int i, plies;
+	double t;
+	auto start = std::chrono::steady_clock::now();
+
+	root.set(board, color);
+	plies = depth > SPLITPLIES ? SPLITPLIES : 0;
+	diff = 0;
+	count = 0;
+	if (plies > 0)
+		count = checktree(&root, plies - 1, &diff);
+	checked = count;
+	differences = diff;
+	splitpositions(&root, plies, positions);
+
+	auto work = [&]() {
+		size_t k;
+		uint64_t n = 0, d = 0;
+
+		while ((k = next++) < positions.size() + games) {
+			if (k < positions.size()) {
+				BITBOARDPOSITION p = positions[k];
+
+				n += checktree(&p, depth - plies, &d);
+			}
+			else
+				n += checkgame(root, k - positions.size(), &d);
+		}
+		checked += n;
+		differences += d;
+	};
+
+	for (i = 1; i < threads; i++) {
+		try {
+			workers.emplace_back(work);
+		}
+		catch (...) {
+			break;
+		}
+	}
+	work();
+	for (i = 0; i < (int)workers.size(); i++)
+		workers[i].join();
+
+	t = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	printf("compared %llu positions in %.3fs, %.0f positions/s: %llu differences\n",
+		   (unsigned long long)checked, t, t > 0 ? checked / t : 0.0, (unsigned long long)differences);
+	return(differences != 0);
+}
+
+static void usage(void)
+{
+	fprintf(stderr, "usage: perft [-g simplech|bitboard|cb] [-t threads] [-m hashmb] [-n] [-c games] depth [fen]\n");
+	exit(1);
+}
+
+int main(int argc, char *argv[])
+{
+	int i, d, depth, color, threads = 1, hashmb = 0, games = -1;
+	GENERATOR generator = GEN_SIMPLECH;
+	const char *fen = START_FEN;
+	const char *names[] = {"simplech", "bitboard", "cb"};
+	uint64_t count;
+	double t;
+	Board8x8 board;
+
+	for (i = 1; i < argc && argv[i][0] == '-'; i++) {
+		if (strcmp(argv[i], "-n") == 0)
+			bulkcounting = 0;
+		else if (i + 1 == argc)
+			usage();
+		else if (strcmp(argv[i], "-t") == 0)
+			threads = atoi(argv[++i]);
+		else if (strcmp(argv[i], "-m") == 0)
+			hashmb = atoi(argv[++i]);
+		else if (strcmp(argv[i], "-c") == 0)
+			games = std::max(atoi(argv[++i]), 0);
+		else if (strcmp(argv[i], "-g") == 0) {
+			i++;
+			if (strcmp(argv[i], "simplech") == 0)
+				generator = GEN_SIMPLECH;
+			else if (strcmp(argv[i], "bitboard") == 0)
+				generator = GEN_BITBOARD;
+			else if (strcmp(argv[i], "cb") == 0)
+				generator = GEN_CB;
+			else
+				usage();
+		}
+		else
+			usage();
+	}
+	if (i == argc || (depth = atoi(argv[i])) < 1 || depth > 63)
+		usage();
+	if (i + 1 < argc)
+		fen = argv[i + 1];
+	if (threads < 1)
+		threads = 1;
+	if (threads > MAXTHREADS)
+		threads = MAXTHREADS;
+
+	if (!FENtoboard8(board, fen, &color, GT_ENGLISH)) {
+		fprintf(stderr, "perft: not a FEN: %s\n", fen);
+		return(1);
+	}
+	initkeys();
+	if (games >= 0) {
+		printf("comparing the generators, %i threads, tree of depth %i and %i random games from %s\n",
+			   threads, depth, games, fen);
+		return(comparegenerators(board, color, depth, games, threads));
+	}
+	if (!hashtable_allocate(hashmb)) {
+		fprintf(stderr, "perft: could not allocate %i MB for the hashtable\n", hashmb);
+		return(1);
+	}
+
+	printf("perft %s, %i threads, hashtable %i MB, %s counting, %s\n",
+		   names[generator], threads, hashmb, bulkcounting ? "bulk" : "no bulk", fen);
+	for (d = 1; d <= depth; d++) {
+		auto start = std::chrono::steady_clock::now();
+
+		switch (generator) {
+		case GEN_SIMPLECH:
+			count = parallelperft<SIMPLECHPOSITION>(board, color, d, threads);
+			break;
+		case GEN_BITBOARD:
+			count = parallelperft<BITBOARDPOSITION>(board, color, d, threads);
+			break;
+		default:
+			count = parallelperft<CBPOSITION>(board, color, d, threads);
+			break;
+		}
+
+		t = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		printf("depth %2i  %16llu nodes  %9.3fs  %12.0f nodes/s\n",
+			   d, (unsigned long long)count, t, t > 0 ? count / t : 0.0);
+		fflush(stdout);
+	}
+	free(perfttable);
+	return(0);
+}
@@ -1,2 +1,2 @@
-void loadsettings(CBoptions *options, char CBdirectory[256]);
-void savesettings(CBoptions *options);
+void loadsettings(CBoptions *options, char CBdirectory[256]);
+void savesettings(CBoptions *options);
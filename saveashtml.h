@@ -1,5 +1,5 @@
-int coortohtml(coor c, int gametype);
-void PDNgametoPDNHTMLstring(PDNgame *game, std::string &pdnstring);
-int PDNgametostartposition(PDNgame *game, int b[64]);
-int saveashtml(char *filename, PDNgame *PDNgame);
-int stripquotes(char *str, char *stripped);
+int coortohtml(coor c, int gametype);
+void PDNgametoPDNHTMLstring(PDNgame *game, std::string &pdnstring);
+int PDNgametostartposition(PDNgame *game, int b[64]);
+int saveashtml(char *filename, PDNgame *PDNgame);
+int stripquotes(char *str, char *stripped);
@@ -1,2310 +1,6357 @@
-/*______________________________________________________________________________
-
-  ----------> name: simple checkers with enhancements
-  ----------> author: martin fierz
-  ----------> purpose: platform independent checkers engine
-  ----------> date: 22nd september 2002
-  ----------> description: simplech.c contains a simple but fast checkers engine
-  				  and some routines to interface to checkerboard. simplech.c contains three
-              main parts: interface, search and move generation. these parts are
-              separated in the code.
-
-              board representation: the standard checkers notation is
-
-                  (white)
-                32  31  30  29
-              28  27  26  25
-                24  23  22  21
-              20  19  18  17
-                16  15  14  13
-              12  11  10   9
-                 8   7   6   5
-               4   3   2   1
-                  (black)
-
-              the internal representation of the board is different, it is a
-              array of int with length 46, the checkers board is numbered
-              like this:
-
-                  (white)
-                37  38  39  40
-              32  33  34  35
-                28  29  30  31
-              23  24  25  26
-                19  20  21  22
-              14  15  16  17
-                10  11  12  13
-               5   6   7   8
-                  (black)
-
-              let's say, you would like to teach the program that it is
-              important to keep a back rank guard. you can for instance
-              add the following (not very sophisticated) code for this:
-
-              if(b[6] & (BLACK|MAN)) eval++;
-              if(b[8] & (BLACK|MAN)) eval++;
-              if(b[37] & (WHITE|MAN)) eval--;
-              if(b[39] & (WHITE|MAN)) eval--;
-
-              the evaluation function is seen from the point of view of the
-              black player, so you increase the value v if you think the
-              position is good for black.
-
-
-              have fun!
-
-              questions, comments, suggestions to:
-
-              		Martin Fierz
-              		checkers@fierz.ch
-
-*/
-
-
-/*----------> includes */
-// #include <ShlObj.h> // Windows specific - Removed
-// #include <Shlwapi.h> // Windows specific - Removed
-#include <stdio.h>
-#include <string.h>
-#include <time.h>
-// #include <windows.h> // Windows specific - Removed
-#include "cb_interface.h"
-#include "enginedefs.h"
-
-// --- Qt Includes ---
-#include <QStandardPaths>
-#include <QDir>
-#include <QFile>
-#include <QTextStream>
-#include <QDebug>
-#include <QString>
-// --- End Qt Includes ---
-
-
-#define VERSION "1.15"
-
-/* Piece definitions, defined in cb_interface.h  */
-#define WHITE CB_WHITE
-#define BLACK CB_BLACK
-#define MAN CB_MAN
-#define KING CB_KING
-
-#define OCCUPIED 0
-#define FREE 16
-
-#define MAXDEPTH 99
-
-/*----------> compile options  */
-#undef MUTE
-#undef VERBOSE
-#define STATISTICS
-#define LOG_TIME_MGMT
-
-/*----------> function prototypes  */
-
-/*----------> part I: interface to CheckerBoard: CheckerBoard requires that
-							 at getmove and enginename are present in the dll. the
-                      functions help, options and about are optional. if you
-                      do not provide them, CheckerBoard will display a
-                      MessageBox stating that this option is in fact not an option*/
-
-/* required functions */
-// Redefine WINAPI as empty for non-Windows builds
-#ifndef _WIN32
-#define WINAPI
-#endif
-
-int WINAPI getmove
-		(
-			Board8x8 board,
-			int color,
-			double maxtime,
-			char str[255],
-			int *playnow,
-			int info,
-			int unused,
-			CBmove *move
-		);
-
-void movetonotation(move2 move, char str[80]);
-
-/*----------> part II: search */
-int checkers(int b[46], int color, double maxtime, char *str);
-int alphabeta(int b[46], int depth, int alpha, int beta, int color);
-int firstalphabeta(int b[46], int depth, int alpha, int beta, int color, move2 *best);
-void domove(int b[46], move2 &move);
-void undomove(int b[46], move2 &move);
-int evaluation(int b[46], int color);
-
-/*----------> part III: move generation */
-int generatemovelist(int b[46], move2 movelist[MAXMOVES], int color);
-int generatecapturelist(int b[46], move2 movelist[MAXMOVES], int color);
-void blackmancapture(int b[46], int *n, move2 movelist[MAXMOVES], int square);
-void blackkingcapture(int b[46], int *n, move2 movelist[MAXMOVES], int square);
-void whitemancapture(int b[46], int *n, move2 movelist[MAXMOVES], int square);
-void whitekingcapture(int b[46], int *n, move2 movelist[MAXMOVES], int square);
-int testcapture(int b[46], int color);
-
-/*----------> globals  */
-#ifdef STATISTICS
-int generatemovelists, evaluations, generatecapturelists, testcaptures;
-#endif
-int alphabetas;
-int value[17] = { 0, 0, 0, 0, 0, 1, 256, 0, 0, 16, 4096, 0, 0, 0, 0, 0, 0 };
-int *play;
-clock_t starttime;
-double absolute_maxtime;
-
-#ifdef LOG_TIME_MGMT
-QString logfilename; // Use QString for path
-
-void init_logfile()
-{
-	// Use Qt to get Documents path and create directories/file
-    QString documentsPath = QStandardPaths::writableLocation(QStandardPaths::DocumentsLocation);
-    if (documentsPath.isEmpty()) {
-        qWarning() << "Could not find Documents directory.";
-        return; // Or fallback to current dir
-    }
-
-    QDir dir(documentsPath);
-    if (!dir.mkpath("Martin Fierz/Simplech")) {
-        qWarning() << "Could not create directories: Martin Fierz/Simplech in" << documentsPath;
-        // Fallback maybe?
-        logfilename = QDir::currentPath() + "/Simplech.log";
-    } else {
-         logfilename = dir.filePath("Martin Fierz/Simplech/Simplech.log");
-    }
-
-    // Create/clear the log file
-    QFile logFile(logfilename);
-    if (!logFile.open(QIODevice::WriteOnly | QIODevice::Text | QIODevice::Truncate)) {
-        qWarning() << "Could not open log file for writing:" << logfilename << logFile.errorString();
-    } else {
-        logFile.close(); // Just ensure it's created/cleared
-        qDebug() << "Log file initialized at:" << logfilename;
-    }
-}
-
-void log(const char *fmt, ...)
-{
-	// Use Qt file handling
-    if (logfilename.isEmpty()) return; // Don't log if init failed
-
-    va_list args;
-    va_start(args, fmt);
-    QString message = QString::vasprintf(fmt, args);
-    va_end(args);
-
-    if (message.isNull()) return; // vasprintf can fail
-
-    QFile logFile(logfilename);
-    if (!logFile.open(QIODevice::Append | QIODevice::Text)) {
-        // Log failure to debug console, avoid infinite loop
-        qDebug() << "Failed to open log file for appending:" << logfilename << logFile.errorString();
-        return;
-    }
-
-    QTextStream out(&logFile);
-    out << message;
-    logFile.close();
-}
-#endif
-
-/*-------------- PART 1: dll stuff -------------------------------------------*/
-// Removed DllMain as it's Windows specific
-// For shared libraries on Linux/macOS, initialization/cleanup can be done
-// using constructor/destructor functions if needed, but often not necessary.
-
-int WINAPI enginecommand(const char *str, char reply[256])
-{
-	// answer to commands sent by CheckerBoard.
-	// Simple Checkers does not answer to some of the commands,
-	// eg it has no engine options.
-	char command[256], param1[256], param2[256];
-
-	// Use sscanf_s on Windows, or standard sscanf otherwise
-    #ifdef _WIN32
-        sscanf_s(str, "%s %s %s", command, sizeof(command), param1, sizeof(param1), param2, sizeof(param2));
-    #else
-        sscanf(str, "%s %s %s", command, param1, param2);
-    #endif
-
-
-	// check for command keywords
-	if (strcmp(command, "name") == 0) {
-		sprintf(reply, "Simple Checkers %s", VERSION);
-		return 1;
-	}
-
-	if (strcmp(command, "about") == 0) {
-		sprintf(reply, "Simple Checkers %s\n\n2002 by Martin Fierz", VERSION);
-		return 1;
-	}
-
-	if (strcmp(command, "help") == 0) {
-		// Provide a relative path, assume help file is alongside engine library
-        // Or CheckerBoard needs to handle finding it based on engine location
-		sprintf(reply, "simplechhelp.htm");
-		return 1;
-	}
-
-	if (strcmp(command, "set") == 0) {
-		if (strcmp(param1, "hashsize") == 0) {
-			sprintf(reply, "?");
-			return 0;
-		}
-
-		if (strcmp(param1, "book") == 0) {
-			sprintf(reply, "?");
-			return 0;
-		}
-	}
-
-	if (strcmp(command, "get") == 0) {
-		if (strcmp(param1, "hashsize") == 0) {
-			sprintf(reply, "?");
-			return 0;
-		}
-
-		if (strcmp(param1, "book") == 0) {
-			sprintf(reply, "?");
-			return 0;
-		}
-
-		if (strcmp(param1, "protocolversion") == 0) {
-			sprintf(reply, "2");
-			return 1;
-		}
-
-		if (strcmp(param1, "gametype") == 0) {
-			sprintf(reply, "21");
-			return 1;
-		}
-	}
-
-	sprintf(reply, "?");
-	return 0;
-}
-
-int WINAPI getmove
-		(
-			Board8x8 b,
-			int color,
-			double maxtime,
-			char str[255],
-			int *playnow,
-			int info,
-			int moreinfo,
-			CBmove *move // Note: move is unused in simplech for returning the move
-		)
-{
-	/* getmove is what checkerboard calls. you get 6 parameters:
-   b	 	is the current position. the values in the array are determined by
-   			the #defined values of CB_BLACK, CB_WHITE, CB_KING, CB_MAN. a black king for
-            instance is represented by CB_BLACK|CB_KING.
-   color		is the side to make a move. CB_BLACK or CB_WHITE.
-   maxtime	is the time your program should use to make a move. this is
-   		   what you specify as level in checkerboard. so if you exceed
-            this time it's not too bad - just don't exceed it too much...
-   str		is a pointer to the output string of the checkerboard status bar.
-   			you can use sprintf(str,"information"); to print any information you
-            want into the status bar.
-   *playnow	is a pointer to the playnow variable of checkerboard. if the user
-   			would like your engine to play immediately, this value is nonzero,
-            else zero. you should respond to a nonzero value of *playnow by
-            interrupting your search IMMEDIATELY.
-   CBmove *move
-   			is unused here. this parameter would allow engines playing different
-            versions of checkers to return a move to CB. for engines playing
-            english checkers this is not necessary.
-            */
-	int i;
-	int value;
-	bool incremental;
-	double desired, new_iter_maxtime;
-	double remaining, increment;
-	int board[46];
-
-#ifdef LOG_TIME_MGMT
-    // Ensure log file is initialized on first call or if needed
-    if (logfilename.isEmpty()) {
-        init_logfile();
-    }
-#endif
-
-
-	/* initialize board */
-	for (i = 0; i < 46; i++)
-		board[i] = OCCUPIED;
-	for (i = 5; i <= 40; i++)
-		board[i] = FREE;
-
-	/*				(white)
-   				37  38  39  40
-              32  33  34  35
-                28  29  30  31
-              23  24  25  26
-                19  20  21  22
-              14  15  16  17
-                10  11  12  13
-               5   6   7   8
-					(black)   */
-	board[5] = b[0][0];
-	board[6] = b[2][0];
-	board[7] = b[4][0];
-	board[8] = b[6][0];
-	board[10] = b[1][1];
-	board[11] = b[3][1];
-	board[12] = b[5][1];
-	board[13] = b[7][1];
-	board[14] = b[0][2];
-	board[15] = b[2][2];
-	board[16] = b[4][2];
-	board[17] = b[6][2];
-	board[19] = b[1][3];
-	board[20] = b[3][3];
-	board[21] = b[5][3];
-	board[22] = b[7][3];
-	board[23] = b[0][4];
-	board[24] = b[2][4];
-	board[25] = b[4][4];
-	board[26] = b[6][4];
-	board[28] = b[1][5];
-	board[29] = b[3][5];
-	board[30] = b[5][5];
-	board[31] = b[7][5];
-	board[32] = b[0][6];
-	board[33] = b[2][6];
-	board[34] = b[4][6];
-	board[35] = b[6][6];
-	board[37] = b[1][7];
-	board[38] = b[3][7];
-	board[39] = b[5][7];
-	board[40] = b[7][7];
-	for (i = 5; i <= 40; i++)
-		if (board[i] == 0)
-			board[i] = FREE;
-	for (i = 9; i <= 36; i += 9)
-		board[i] = OCCUPIED;
-
-	play = playnow;
-
-	starttime = clock();
-	// Need to implement get_incremental_times or remove dependency
-    // For now, assume fixed time
-    incremental = false; // Placeholder
-    // incremental = get_incremental_times(info, moreinfo, &increment, &remaining);
-	if (incremental) {
-        // This logic remains the same, but relies on get_incremental_times
-		if (remaining < increment) {
-			desired = remaining / 1.5;
-			absolute_maxtime = remaining;
-			new_iter_maxtime = 0.7 * absolute_maxtime / 1.5;
-		}
-		else {
-			desired = increment + remaining / 9;
-			absolute_maxtime = qMin(1.5 * desired, remaining); // Use qMin
-			new_iter_maxtime = 0.7 * absolute_maxtime / 1.5;
-		}
-
-		/* Allow a few msec for overhead. */
-		if (absolute_maxtime > .01)
-			absolute_maxtime -= .003;
-	}
-	else {
-		/* Using fixed time per move. These params result in an average search time of maxtime. */
-		new_iter_maxtime = 0.59 * maxtime;
-		absolute_maxtime = 3 * maxtime;
-	}
-
-	value = checkers(board, color, new_iter_maxtime, str);
-
-#ifdef LOG_TIME_MGMT
-	if (incremental) {
-		double elapsed = (clock() - starttime) / (double)CLOCKS_PER_SEC; // Use CLOCKS_PER_SEC
-		log("incr %.1f, remaining %.3f, abs maxt %.3f, desired %.3f, new iter maxt %.3f, actual %.3f, margin %.3f %s\n",
-			increment, remaining, absolute_maxtime, desired, new_iter_maxtime,
-			elapsed, remaining - elapsed,
-			remaining - elapsed < 0 ? "***" : "");
-	}
-#endif
-	for (i = 5; i <= 40; i++)
-		if (board[i] == FREE)
-			board[i] = 0;
-
-	/* return the board */
-	b[0][0] = board[5];
-	b[2][0] = board[6];
-	b[4][0] = board[7];
-	b[6][0] = board[8];
-	b[1][1] = board[10];
-	b[3][1] = board[11];
-	b[5][1] = board[12];
-	b[7][1] = board[13];
-	b[0][2] = board[14];
-	b[2][2] = board[15];
-	b[4][2] = board[16];
-	b[6][2] = board[17];
-	b[1][3] = board[19];
-	b[3][3] = board[20];
-	b[5][3] = board[21];
-	b[7][3] = board[22];
-	b[0][4] = board[23];
-	b[2][4] = board[24];
-	b[4][4] = board[25];
-	b[6][4] = board[26];
-	b[1][5] = board[28];
-	b[3][5] = board[29];
-	b[5][5] = board[30];
-	b[7][5] = board[31];
-	b[0][6] = board[32];
-	b[2][6] = board[33];
-	b[4][6] = board[34];
-	b[6][6] = board[35];
-	b[1][7] = board[37];
-	b[3][7] = board[38];
-	b[5][7] = board[39];
-	b[7][7] = board[40];
-	if (color == BLACK) {
-		if (value > 4000)
-			return CB_WIN;
-		if (value < -4000)
-			return CB_LOSS;
-	}
-
-	if (color == WHITE) {
-		if (value > 4000)
-			return CB_LOSS;
-		if (value < -4000)
-			return CB_WIN;
-	}
-
-	return CB_UNKNOWN;
-}
-
-// ... rest of simplech.c remains largely unchanged for now ...
-// (search, evaluation, move generation logic doesn't use platform APIs)
-
-// Note: Ensure CLOCKS_PER_SEC is defined. It's standard C/C++, should be okay.
-// Note: Need to implement get_incremental_times or remove dependency if not using Qt timing.
-
-
-void movetonotation(move2 move, char str[80])
-{
-	int j, from, to;
-	char c;
-
-	from = move.m[0] % 256;
-	to = move.m[1] % 256;
-	from = from - (from / 9);
-	to = to - (to / 9);
-	from -= 5;
-	to -= 5;
-	j = from % 4;
-	from -= j;
-	j = 3 - j;
-	from += j;
-	j = to % 4;
-	to -= j;
-	j = 3 - j;
-	to += j;
-	from++;
-	to++;
-	c = '-';
-	if (move.n > 2)
-		c = 'x';
-	sprintf(str, "%2i%c%2i", from, c, to); // Was %2li, changed to %2i for int
-}
-
-/*-------------- PART II: SEARCH ---------------------------------------------*/
-int checkers(int b[46], int color, double maxtime, char *str)
-/*----------> purpose: entry point to checkers. find a move on board b for color
-  ---------->          in the time specified by maxtime, write the best move in
-  ---------->          board, returns information on the search in str
-  ----------> returns 1 if a move is found & executed, 0, if there is no legal
-  ----------> move in this position.
-  ----------> version: 1.1
-  ----------> date: 9th october 98 */
-{
-	int i, numberofmoves;
-	int eval;
-	move2 best, lastbest, movelist[MAXMOVES];
-	char str2[255];
-	alphabetas = 0;
-#ifdef STATISTICS
-	generatemovelists = 0;
-	generatecapturelists = 0;
-	evaluations = 0;
-#endif
-
-	/*--------> check if there is only one move */
-	numberofmoves = generatecapturelist(b, movelist, color);
-	if (numberofmoves == 1) {
-		domove(b, movelist[0]);
-		sprintf(str, "forced capture");
-		return(1);
-	}
-	else {
-		numberofmoves = generatemovelist(b, movelist, color);
-		if (numberofmoves == 1) {
-			domove(b, movelist[0]);
-			sprintf(str, "only move");
-			return(1);
-		}
-
-		if (numberofmoves == 0) {
-			sprintf(str, "no legal moves in this position");
-			return(0);
-		}
-	}
-
-	eval = firstalphabeta(b, 1, -10000, 10000, color, &best);
-	for (i = 2; (i <= MAXDEPTH) && ((clock() - starttime) / (double)CLOCKS_PER_SEC < maxtime); i++) { // Use CLOCKS_PER_SEC
-		lastbest = best;
-		eval = firstalphabeta(b, i, -10000, 10000, color, &best);
-		movetonotation(best, str2);
-#ifndef MUTE
-		sprintf(str, "best:%s time %2.2fs, depth %2i, value %4i", str2, (clock() - starttime) / (double)CLOCKS_PER_SEC, i, eval); // Use CLOCKS_PER_SEC, %i
-#ifdef STATISTICS
-		// Ensure correct format specifiers for int types if changed from long
-        sprintf(str2,
-                "  nodes %i, gms %i, gcs %i, evals %i",
-                alphabetas,
-                generatemovelists,
-                generatecapturelists,
-                evaluations);
-		strcat(str, str2);
-#endif
-#endif
-		if (*play)
-			break;
-		if (eval == 5000)
-			break;
-		if (eval == -5000)
-			break;
-	}
-
-	i--;
-	if (*play)
-		movetonotation(lastbest, str2);
-	else
-		movetonotation(best, str2);
-
-    // Ensure correct format specifiers for int types if changed from long
-	sprintf(str,
-			"best:%s time %2.2f, depth %2i, value %4i  nodes %i, gms %i, gcs %i, evals %i",
-			str2,
-			(clock() - starttime) / (double)CLOCKS_PER_SEC, // Use CLOCKS_PER_SEC
-			i,
-			eval,
-			alphabetas,
-			generatemovelists,
-			generatecapturelists,
-			evaluations);
-
-	if (*play)
-		domove(b, lastbest);
-	else
-		domove(b, best);
-	return eval;
-}
-
-int firstalphabeta(int b[46], int depth, int alpha, int beta, int color, move2 *best)
-/*----------> purpose: search the game tree and find the best move.
-  ----------> version: 1.0
-  ----------> date: 25th october 97 */
-{
-	int i;
-	int value;
-	int numberofmoves;
-	int capture;
-	move2 movelist[MAXMOVES];
-
-	alphabetas++;
-	if (*play)
-		return 0;
-
-	/*----------> test if captures are possible */
-	capture = testcapture(b, color);
-
-	/*----------> recursion termination if no captures and depth=0*/
-	if (depth == 0) {
-		if (capture == 0)
-			return(evaluation(b, color));
-		else
-			depth = 1;
-	}
-
-	/*----------> generate all possible moves in the position */
-	if (capture == 0) {
-		numberofmoves = generatemovelist(b, movelist, color);
-
-		/*----------> if there are no possible moves, we lose: */
-		if (numberofmoves == 0) {
-			if (color == BLACK)
-				return(-5000);
-			else
-				return(5000);
-		}
-	}
-	else
-		numberofmoves = generatecapturelist(b, movelist, color);
-
-	/*----------> for all moves: execute the move, search tree, undo move. */
-	for (i = 0; i < numberofmoves; i++) {
-		domove(b, movelist[i]);
-
-		value = alphabeta(b, depth - 1, alpha, beta, CB_CHANGECOLOR(color));
-
-		undomove(b, movelist[i]);
-		if (color == BLACK) {
-			if (value >= beta)
-				return(value);
-			if (value > alpha) {
-				alpha = value;
-				*best = movelist[i];
-			}
-		}
-
-		if (color == WHITE) {
-			if (value <= alpha)
-				return(value);
-			if (value < beta) {
-				beta = value;
-				*best = movelist[i];
-			}
-		}
-	}
-
-	if (color == BLACK)
-		return(alpha);
-	return(beta);
-}
-
-int alphabeta(int b[46], int depth, int alpha, int beta, int color)
-/*----------> purpose: search the game tree and find the best move.
-  ----------> version: 1.0
-  ----------> date: 24th october 97 */
-{
-	int i;
-	int value;
-	int capture;
-	int numberofmoves;
-	move2 movelist[MAXMOVES];
-
-	alphabetas++;
-	if ((alphabetas & 0x3ff) == 0) {
-		if ((clock() - starttime) / (double)CLOCKS_PER_SEC >= absolute_maxtime) { // Use CLOCKS_PER_SEC
-#ifdef LOG_TIME_MGMT
-			log("max detected at %.3f\n", (clock() - starttime) / (double)CLOCKS_PER_SEC); // Use CLOCKS_PER_SEC
-#endif
-			*play = 1;
-		}
-	}
-	if (*play)
-		return 0;
-
-
-	/*----------> test if captures are possible */
-	capture = testcapture(b, color);
-
-	/*----------> recursion termination if no captures and depth=0*/
-	if (depth == 0) {
-		if (capture == 0)
-			return(evaluation(b, color));
-		else
-			depth = 1;
-	}
-
-	/*----------> generate all possible moves in the position */
-	if (capture == 0) {
-		numberofmoves = generatemovelist(b, movelist, color);
-
-		/*----------> if there are no possible moves, we lose: */
-		if (numberofmoves == 0) {
-			if (color == BLACK)
-				return(-5000);
-			else
-				return(5000);
-		}
-	}
-	else
-		numberofmoves = generatecapturelist(b, movelist, color);
-
-	/*----------> for all moves: execute the move, search tree, undo move. */
-	for (i = 0; i < numberofmoves; i++) {
-		domove(b, movelist[i]);
-
-		value = alphabeta(b, depth - 1, alpha, beta, CB_CHANGECOLOR(color));
-
-		undomove(b, movelist[i]);
-
-		if (color == BLACK) {
-			if (value >= beta)
-				return(value);
-			if (value > alpha)
-				alpha = value;
-		}
-
-		if (color == WHITE) {
-			if (value <= alpha)
-				return(value);
-			if (value < beta)
-				beta = value;
-		}
-	}
-
-	if (color == BLACK)
-		return(alpha);
-	return(beta);
-}
-
-void domove(int b[46], move2 &move)
-/*----------> purpose: execute move on board
-  ----------> version: 1.1
-  ----------> date: 25th october 97 */
-{
-	int square, after;
-	int i;
-
-	for (i = 0; i < move.n; i++) {
-		square = (move.m[i] % 256);
-		after = ((move.m[i] >> 16) % 256);
-		b[square] = after;
-	}
-}
-
-void undomove(int b[46], move2 &move)
-{
-	int square, before;
-	int i;
-
-	for (i = move.n - 1; i >= 0; --i) {
-		square = (move.m[i] % 256);
-		before = ((move.m[i] >> 8) % 256);
-		b[square] = before;
-	}
-}
-
-int evaluation(int b[46], int color)
-/*----------> purpose:
-  ----------> version: 1.1
-  ----------> date: 18th april 98 */
-{
-	int i, j;
-	int eval;
-	int v1, v2;
-	int nbm, nbk, nwm, nwk;
-	int nbmc = 0, nbkc = 0, nwmc = 0, nwkc = 0;
-	int nbme = 0, nbke = 0, nwme = 0, nwke = 0;
-	int code = 0;
-	static int value[17] = { 0, 0, 0, 0, 0, 1, 256, 0, 0, 16, 4096, 0, 0, 0, 0, 0, 0 };
-	static int edge[14] = { 5, 6, 7, 8, 13, 14, 22, 23, 31, 32, 37, 38, 39, 40 };
-	static int center[8] = { 15, 16, 20, 21, 24, 25, 29, 30 };
-	static int row[41] =
-	{
-		0,
-		0,
-		0,
-		0,
-		0,
-		0,
-		0,
-		0,
-		0,
-		0,
-		1,
-		1,
-		1,
-		1,
-		2,
-		2,
-		2,
-		2,
-		0,
-		3,
-		3,
-		3,
-		3,
-		4,
-		4,
-		4,
-		4,
-		0,
-		5,
-		5,
-		5,
-		5,
-		6,
-		6,
-		6,
-		6,
-		0,
-		7,
-		7,
-		7,
-		7
-	};
-	static int safeedge[4] = { 8, 13, 32, 37 };
-
-	int tempo = 0;
-	int nm, nk;
-
-	const int turn = 2;						//color to move gets +turn
-	const int brv = 3;						//multiplier for back rank
-	const int kcv = 5;						//multiplier for kings in center
-	const int mcv = 1;						//multiplier for men in center
-	const int mev = 1;						//multiplier for men on edge
-	const int kev = 5;						//multiplier for kings on edge
-	const int cramp = 5;					//multiplier for cramp
-	const int opening = -2;					// multipliers for tempo
-	const int midgame = -1;
-	const int endgame = 2;
-	const int intactdoublecorner = 3;
-
-	int backrank;
-
-	int stonesinsystem = 0;
-
-#ifdef STATISTICS
-	evaluations++;
-#endif
-	for (i = 5; i <= 40; i++)
-		code += value[b[i]];
-
-	nwm = code % 16;
-	nwk = (code >> 4) % 16;
-	nbm = (code >> 8) % 16;
-	nbk = (code >> 12) % 16;
-
-	v1 = 100 * nbm + 130 * nbk;
-	v2 = 100 * nwm + 130 * nwk;
-
-	eval = v1 - v2;							/*material values*/
-    // Avoid division by zero if v1+v2 is 0
-    if (v1 + v2 != 0) {
-	    eval += (250 * (v1 - v2)) / (v1 + v2);	/*favor exchanges if in material plus*/
-    }
-
-	nm = nbm + nwm;
-	nk = nbk + nwk;
-
-	/*--------- fine evaluation below -------------*/
-	if (color == BLACK)
-		eval += turn;
-	else
-		eval -= turn;
-
-	/* (white)
-   				 37  38  39  40
-              32  33  34  35
-                28  29  30  31
-              23  24  25  26
-                19  20  21  22
-              14  15  16  17
-                10  11  12  13
-               5   6   7   8
-         (black)   */
-
-	/* cramp */
-	if (b[23] == (BLACK | MAN) && b[28] == (WHITE | MAN))
-		eval += cramp;
-	if (b[22] == (WHITE | MAN) && b[17] == (BLACK | MAN))
-		eval -= cramp;
-
-	/* back rank guard */
-	code = 0;
-	if (b[5] & MAN)
-		code++;
-	if (b[6] & MAN)
-		code += 2;
-	if (b[7] & MAN)
-		code += 4;
-	if (b[8] & MAN)
-		code += 8;
-	switch (code) {
-	case 0:
-		code = 0;
-		break;
-
-	case 1:
-		code = -1;
-		break;
-
-	case 2:
-		code = 1;
-		break;
-
-	case 3:
-		code = 0;
-		break;
-
-	case 4:
-		code = 1;
-		break;
-
-	case 5:
-		code = 1;
-		break;
-
-	case 6:
-		code = 2;
-		break;
-
-	case 7:
-		code = 1;
-		break;
-
-	case 8:
-		code = 1;
-		break;
-
-	case 9:
-		code = 0;
-		break;
-
-	case 10:
-		code = 7;
-		break;
-
-	case 11:
-		code = 4;
-		break;
-
-	case 12:
-		code = 2;
-		break;
-
-	case 13:
-		code = 2;
-		break;
-
-	case 14:
-		code = 9;
-		break;
-
-	case 15:
-		code = 8;
-		break;
-	}
-
-	backrank = code;
-
-	code = 0;
-	if (b[37] & MAN)
-		code += 8;
-	if (b[38] & MAN)
-		code += 4;
-	if (b[39] & MAN)
-		code += 2;
-	if (b[40] & MAN)
-		code++;
-	switch (code) {
-	case 0:
-		code = 0;
-		break;
-
-	case 1:
-		code = -1;
-		break;
-
-	case 2:
-		code = 1;
-		break;
-
-	case 3:
-		code = 0;
-		break;
-
-	case 4:
-		code = 1;
-		break;
-
-	case 5:
-		code = 1;
-		break;
-
-	case 6:
-		code = 2;
-		break;
-
-	case 7:
-		code = 1;
-		break;
-
-	case 8:
-		code = 1;
-		break;
-
-	case 9:
-		code = 0;
-		break;
-
-	case 10:
-		code = 7;
-		break;
-
-	case 11:
-		code = 4;
-		break;
-
-	case 12:
-		code = 2;
-		break;
-
-	case 13:
-		code = 2;
-		break;
-
-	case 14:
-		code = 9;
-		break;
-
-	case 15:
-		code = 8;
-		break;
-	}
-
-	backrank -= code;
-	eval += brv * backrank;
-
-	/* intact double corner */
-	if (b[8] == (BLACK | MAN)) {
-		if (b[12] == (BLACK | MAN) || b[13] == (BLACK | MAN))
-			eval += intactdoublecorner;
-	}
-
-	if (b[37] == (WHITE | MAN)) {
-		if (b[32] == (WHITE | MAN) || b[33] == (WHITE | MAN))
-			eval -= intactdoublecorner;
-	}
-
-	/* (white)
-   				 37  38  39  40
-              32  33  34  35
-                28  29  30  31
-              23  24  25  26
-                19  20  21  22
-              14  15  16  17
-                10  11  12  13
-               5   6   7   8
-         (black)   */
-
-	/* center control */
-	for (i = 0; i < 8; i++) {
-		if (b[center[i]] != FREE) {
-			if (b[center[i]] == (BLACK | MAN))
-				nbmc++;
-			if (b[center[i]] == (BLACK | KING))
-				nbkc++;
-			if (b[center[i]] == (WHITE | MAN))
-				nwmc++;
-			if (b[center[i]] == (WHITE | KING))
-				nwkc++;
-		}
-	}
-
-	eval += (nbmc - nwmc) * mcv;
-	eval += (nbkc - nwkc) * kcv;
-
-	/*edge*/
-	for (i = 0; i < 14; i++) {
-		if (b[edge[i]] != FREE) {
-			if (b[edge[i]] == (BLACK | MAN))
-				nbme++;
-			if (b[edge[i]] == (BLACK | KING))
-				nbke++;
-			if (b[edge[i]] == (WHITE | MAN))
-				nwme++;
-			if (b[edge[i]] == (WHITE | KING))
-				nwke++;
-		}
-	}
-
-	eval -= (nbme - nwme) * mev;
-	eval -= (nbke - nwke) * kev;
-
-	/* tempo */
-	for (i = 5; i < 41; i++) {
-		if (b[i] == (BLACK | MAN))
-			tempo += row[i];
-		if (b[i] == (WHITE | MAN))
-			tempo -= 7 - row[i];
-	}
-
-	if (nm >= 16)
-		eval += opening * tempo;
-	if ((nm <= 15) && (nm >= 12))
-		eval += midgame * tempo;
-	if (nm < 9)
-		eval += endgame * tempo;
-
-	for (i = 0; i < 4; i++) {
-		if (nbk + nbm > nwk + nwm && nwk < 3) {
-			if (b[safeedge[i]] == (WHITE | KING))
-				eval -= 15;
-		}
-
-		if (nwk + nwm > nbk + nbm && nbk < 3) {
-			if (b[safeedge[i]] == (BLACK | KING))
-				eval += 15;
-		}
-	}
-
-	/* the move */
-	if (nwm + nwk - nbk - nbm == 0) {
-		if (color == BLACK) {
-			for (i = 5; i <= 8; i++) {
-				for (j = 0; j < 4; j++) {
-					if (b[i + 9 * j] != FREE)
-						stonesinsystem++;
-				}
-			}
-
-			if (stonesinsystem % 2) {
-				if (nm + nk <= 12)
-					eval++;
-				if (nm + nk <= 10)
-					eval++;
-				if (nm + nk <= 8)
-					eval += 2;
-				if (nm + nk <= 6)
-					eval += 2;
-			}
-			else {
-				if (nm + nk <= 12)
-					eval--;
-				if (nm + nk <= 10)
-					eval--;
-				if (nm + nk <= 8)
-					eval -= 2;
-				if (nm + nk <= 6)
-					eval -= 2;
-			}
-		}
-		else {
-			for (i = 10; i <= 13; i++) {
-				for (j = 0; j < 4; j++) {
-					if (b[i + 9 * j] != FREE)
-						stonesinsystem++;
-				}
-			}
-
-			if ((stonesinsystem % 2) == 0) {
-				if (nm + nk <= 12)
-					eval++;
-				if (nm + nk <= 10)
-					eval++;
-				if (nm + nk <= 8)
-					eval += 2;
-				if (nm + nk <= 6)
-					eval += 2;
-			}
-			else {
-				if (nm + nk <= 12)
-					eval--;
-				if (nm + nk <= 10)
-					eval--;
-				if (nm + nk <= 8)
-					eval -= 2;
-				if (nm + nk <= 6)
-					eval -= 2;
-			}
-		}
-	}
-
-	return(eval);
-}
-
-/*-------------- PART III: MOVE GENERATION -----------------------------------*/
-int generatemovelist(int b[46], move2 movelist[MAXMOVES], int color)
-/*----------> purpose:generates all moves. no captures. returns number of moves
-  ----------> version: 1.0
-  ----------> date: 25th october 97 */
-{
-	int n = 0, m;
-	int i;
-
-#ifdef STATISTICS
-	generatemovelists++;
-#endif
-	if (color == BLACK) {
-		for (i = 5; i <= 40; i++) {
-			if ((b[i] & BLACK) != 0) {
-				if ((b[i] & MAN) != 0) {
-					if ((b[i + 4] & FREE) != 0) {
-						movelist[n].n = 2;
-						if (i >= 32)
-							m = (BLACK | KING);
-						else
-							m = (BLACK | MAN);
-						m = m << 8;
-						m += FREE;
-						m = m << 8;
-						m += i + 4;
-						movelist[n].m[1] = m;
-						m = FREE;
-						m = m << 8;
-						m += (BLACK | MAN);
-						m = m << 8;
-						m += i;
-						movelist[n].m[0] = m;
-						n++;
-					}
-
-					if ((b[i + 5] & FREE) != 0) {
-						movelist[n].n = 2;
-						if (i >= 32)
-							m = (BLACK | KING);
-						else
-							m = (BLACK | MAN);
-						m = m << 8;
-						m += FREE;
-						m = m << 8;
-						m += i + 5;
-						movelist[n].m[1] = m;
-						m = FREE;
-						m = m << 8;
-						m += (BLACK | MAN);
-						m = m << 8;
-						m += i;
-						movelist[n].m[0] = m;
-						n++;
-					}
-				}
-
-				if ((b[i] & KING) != 0) {
-					if ((b[i + 4] & FREE) != 0) {
-						movelist[n].n = 2;
-						m = (BLACK | KING);
-						m = m << 8;
-						m += FREE;
-						m = m << 8;
-						m += i + 4;
-						movelist[n].m[1] = m;
-						m = FREE;
-						m = m << 8;
-						m += (BLACK | KING);
-						m = m << 8;
-						m += i;
-						movelist[n].m[0] = m;
-						n++;
-					}
-
-					if ((b[i + 5] & FREE) != 0) {
-						movelist[n].n = 2;
-						m = (BLACK | KING);
-						m = m << 8;
-						m += FREE;
-						m = m << 8;
-						m += i + 5;
-						movelist[n].m[1] = m;
-						m = FREE;
-						m = m << 8;
-						m += (BLACK | KING);
-						m = m << 8;
-						m += i;
-						movelist[n].m[0] = m;
-						n++;
-					}
-
-					if ((b[i - 4] & FREE) != 0) {
-						movelist[n].n = 2;
-						m = (BLACK | KING);
-						m = m << 8;
-						m += FREE;
-						m = m << 8;
-						m += i - 4;
-						movelist[n].m[1] = m;
-						m = FREE;
-						m = m << 8;
-						m += (BLACK | KING);
-						m = m << 8;
-						m += i;
-						movelist[n].m[0] = m;
-						n++;
-					}
-
-					if ((b[i - 5] & FREE) != 0) {
-						movelist[n].n = 2;
-						m = (BLACK | KING);
-						m = m << 8;
-						m += FREE;
-						m = m << 8;
-						m += i - 5;
-						movelist[n].m[1] = m;
-						m = FREE;
-						m = m << 8;
-						m += (BLACK | KING);
-						m = m << 8;
-						m += i;
-						movelist[n].m[0] = m;
-						n++;
-					}
-				}
-			}
-		}
-	}
-	else {
-
-		/* color = WHITE */
-		for (i = 5; i <= 40; i++) {
-			if ((b[i] & WHITE) != 0) {
-				if ((b[i] & MAN) != 0) {
-					if ((b[i - 4] & FREE) != 0) {
-						movelist[n].n = 2;
-						if (i <= 13)
-							m = (WHITE | KING);
-						else
-							m = (WHITE | MAN);
-						m = m << 8;
-						m += FREE;
-						m = m << 8;
-						m += i - 4;
-						movelist[n].m[1] = m;
-						m = FREE;
-						m = m << 8;
-						m += (WHITE | MAN);
-						m = m << 8;
-						m += i;
-						movelist[n].m[0] = m;
-						n++;
-					}
-
-					if ((b[i - 5] & FREE) != 0) {
-						movelist[n].n = 2;
-						if (i <= 13)
-							m = (WHITE | KING);
-						else
-							m = (WHITE | MAN);
-						m = m << 8;
-						m += FREE;
-						m = m << 8;
-						m += i - 5;
-						movelist[n].m[1] = m;
-						m = FREE;
-						m = m << 8;
-						m += (WHITE | MAN);
-						m = m << 8;
-						m += i;
-						movelist[n].m[0] = m;
-						n++;
-					}
-				}
-
-				if ((b[i] & KING) != 0) {
-
-					/* or else */
-					if ((b[i + 4] & FREE) != 0) {
-						movelist[n].n = 2;
-						m = (WHITE | KING);
-						m = m << 8;
-						m += FREE;
-						m = m << 8;
-						m += i + 4;
-						movelist[n].m[1] = m;
-						m = FREE;
-						m = m << 8;
-						m += (WHITE | KING);
-						m = m << 8;
-						m += i;
-						movelist[n].m[0] = m;
-						n++;
-					}
-
-					if ((b[i + 5] & FREE) != 0) {
-						movelist[n].n = 2;
-						m = (WHITE | KING);
-						m = m << 8;
-						m += FREE;
-						m = m << 8;
-						m += i + 5;
-						movelist[n].m[1] = m;
-						m = FREE;
-						m = m << 8;
-						m += (WHITE | KING);
-						m = m << 8;
-						m += i;
-						movelist[n].m[0] = m;
-						n++;
-					}
-
-					if ((b[i - 4] & FREE) != 0) {
-						movelist[n].n = 2;
-						m = (WHITE | KING);
-						m = m << 8;
-						m += FREE;
-						m = m << 8;
-						m += i - 4;
-						movelist[n].m[1] = m;
-						m = FREE;
-						m = m << 8;
-						m += (WHITE | KING);
-						m = m << 8;
-						m += i;
-						movelist[n].m[0] = m;
-						n++;
-					}
-
-					if ((b[i - 5] & FREE) != 0) {
-						movelist[n].n = 2;
-						m = (WHITE | KING);
-						m = m << 8;
-						m += FREE;
-						m = m << 8;
-						m += i - 5;
-						movelist[n].m[1] = m;
-						m = FREE;
-						m = m << 8;
-						m += (WHITE | KING);
-						m = m << 8;
-						m += i;
-						movelist[n].m[0] = m;
-						n++;
-					}
-				}
-			}
-		}
-	}
-
-	return(n);
-}
-
-int generatecapturelist(int b[46], move2 movelist[MAXMOVES], int color)
-/*----------> purpose: generate all possible captures
-  ----------> version: 1.0
-  ----------> date: 25th october 97 */
-{
-	int n = 0;
-	int m;
-	int i;
-	int tmp;
-
-#ifdef STATISTICS
-	generatecapturelists++;
-#endif
-	if (color == BLACK) {
-		for (i = 5; i <= 40; i++) {
-			if ((b[i] & BLACK) != 0) {
-				if ((b[i] & MAN) != 0) {
-					if ((b[i + 4] & WHITE) != 0) {
-						if ((b[i + 8] & FREE) != 0) {
-							movelist[n].n = 3;
-							if (i >= 28)
-								m = (BLACK | KING);
-							else
-								m = (BLACK | MAN);
-							m = m << 8;
-							m += FREE;
-							m = m << 8;
-							m += i + 8;
-							movelist[n].m[1] = m;
-							m = FREE;
-							m = m << 8;
-							m += (BLACK | MAN);
-							m = m << 8;
-							m += i;
-							movelist[n].m[0] = m;
-							m = FREE;
-							m = m << 8;
-							m += b[i + 4];
-							m = m << 8;
-							m += i + 4;
-							movelist[n].m[2] = m;
-							blackmancapture(b, &n, movelist, i + 8);
-						}
-					}
-
-					if ((b[i + 5] & WHITE) != 0) {
-						if ((b[i + 10] & FREE) != 0) {
-							movelist[n].n = 3;
-							if (i >= 28)
-								m = (BLACK | KING);
-							else
-								m = (BLACK | MAN);
-							m = m << 8;
-							m += FREE;
-							m = m << 8;
-							m += i + 10;
-							movelist[n].m[1] = m;
-							m = FREE;
-							m = m << 8;
-							m += (BLACK | MAN);
-							m = m << 8;
-							m += i;
-							movelist[n].m[0] = m;
-							m = FREE;
-							m = m << 8;
-							m += b[i + 5];
-							m = m << 8;
-							m += i + 5;
-							movelist[n].m[2] = m;
-							blackmancapture(b, &n, movelist, i + 10);
-						}
-					}
-				}
-				else {
-
-					/* b[i] is a KING */
-					if ((b[i + 4] & WHITE) != 0) {
-						if ((b[i + 8] & FREE) != 0) {
-							movelist[n].n = 3;
-							m = (BLACK | KING);
-							m = m << 8;
-							m += FREE;
-							m = m << 8;
-							m += i + 8;
-							movelist[n].m[1] = m;
-							m = FREE;
-							m = m << 8;
-							m += (BLACK | KING);
-							m = m << 8;
-							m += i;
-							movelist[n].m[0] = m;
-							m = FREE;
-							m = m << 8;
-							m += b[i + 4];
-							m = m << 8;
-							m += i + 4;
-							movelist[n].m[2] = m;
-							tmp = b[i + 4];
-							b[i + 4] = FREE;	/* Remove captured piece. */
-							b[i] = FREE;		/* Remove capturing king. */
-							blackkingcapture(b, &n, movelist, i + 8);
-							b[i + 4] = tmp;		/* Restore captured piece. */
-							b[i] = BLACK | KING;	/* Restore capturing king. */
-						}
-					}
-
-					if ((b[i + 5] & WHITE) != 0) {
-						if ((b[i + 10] & FREE) != 0) {
-							movelist[n].n = 3;
-							m = (BLACK | KING);
-							m = m << 8;
-							m += FREE;
-							m = m << 8;
-							m += i + 10;
-							movelist[n].m[1] = m;
-							m = FREE;
-							m = m << 8;
-							m += (BLACK | KING);
-							m = m << 8;
-							m += i;
-							movelist[n].m[0] = m;
-							m = FREE;
-							m = m << 8;
-							m += b[i + 5];
-							m = m << 8;
-							m += i + 5;
-							movelist[n].m[2] = m;
-							tmp = b[i + 5];
-							b[i + 5] = FREE;
-							b[i] = FREE;			/* Remove capturing king. */
-							blackkingcapture(b, &n, movelist, i + 10);
-							b[i + 5] = tmp;
-							b[i] = BLACK | KING;	/* Restore capturing king. */
-						}
-					}
-
-					if ((b[i - 4] & WHITE) != 0) {
-						if ((b[i - 8] & FREE) != 0) {
-							movelist[n].n = 3;
-							m = (BLACK | KING);
-							m = m << 8;
-							m += FREE;
-							m = m << 8;
-							m += i - 8;
-							movelist[n].m[1] = m;
-							m = FREE;
-							m = m << 8;
-							m += (BLACK | KING);
-							m = m << 8;
-							m += i;
-							movelist[n].m[0] = m;
-							m = FREE;
-							m = m << 8;
-							m += b[i - 4];
-							m = m << 8;
-							m += i - 4;
-							movelist[n].m[2] = m;
-							tmp = b[i - 4];
-							b[i - 4] = FREE;
-							b[i] = FREE;			/* Remove capturing king. */
-							blackkingcapture(b, &n, movelist, i - 8);
-							b[i - 4] = tmp;
-							b[i] = BLACK | KING;	/* Restore capturing king. */
-						}
-					}
-
-					if ((b[i - 5] & WHITE) != 0) {
-						if ((b[i - 10] & FREE) != 0) {
-							movelist[n].n = 3;
-							m = (BLACK | KING);
-							m = m << 8;
-							m += FREE;
-							m = m << 8;
-							m += i - 10;
-							movelist[n].m[1] = m;
-							m = FREE;
-							m = m << 8;
-							m += (BLACK | KING);
-							m = m << 8;
-							m += i;
-							movelist[n].m[0] = m;
-							m = FREE;
-							m = m << 8;
-							m += b[i - 5];
-							m = m << 8;
-							m += i - 5;
-							movelist[n].m[2] = m;
-							tmp = b[i - 5];
-							b[i - 5] = FREE;
-							b[i] = FREE;			/* Remove capturing king. */
-							blackkingcapture(b, &n, movelist, i - 10);
-							b[i - 5] = tmp;
-							b[i] = BLACK | KING;	/* Restore capturing king. */
-						}
-					}
-				}
-			}
-		}
-	}
-	else {
-
-		/* color is WHITE */
-		for (i = 5; i <= 40; i++) {
-			if ((b[i] & WHITE) != 0) {
-				if ((b[i] & MAN) != 0) {
-					if ((b[i - 4] & BLACK) != 0) {
-						if ((b[i - 8] & FREE) != 0) {
-							movelist[n].n = 3;
-							if (i <= 17)
-								m = (WHITE | KING);
-							else
-								m = (WHITE | MAN);
-							m = m << 8;
-							m += FREE;
-							m = m << 8;
-							m += i - 8;
-							movelist[n].m[1] = m;
-							m = FREE;
-							m = m << 8;
-							m += (WHITE | MAN);
-							m = m << 8;
-							m += i;
-							movelist[n].m[0] = m;
-							m = FREE;
-							m = m << 8;
-							m += b[i - 4];
-							m = m << 8;
-							m += i - 4;
-							movelist[n].m[2] = m;
-							whitemancapture(b, &n, movelist, i - 8);
-						}
-					}
-
-					if ((b[i - 5] & BLACK) != 0) {
-						if ((b[i - 10] & FREE) != 0) {
-							movelist[n].n = 3;
-							if (i <= 17)
-								m = (WHITE | KING);
-							else
-								m = (WHITE | MAN);
-							m = m << 8;
-							m += FREE;
-							m = m << 8;
-							m += i - 10;
-							movelist[n].m[1] = m;
-							m = FREE;
-							m = m << 8;
-							m += (WHITE | MAN);
-							m = m << 8;
-							m += i;
-							movelist[n].m[0] = m;
-							m = FREE;
-							m = m << 8;
-							m += b[i - 5];
-							m = m << 8;
-							m += i - 5;
-							movelist[n].m[2] = m;
-							whitemancapture(b, &n, movelist, i - 10);
-						}
-					}
-				}
-				else {
-
-					/* b[i] is a KING */
-					if ((b[i + 4] & BLACK) != 0) {
-						if ((b[i + 8] & FREE) != 0) {
-							movelist[n].n = 3;
-							m = (WHITE | KING);
-							m = m << 8;
-							m += FREE;
-							m = m << 8;
-							m += i + 8;
-							movelist[n].m[1] = m;
-							m = FREE;
-							m = m << 8;
-							m += (WHITE | KING);
-							m = m << 8;
-							m += i;
-							movelist[n].m[0] = m;
-							m = FREE;
-							m = m << 8;
-							m += b[i + 4];
-							m = m << 8;
-							m += i + 4;
-							movelist[n].m[2] = m;
-							tmp = b[i + 4];
-							b[i + 4] = FREE;
-							b[i] = FREE;			/* Remove capturing king. */
-							whitekingcapture(b, &n, movelist, i + 8);
-							b[i + 4] = tmp;
-							b[i] = WHITE | KING;
-						}
-					}
-
-					if ((b[i + 5] & BLACK) != 0) {
-						if ((b[i + 10] & FREE) != 0) {
-							movelist[n].n = 3;
-							m = (WHITE | KING);
-							m = m << 8;
-							m += FREE;
-							m = m << 8;
-							m += i + 10;
-							movelist[n].m[1] = m;
-							m = FREE;
-							m = m << 8;
-							m += (WHITE | KING);
-							m = m << 8;
-							m += i;
-							movelist[n].m[0] = m;
-							m = FREE;
-							m = m << 8;
-							m += b[i + 5];
-							m = m << 8;
-							m += i + 5;
-							movelist[n].m[2] = m;
-							tmp = b[i + 5];
-							b[i + 5] = FREE;
-							b[i] = FREE;			/* Remove capturing king. */
-							whitekingcapture(b, &n, movelist, i + 10);
-							b[i + 5] = tmp;
-							b[i] = WHITE | KING;
-						}
-					}
-
-					if ((b[i - 4] & BLACK) != 0) {
-						if ((b[i - 8] & FREE) != 0) {
-							movelist[n].n = 3;
-							m = (WHITE | KING);
-							m = m << 8;
-							m += FREE;
-							m = m << 8;
-							m += i - 8;
-							movelist[n].m[1] = m;
-							m = FREE;
-							m = m << 8;
-							m += (WHITE | KING);
-							m = m << 8;
-							m += i;
-							movelist[n].m[0] = m;
-							m = FREE;
-							m = m << 8;
-							m += b[i - 4];
-							m = m << 8;
-							m += i - 4;
-							movelist[n].m[2] = m;
-							tmp = b[i - 4];
-							b[i - 4] = FREE;
-							b[i] = FREE;			/* Remove capturing king. */
-							whitekingcapture(b, &n, movelist, i - 8);
-							b[i - 4] = tmp;
-							b[i] = WHITE | KING;
-						}
-					}
-
-					if ((b[i - 5] & BLACK) != 0) {
-						if ((b[i - 10] & FREE) != 0) {
-							movelist[n].n = 3;
-							m = (WHITE | KING);
-							m = m << 8;
-							m += FREE;
-							m = m << 8;
-							m += i - 10;
-							movelist[n].m[1] = m;
-							m = FREE;
-							m = m << 8;
-							m += (WHITE | KING);
-							m = m << 8;
-							m += i;
-							movelist[n].m[0] = m;
-							m = FREE;
-							m = m << 8;
-							m += b[i - 5];
-							m = m << 8;
-							m += i - 5;
-							movelist[n].m[2] = m;
-							tmp = b[i - 5];
-							b[i - 5] = FREE;
-							b[i] = FREE;			/* Remove capturing king. */
-							whitekingcapture(b, &n, movelist, i - 10);
-							b[i - 5] = tmp;
-							b[i] = WHITE | KING;
-						}
-					}
-				}
-			}
-		}
-	}
-
-	return(n);
-}
-
-void blackmancapture(int b[46], int *n, move2 movelist[MAXMOVES], int i)
-{
-	int m;
-	int found = 0;
-	move2 move, orgmove;
-
-	orgmove = movelist[*n];
-	move = orgmove;
-
-	if ((b[i + 4] & WHITE) != 0) {
-		if ((b[i + 8] & FREE) != 0) {
-			move.n++;
-			if (i >= 28)
-				m = (BLACK | KING);
-			else
-				m = (BLACK | MAN);
-			m = m << 8;
-			m += FREE;
-			m = m << 8;
-			m += (i + 8);
-			move.m[1] = m;
-			m = FREE;
-			m = m << 8;
-			m += b[i + 4];
-			m = m << 8;
-			m += (i + 4);
-			move.m[move.n - 1] = m;
-			found = 1;
-			movelist[*n] = move;
-			blackmancapture(b, n, movelist, i + 8);
-		}
-	}
-
-	move = orgmove;
-	if ((b[i + 5] & WHITE) != 0) {
-		if ((b[i + 10] & FREE) != 0) {
-			move.n++;
-			if (i >= 28)
-				m = (BLACK | KING);
-			else
-				m = (BLACK | MAN);
-			m = m << 8;
-			m += FREE;
-			m = m << 8;
-			m += (i + 10);
-			move.m[1] = m;
-			m = FREE;
-			m = m << 8;
-			m += b[i + 5];
-			m = m << 8;
-			m += (i + 5);
-			move.m[move.n - 1] = m;
-			found = 1;
-			movelist[*n] = move;
-			blackmancapture(b, n, movelist, i + 10);
-		}
-	}
-
-	if (!found)
-		(*n)++;
-}
-
-void blackkingcapture(int b[46], int *n, move2 movelist[MAXMOVES], int i)
-{
-	int m;
-	int tmp;
-	int found = 0;
-	move2 move, orgmove;
-
-	orgmove = movelist[*n];
-	move = orgmove;
-
-	if ((b[i - 4] & WHITE) != 0) {
-		if ((b[i - 8] & FREE) != 0) {
-			move.n++;
-			m = (BLACK | KING);
-			m = m << 8;
-			m += FREE;
-			m = m << 8;
-			m += i - 8;
-			move.m[1] = m;
-			m = FREE;
-			m = m << 8;
-			m += b[i - 4];
-			m = m << 8;
-			m += i - 4;
-			move.m[move.n - 1] = m;
-			found = 1;
-			movelist[*n] = move;
-			tmp = b[i - 4];
-			b[i - 4] = FREE;
-			blackkingcapture(b, n, movelist, i - 8);
-			b[i - 4] = tmp;
-		}
-	}
-
-	move = orgmove;
-	if ((b[i - 5] & WHITE) != 0) {
-		if ((b[i - 10] & FREE) != 0) {
-			move.n++;
-			m = (BLACK | KING);
-			m = m << 8;
-			m += FREE;
-			m = m << 8;
-			m += i - 10;
-			move.m[1] = m;
-			m = FREE;
-			m = m << 8;
-			m += b[i - 5];
-			m = m << 8;
-			m += i - 5;
-			move.m[move.n - 1] = m;
-			found = 1;
-			movelist[*n] = move;
-			tmp = b[i - 5];
-			b[i - 5] = FREE;
-			blackkingcapture(b, n, movelist, i - 10);
-			b[i - 5] = tmp;
-		}
-	}
-
-	move = orgmove;
-	if ((b[i + 4] & WHITE) != 0) {
-		if ((b[i + 8] & FREE) != 0) {
-			move.n++;
-			m = (BLACK | KING);
-			m = m << 8;
-			m += FREE;
-			m = m << 8;
-			m += i + 8;
-			move.m[1] = m;
-			m = FREE;
-			m = m << 8;
-			m += b[i + 4];
-			m = m << 8;
-			m += i + 4;
-			move.m[move.n - 1] = m;
-			found = 1;
-			movelist[*n] = move;
-			tmp = b[i + 4];
-			b[i + 4] = FREE;
-			blackkingcapture(b, n, movelist, i + 8);
-			b[i + 4] = tmp;
-		}
-	}
-
-	move = orgmove;
-	if ((b[i + 5] & WHITE) != 0) {
-		if ((b[i + 10] & FREE) != 0) {
-			move.n++;
-			m = (BLACK | KING);
-			m = m << 8;
-			m += FREE;
-			m = m << 8;
-			m += i + 10;
-			move.m[1] = m;
-			m = FREE;
-			m = m << 8;
-			m += b[i + 5];
-			m = m << 8;
-			m += i + 5;
-			move.m[move.n - 1] = m;
-			found = 1;
-			movelist[*n] = move;
-			tmp = b[i + 5];
-			b[i + 5] = FREE;
-			blackkingcapture(b, n, movelist, i + 10);
-			b[i + 5] = tmp;
-		}
-	}
-
-	if (!found)
-		(*n)++;
-}
-
-void whitemancapture(int b[46], int *n, move2 movelist[MAXMOVES], int i)
-{
-	int m;
-	int found = 0;
-	move2 move, orgmove;
-
-	orgmove = movelist[*n];
-	move = orgmove;
-
-	if ((b[i - 4] & BLACK) != 0) {
-		if ((b[i - 8] & FREE) != 0) {
-			move.n++;
-			if (i <= 17)
-				m = (WHITE | KING);
-			else
-				m = (WHITE | MAN);
-			m = m << 8;
-			m += FREE;
-			m = m << 8;
-			m += i - 8;
-			move.m[1] = m;
-			m = FREE;
-			m = m << 8;
-			m += b[i - 4];
-			m = m << 8;
-			m += i - 4;
-			move.m[move.n - 1] = m;
-			found = 1;
-			movelist[*n] = move;
-			whitemancapture(b, n, movelist, i - 8);
-		}
-	}
-
-	move = orgmove;
-	if ((b[i - 5] & BLACK) != 0) {
-		if ((b[i - 10] & FREE) != 0) {
-			move.n++;
-			if (i <= 17)
-				m = (WHITE | KING);
-			else
-				m = (WHITE | MAN);
-			m = m << 8;
-			m += FREE;
-			m = m << 8;
-			m += i - 10;
-			move.m[1] = m;
-			m = FREE;
-			m = m << 8;
-			m += b[i - 5];
-			m = m << 8;
-			m += i - 5;
-			move.m[move.n - 1] = m;
-			found = 1;
-			movelist[*n] = move;
-			whitemancapture(b, n, movelist, i - 10);
-		}
-	}
-
-	if (!found)
-		(*n)++;
-}
-
-void whitekingcapture(int b[46], int *n, move2 movelist[MAXMOVES], int i)
-{
-	int m;
-	int tmp;
-	int found = 0;
-	move2 move, orgmove;
-
-	orgmove = movelist[*n];
-	move = orgmove;
-
-	if ((b[i - 4] & BLACK) != 0) {
-		if ((b[i - 8] & FREE) != 0) {
-			move.n++;
-			m = (WHITE | KING);
-			m = m << 8;
-			m += FREE;
-			m = m << 8;
-			m += i - 8;
-			move.m[1] = m;
-			m = FREE;
-			m = m << 8;
-			m += b[i - 4];
-			m = m << 8;
-			m += i - 4;
-			move.m[move.n - 1] = m;
-			found = 1;
-			movelist[*n] = move;
-			tmp = b[i - 4];
-			b[i - 4] = FREE;
-			whitekingcapture(b, n, movelist, i - 8);
-			b[i - 4] = tmp;
-		}
-	}
-
-	move = orgmove;
-	if ((b[i - 5] & BLACK) != 0) {
-		if ((b[i - 10] & FREE) != 0) {
-			move.n++;
-			m = (WHITE | KING);
-			m = m << 8;
-			m += FREE;
-			m = m << 8;
-			m += i - 10;
-			move.m[1] = m;
-			m = FREE;
-			m = m << 8;
-			m += b[i - 5];
-			m = m << 8;
-			m += i - 5;
-			move.m[move.n - 1] = m;
-			found = 1;
-			movelist[*n] = move;
-			tmp = b[i - 5];
-			b[i - 5] = FREE;
-			whitekingcapture(b, n, movelist, i - 10);
-			b[i - 5] = tmp;
-		}
-	}
-
-	move = orgmove;
-	if ((b[i + 4] & BLACK) != 0) {
-		if ((b[i + 8] & FREE) != 0) {
-			move.n++;
-			m = (WHITE | KING);
-			m = m << 8;
-			m += FREE;
-			m = m << 8;
-			m += i + 8;
-			move.m[1] = m;
-			m = FREE;
-			m = m << 8;
-			m += b[i + 4];
-			m = m << 8;
-			m += i + 4;
-			move.m[move.n - 1] = m;
-			found = 1;
-			movelist[*n] = move;
-			tmp = b[i + 4];
-			b[i + 4] = FREE;
-			whitekingcapture(b, n, movelist, i + 8);
-			b[i + 4] = tmp;
-		}
-	}
-
-	move = orgmove;
-	if ((b[i + 5] & BLACK) != 0) {
-		if ((b[i + 10] & FREE) != 0) {
-			move.n++;
-			m = (WHITE | KING);
-			m = m << 8;
-			m += FREE;
-			m = m << 8;
-			m += i + 10;
-			move.m[1] = m;
-			m = FREE;
-			m = m << 8;
-			m += b[i + 5];
-			m = m << 8;
-			m += i + 5;
-			move.m[move.n - 1] = m;
-			found = 1;
-			movelist[*n] = move;
-			tmp = b[i + 5];
-			b[i + 5] = FREE;
-			whitekingcapture(b, n, movelist, i + 10);
-			b[i + 5] = tmp;
-		}
-	}
-
-	if (!found)
-		(*n)++;
-}
-
-int testcapture(int b[46], int color)
-/*----------> purpose: test if color has a capture on b
-  ----------> version: 1.0
-  ----------> date: 25th october 97 */
-{
-	int i;
-
-#ifdef STATISTICS
-	testcaptures++;
-#endif
-	if (color == BLACK) {
-		for (i = 5; i <= 40; i++) {
-			if ((b[i] & BLACK) != 0) {
-				if ((b[i] & MAN) != 0) {
-					if ((b[i + 4] & WHITE) != 0) {
-						if ((b[i + 8] & FREE) != 0)
-							return(1);
-					}
-
-					if ((b[i + 5] & WHITE) != 0) {
-						if ((b[i + 10] & FREE) != 0)
-							return(1);
-					}
-				}
-				else {
-
-					/* b[i] is a KING */
-					if ((b[i + 4] & WHITE) != 0) {
-						if ((b[i + 8] & FREE) != 0)
-							return(1);
-					}
-
-					if ((b[i + 5] & WHITE) != 0) {
-						if ((b[i + 10] & FREE) != 0)
-							return(1);
-					}
-
-					if ((b[i - 4] & WHITE) != 0) {
-						if ((b[i - 8] & FREE) != 0)
-							return(1);
-					}
-
-					if ((b[i - 5] & WHITE) != 0) {
-						if ((b[i - 10] & FREE) != 0)
-							return(1);
-					}
-				}
-			}
-		}
-	}
-	else {
-
-		/* color is WHITE */
-		for (i = 5; i <= 40; i++) {
-			if ((b[i] & WHITE) != 0) {
-				if ((b[i] & MAN) != 0) {
-					if ((b[i - 4] & BLACK) != 0) {
-						if ((b[i - 8] & FREE) != 0)
-							return(1);
-					}
-
-					if ((b[i - 5] & BLACK) != 0) {
-						if ((b[i - 10] & FREE) != 0)
-							return(1);
-					}
-				}
-				else {
-
-					/* b[i] is a KING */
-					if ((b[i + 4] & BLACK) != 0) {
-						if ((b[i + 8] & FREE) != 0)
-							return(1);
-					}
-
-					if ((b[i + 5] & BLACK) != 0) {
-						if ((b[i + 10] & FREE) != 0)
-							return(1);
-					}
-
-					if ((b[i - 4] & BLACK) != 0) {
-						if ((b[i - 8] & FREE) != 0)
-							return(1);
-					}
-
-					if ((b[i - 5] & BLACK) != 0) {
-						if ((b[i - 10] & FREE) != 0)
-							return(1);
-					}
-				}
-			}
-		}
-	}
-
-	return(0);
-}
-
+/*______________________________________________________________________________
+
+  ----------> name: simple checkers with enhancements
+  ----------> author: martin fierz
+  ----------> purpose: platform independent checkers engine
+  ----------> date: 22nd september 2002
+  ----------> description: simplech.c contains a simple but fast checkers engine
+  				  and some routines to interface to checkerboard. simplech.c contains five
+              main parts: interface, search, move generation, endgame
+              database and opening book. these parts are separated in the code.
+
+              board representation: the standard checkers notation is
+
+                  (white)
+                32  31  30  29
+              28  27  26  25
+                24  23  22  21
+              20  19  18  17
+                16  15  14  13
+              12  11  10   9
+                 8   7   6   5
+               4   3   2   1
+                  (black)
+
+              the internal representation of the board is different, the
+              search uses four 32-bit bitboards (struct pos: black men, black
+              kings, white men, white kings). bit i of a bitboard stands for
+              the square numbered like this:
+
+                  (white)
+                28  29  30  31
+              24  25  26  27
+                20  21  22  23
+              16  17  18  19
+                12  13  14  15
+               8   9  10  11
+                 4   5   6   7
+               0   1   2   3
+                  (black)
+
+              the original move generator on an array of int with length 46
+              (generatemovelist, generatecapturelist) is still included for
+              other programs, see enginedefs.h.
+
+              let's say, you would like to teach the program that it is
+              important to keep a back rank guard. you can for instance
+              add the following (not very sophisticated) code for this:
+
+              if(p->bm & (1 << 1)) eval++;
+              if(p->bm & (1 << 3)) eval++;
+              if(p->wm & (1 << 28)) eval--;
+              if(p->wm & (1 << 30)) eval--;
+
+              the evaluation function is seen from the point of view of the
+              black player, so you increase the value v if you think the
+              position is good for black.
+
+
+              have fun!
+
+              questions, comments, suggestions to:
+
+              		Martin Fierz
+              		checkers@fierz.ch
+
+*/
+
+
+/*----------> includes */
+// #include <ShlObj.h> // Windows specific - Removed
+// #include <Shlwapi.h> // Windows specific - Removed
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+// #include <windows.h> // Windows specific - Removed
+#include "cb_interface.h"
+#include "enginedefs.h"
+#include "PDNparser.h"
+
+// --- Qt Includes ---
+#include <QStandardPaths>
+#include <QDir>
+#include <QFile>
+#include <QTextStream>
+#include <QDebug>
+#include <QString>
+// --- End Qt Includes ---
+
+
+#define VERSION "1.15"
+
+/* Piece definitions, defined in cb_interface.h  */
+#define WHITE CB_WHITE
+#define BLACK CB_BLACK
+#define MAN CB_MAN
+#define KING CB_KING
+
+#define OCCUPIED 0
+#define FREE 16
+
+#define MAXDEPTH 99
+#define MAX_SEARCHTHREADS 64
+#define MAXPV 16							/* longest principal variation that is kept */
+#define ASPIRATIONWINDOW 25					/* half width of the first aspiration window */
+#define MAXPLY (MAXDEPTH + 32)				/* captures extend the search beyond MAXDEPTH */
+#define MAXGAMEHISTORY 128					/* positions of the game before the root which are kept for repetitions */
+
+/* move ordering */
+#define ORDER_HASHMOVE (1 << 30)
+#define ORDER_KILLER (1 << 29)
+#define MAXHISTORY (1 << 20)				/* history values are halved when one gets this big */
+
+#define DELTAMARGIN 100						/* most the positional terms can make up for in delta pruning */
+
+/* time management */
+#define TIMER_RESOLUTION_MS 1				/* how often the timer looks at playnow */
+#define TIME_OVERHEAD 0.02					/* seconds lost per move outside of the search */
+
+/* hashtable */
+#define HASH_EXACT 0						/* stored score is the true score */
+#define HASH_LOWER 1						/* true score is >= stored score */
+#define HASH_UPPER 2						/* true score is <= stored score */
+#define HASH_NOMOVE 63						/* no best move stored */
+#define DEFAULT_HASHMB 16
+#define MAX_HASHMB 4096
+
+/* proof-number search */
+#define DFPN_MB 64							/* size of the proof table */
+#define DFPN_BUCKET 4						/* entries which share a slot in the proof table */
+#define DFPN_INFINITY 0x0fffffff			/* proof and disproof numbers have 28 bits */
+#define DFPN_MAXPLY 400						/* longer lines are cut off, a disproof which needs them proves nothing */
+#define DFPN_MAXPROOFSIZE 10000000			/* proofs are only counted up to this many positions */
+#define DFPN_WHITEATTACKS 0x9e3779b97f4a7c15ull	/* xor'ed into the keys of proofs of white wins */
+
+/* endgame database */
+#define MAXDBPIECES 6						/* largest number of pieces the builder handles */
+#define DEFAULT_DBMB 64
+#define DBBLOCKSIZE 4096					/* bytes of values which are compressed and cached together */
+#define DBCACHESHARDS 16					/* the cache is split in this many parts with their own lock */
+#define DBNOKEY (~(uint64_t)0)				/* key of an unused cache entry */
+#define DB_UNKNOWN 0						/* database values, for the side to move */
+#define DB_WIN 1
+#define DB_LOSS 2
+#define DB_DRAW 3
+#define DBWIN 4500							/* score of a database win. search wins are 5000 */
+#define DBWINRANGE 400						/* database wins are DBWIN +- this, by evaluation */
+#define MTC_UNKNOWN 255						/* moves to conversion which are not known */
+#define MTCMAXPLIES 254						/* longer conversions are stored as this */
+
+/* opening book */
+#define BOOK_OFF 0							/* book levels, as set by CheckerBoard */
+#define BOOK_ALLKINDS 1
+#define BOOK_GOOD 2
+#define BOOK_BEST 3
+#define BOOKHEADERSIZE 16
+#define BOOKMAXPLY 40						/* moves per game which go into the book */
+#define BOOKMINGAMES 2						/* moves played less often are left out */
+#define BOOKGOODMARGIN 0.1					/* good moves score at most this much less than the best */
+
+/*----------> compile options  */
+#undef MUTE
+#undef VERBOSE
+#define STATISTICS
+#define LOG_TIME_MGMT
+#define DELTAPRUNING						/* skip captures in the quiescence search which cannot reach the window */
+
+/*----------> evaluation terms which only depend on single pieces. they are kept
+              up to date while moves are made in the search, see evalupdate(),
+              so that evaluation() does not have to count them at every leaf. */
+typedef struct {
+	int n[4];					/* number of black men, black kings, white men, white kings */
+	int psq;					/* center and edge terms, from black's point of view */
+	int tempo;					/* sum of the rows of black men minus white men */
+} EVALSTATE;
+
+static const int kcv = 5;		//multiplier for kings in center
+static const int mcv = 1;		//multiplier for men in center
+static const int mev = 1;		//multiplier for men on edge
+static const int kev = 5;		//multiplier for kings on edge
+static const unsigned int edge = 0xf181818f;		/* squares 1-4, 5, 12, 13, 20, 21, 28, 29-32 */
+static const unsigned int center = 0x00666600;	/* squares 10, 11, 14, 15, 18, 19, 22, 23 */
+
+/*----------> search context: everything a search changes while it runs. every
+              call to getmove has its own context, so that several searches
+              on different positions can run in one process at the same time.
+              the hashtable is shared by all of them. */
+typedef struct {
+	std::atomic<int> *play;		/* nonzero: stop searching. set by the search timer */
+	std::chrono::steady_clock::time_point starttime;
+	double absolute_maxtime;	/* the timer stops the search after this many seconds */
+	uint64_t hashkey;			/* key of the position being searched */
+	EVALSTATE eval;				/* of the position being searched */
+	bitmove pv[MAXPV][MAXPV];	/* triangular array, pv[ply] is the principal variation from ply */
+	int pvlength[MAXPV];
+	bitmove killers[MAXPLY][2];	/* the last two moves which caused a cutoff at each ply */
+	int history[2][32][32];		/* [color][from][to]: how often and how deep a move caused cutoffs */
+	uint64_t pathkeys[MAXGAMEHISTORY + MAXPLY];	/* hashkeys of the game history, the root and the search path */
+	int reversible[MAXGAMEHISTORY + MAXPLY];	/* number of reversible moves which led to each of them */
+	int rootindex;				/* the root is pathkeys[rootindex] */
+	int tables;					/* the search may read the database, the conversion tables and the book */
+	int alphabetas;
+#ifdef STATISTICS
+	int generatemovelists, evaluations, generatecapturelists, testcaptures;
+	int cutoffs, firstmovecutoffs;	/* firstmovecutoffs / cutoffs measures the move ordering */
+	int dbhits;
+#endif
+} SearchContext;
+
+/*----------> proof-number search: the state of one df-pn proof */
+typedef struct {
+	SearchContext *ctx;			/* for the position, the stop flag and the node count */
+	int attacker;				/* the color which should be proven to win */
+	uint64_t attackerkey;		/* 0 or DFPN_WHITEATTACKS */
+	double maxtime;				/* the proof is abandoned after this many seconds */
+	int stop;
+	uint64_t path[DFPN_MAXPLY];	/* hashkeys of the positions from the root */
+	bitmove rootmove;			/* the root move which decided the result, if rootmoves is set */
+	int rootmoves;
+} DFPNSEARCH;
+
+/* proof table: the proof and disproof numbers of a position, stored like
+   the hashtable entries. numbers which are not 0 are only estimates which
+   the search refines. */
+typedef struct {
+	uint64_t lock;		/* key ^ data */
+	uint64_t data;		/* bits 0-27: proof number, 28-55: disproof number, 56-63: log2 of the nodes searched */
+} DFPNENTRY;
+
+/*----------> the search timer runs in its own thread while getmove searches. it
+              sets the stop flag of the search when the time is up or when
+              CheckerBoard's playnow becomes nonzero. */
+typedef struct {
+	std::mutex lock;
+	std::condition_variable wakeup;
+	int finished;				/* set when the search has returned */
+	int *playnow;
+	double stoptime;			/* when the stop flag was set, -1 if never */
+} SEARCHTIMER;
+
+/*----------> result of a completed iteration */
+typedef struct {
+	int depth;
+	int eval;
+	bitmove best;
+	int pvlength;
+	bitmove pv[MAXPV];
+} SEARCHRESULT;
+
+/*----------> a root move of the "allscores" analysis mode, with its score from
+              the last completed iteration */
+typedef struct {
+	bitmove move;
+	int eval;
+	int exact;					/* 0: eval is only a bound, the move is worse than the best multipv */
+} ROOTMOVE;
+
+/*----------> result of the deepest completed iteration of any search thread */
+typedef struct {
+	std::mutex lock;
+	SEARCHRESULT result;
+} SHAREDRESULT;
+
+/*----------> function prototypes  */
+
+/*----------> part I: interface to CheckerBoard: CheckerBoard requires that
+							 at getmove and enginename are present in the dll. the
+                      functions help, options and about are optional. if you
+                      do not provide them, CheckerBoard will display a
+                      MessageBox stating that this option is in fact not an option*/
+
+/* required functions */
+// Redefine WINAPI as empty for non-Windows builds
+#ifndef _WIN32
+#define WINAPI
+#endif
+
+int WINAPI getmove
+		(
+			Board8x8 board,
+			int color,
+			double maxtime,
+			char str[255],
+			int *playnow,
+			int info,
+			int unused,
+			CBmove *move
+		);
+
+void movetonotation(bitmove move, char str[80]);
+void pvtonotation(SEARCHRESULT *result, char *str, int maxlength);
+void scorestonotation(ROOTMOVE *moves, int n, int color, char *str, int maxlength);
+
+/*----------> part II: search */
+int checkers(SearchContext *ctx, pos *p, int color, double maxtime, char *str);
+int searchiteration(SearchContext *ctx, pos *p, int depth, int color, SEARCHRESULT *result);
+int multipvsearch(SearchContext *ctx, pos *p, int color, double maxtime, char *str);
+int multipviteration(SearchContext *ctx, pos *p, int depth, int color, ROOTMOVE *moves, int n, int k);
+int alphabeta(SearchContext *ctx, pos *p, int depth, int ply, int alpha, int beta, int color);
+int quiescence(SearchContext *ctx, pos *p, int ply, int alpha, int beta, int color);
+int firstalphabeta(SearchContext *ctx, pos *p, int depth, int alpha, int beta, int color, bitmove *best);
+void helpersearch(SearchContext *ctx, pos position, int color, int threadnumber, SHAREDRESULT *shared);
+void shareresult(SHAREDRESULT *shared, SEARCHRESULT *result);
+double searchtime(SearchContext *ctx);
+void searchtimer(SearchContext *ctx, SEARCHTIMER *timer);
+void allocatetime(int info, int moreinfo, double maxtime, int pieces, double *desired, double *absolute);
+void domove(int b[46], move2 &move);
+void undomove(int b[46], move2 &move);
+int evaluation(SearchContext *ctx, pos *p, int color);
+void evalinit(EVALSTATE *e, pos *p);
+void evalupdate(EVALSTATE *e, pos *p, bitmove &move);
+
+/*----------> part IIb: hashtable */
+void inithashkeys(void);
+int hashtable_resize(int mbytes);
+void hashtable_newsearch(void);
+uint64_t hashposition(pos *p, int color);
+uint64_t hashmove(bitmove &move);
+int hashlookup(uint64_t key, int depth, int alpha, int beta, int *value, int *bestindex);
+void hashstore(uint64_t key, int depth, int value, int bound, int bestindex);
+
+/*----------> part IIc: move ordering */
+void ordermoves(SearchContext *ctx, bitmove movelist[MAXMOVES], int n, int hashindex, int ply, int color, int order[MAXMOVES]);
+void goodmove(SearchContext *ctx, bitmove &move, int depth, int ply, int color, int j);
+void agehistory(SearchContext *ctx);
+
+/*----------> part IId: proof-number search */
+int solve(SearchContext *ctx, pos *p, int color, double maxtime, char *str, int *solved);
+
+/*----------> part IIe: game history */
+int gamehist_set(const char *history);
+void gamehist_newsearch(SearchContext *ctx);
+
+/*----------> part III: move generation */
+int generatemovelist(int b[46], move2 movelist[MAXMOVES], int color);
+int generatecapturelist(int b[46], move2 movelist[MAXMOVES], int color);
+void blackmancapture(int b[46], int *n, move2 movelist[MAXMOVES], int square);
+void blackkingcapture(int b[46], int *n, move2 movelist[MAXMOVES], int square);
+void whitemancapture(int b[46], int *n, move2 movelist[MAXMOVES], int square);
+void whitekingcapture(int b[46], int *n, move2 movelist[MAXMOVES], int square);
+int testcapture(int b[46], int color);
+
+/*----------> part IIIb: bitboard move generation */
+int generatebitmovelist(pos *p, bitmove movelist[MAXMOVES], int color);
+int generatebitcapturelist(pos *p, bitmove movelist[MAXMOVES], int color);
+int testbitcapture(pos *p, int color);
+void dobitmove(pos *p, bitmove &move);
+void undobitmove(pos *p, bitmove &move);
+
+/*----------> part IV: endgame database */
+int db_load(void);
+void db_newsearch(void);
+int db_build(int pieces, char *reply);
+int build_start(int mtc, int pieces, char *reply);
+int dblookup(pos *p, int color, int pieces);
+int dbprobe(SearchContext *ctx, pos *p, int color, int *value);
+int dbcache_stats(uint64_t *hits, uint64_t *misses, uint64_t *evictions);
+int mtc_load(void);
+int mtc_build(int pieces, char *reply);
+int mtclookup(pos *p, int color);
+int mtcprobe(pos *p, int color, bitmove *best, int *plies);
+void mtc_checkdir(const char *path, char *reply);
+
+/*----------> part V: opening book */
+int book_load(void);
+void book_newsearch(void);
+int bookmove(pos *p, int color, bitmove *best, char *str);
+int book_build(const char *pdnfile, char *reply);
+
+/*----------> globals  */
+int value[17] = { 0, 0, 0, 0, 0, 1, 256, 0, 0, 16, 4096, 0, 0, 0, 0, 0, 0 };
+int searchthreads = 1;				/* number of threads used by a search */
+int allscores;						/* set allscores 1: score every root move, see multipvsearch() */
+int multipv;						/* with allscores, exact scores for this many root moves, 0: all */
+
+/* hashtable: the hashkey of the current search position is kept in the search
+   context and updated incrementally with hashmove(). each entry stores the key
+   xor'ed with the data word, so that an entry which was torn by a concurrent
+   write simply fails to match on lookup instead of returning garbage. */
+typedef struct {
+	uint64_t lock;		/* key ^ data */
+	uint64_t data;		/* bits 0-15: score, 16-23: depth, 24-25: bound, 26-31: best move index, 32-39: generation */
+} HASHENTRY;
+
+HASHENTRY *hashtable;
+uint64_t hashmask;					/* number of entries - 1, entries come in buckets of 2 */
+int hashmb;							/* size of the hashtable in MB */
+int hashgeneration;					/* incremented for every call to getmove */
+std::mutex hashmutex;				/* guards allocation of the hashtable */
+std::once_flag hashkeysonce;		/* the zobrist tables are filled once, see inithashkeys() */
+uint64_t zobrist[4][32];			/* random numbers for bm, bk, wm, wk on each square */
+uint64_t zobrist_white;				/* xor'ed in when white is to move */
+
+/* endgame database: win/loss/draw values of all positions with up to
+   dbpieces pieces, black to move, 2 bits per position. positions with white
+   to move are looked up with colors reversed and the board turned around.
+   the positions of one material distribution (nbm, nbk, nwm, nwk) form a
+   slice, see dbindex() for the order of the positions in a slice.
+   the files are memory mapped and their blocks are compressed. the search
+   reads the values through a cache of decompressed blocks. */
+typedef struct {
+	QFile *file;
+	int pieces;
+	const uint32_t *blockoffset;	/* where block i starts in data, nblocks + 1 of them */
+	const unsigned char *data;		/* the compressed blocks */
+} DBFILE;
+
+typedef struct {
+	int n[4];					/* number of black men, black kings, white men, white kings */
+	uint32_t size;				/* number of positions */
+	unsigned char *values;		/* all values, while the database is built. else NULL */
+	DBFILE *file;				/* else the values are in file */
+	uint32_t firstblock;		/* from this block on */
+} DBSLICE;
+
+/* the block cache: least recently used blocks are replaced first. the
+   entries of a shard form a doubly linked list in the order of their use. */
+typedef struct {
+	uint64_t key;				/* number of pieces << 32 | block number */
+	int prev, next;
+	unsigned char *data;		/* DBBLOCKSIZE bytes */
+} DBCACHEENTRY;
+
+typedef struct {
+	std::mutex lock;
+	std::unordered_map<uint64_t, int> index;	/* key -> entry */
+	std::vector<DBCACHEENTRY> entries;
+	std::vector<unsigned char> memory;
+	int head, tail;				/* most and least recently used entry */
+	uint64_t hits, misses, evictions;
+} DBCACHESHARD;
+
+DFPNENTRY *dfpntable;
+uint64_t dfpnmask;
+std::mutex dfpnmutex;				/* guards allocation of the proof table */
+int solvemode;						/* set solve 1: prove the result instead of searching */
+
+DBSLICE *dbslice[MAXDBPIECES + 1][MAXDBPIECES + 1][MAXDBPIECES + 1][MAXDBPIECES + 1];
+DBFILE dbfile[MAXDBPIECES + 1];
+DBCACHESHARD dbcache[DBCACHESHARDS];
+int dbcacheshards;					/* shards in use, fewer if the cache has less blocks */
+int dbpieces;						/* all slices with up to this many pieces are loaded */
+int dbprobepieces;					/* the search probes positions with up to this many pieces, 0: off */
+int dbdirty = 1;					/* the database settings changed, reload before the next search */
+char dbpath[256] = ".";				/* directory of the database files */
+int dbmbytes = DEFAULT_DBMB;		/* size of the block cache */
+int enable_wld = 1;
+int max_dbpieces = MAXDBPIECES;
+std::mutex dbmutex;					/* guards the database settings above */
+std::shared_mutex dbtables;			/* searches hold it shared while they read the database, the
+									   conversion tables or the book. these are only loaded, built
+									   and freed while it is held exclusively. */
+uint32_t binomial[33][33];
+
+/* builddb and buildmtc run on their own thread, so that enginecommand returns
+   at once. buildstatus is the progress of the running build or the result of
+   the last one, buildcancel stops the running one after the current slice. */
+std::mutex buildmutex;				/* guards buildstatus, buildrunning and builder */
+char buildstatus[256] = "no build was started";
+int buildrunning;
+std::atomic<int> buildcancel;
+struct BUILDTHREAD {
+	std::thread thread;
+	~BUILDTHREAD()
+	{
+		/* the engine is unloaded: stop the build before the tables go away */
+		buildcancel.store(1, std::memory_order_relaxed);
+		if (thread.joinable())
+			thread.join();
+	}
+} builder;
+
+/* moves to conversion: for the won and lost positions of the database, the
+   number of plies until a capture or a man move, if the winning side
+   converts as fast as possible and the losing side holds out as long as
+   possible. one byte per
+   position, black to move, in the same order as the database values. the
+   files are memory mapped as they are, the values of a slice point there. */
+DBSLICE *mtcslice[MAXDBPIECES + 1][MAXDBPIECES + 1][MAXDBPIECES + 1][MAXDBPIECES + 1];
+QFile *mtcfile[MAXDBPIECES + 1];
+int mtcpieces;						/* the tables with up to this many pieces are loaded */
+int mtcdirty = 1;					/* the settings changed, reload before the next search */
+char mtcpath[256] = ".";			/* directory of the table files */
+int enable_mtc = 1;
+
+/* opening book: for every position in it, one entry per move which was played
+   there, sorted by the hashkey of the position and the move. the file is
+   a header of BOOKHEADERSIZE bytes, "SCBOOK1" and a 0 byte and the number of
+   entries (4 bytes), followed by the entries as they are in memory. it is
+   memory mapped and searched where it is. */
+typedef struct {
+	uint64_t key;				/* hashposition() of the position */
+	uint32_t wins, losses, draws;	/* results of the games for the side which played the move */
+	uint16_t weight;			/* number of games in which the move was played */
+	uint8_t from, to;			/* squares of the move, like in bitmove */
+} BOOKENTRY;
+
+const BOOKENTRY *book;				/* the entries in the mapped file, or NULL */
+uint32_t bookentries;
+QFile *bookqfile;
+char bookfile[256] = "simplech.book";
+int booklevel = BOOK_GOOD;
+int bookdirty = 1;					/* the book file changed, reload before the next search */
+std::mutex bookmutex;				/* guards bookfile */
+
+/* game history from "set gamehist": the hashkeys of the positions since the
+   last irreversible move, the last one is the position of the next getmove.
+   all moves between them are reversible, non-capture king moves. */
+uint64_t gamehistory[MAXGAMEHISTORY + 1];
+int gamehistorylength;
+std::mutex gamehistmutex;			/* guards gamehistory */
+
+/*----------> bitboard helpers  */
+static inline int squarenumber(int square)
+{
+	/* bit square as a square number in standard notation */
+	return(4 * (square / 4) + 4 - (square % 4));
+}
+
+static inline int bitsquare(int number)
+{
+	/* square number in standard notation as a bit square */
+	return(4 * ((number - 1) / 4) + 3 - ((number - 1) % 4));
+}
+
+static inline int bitcount(unsigned int x)
+{
+	/* number of bits set in x */
+#if defined(__GNUC__) || defined(__clang__)
+	return(__builtin_popcount(x));
+#else
+	int n = 0;
+
+	while (x) {
+		x &= x - 1;
+		n++;
+	}
+	return(n);
+#endif
+}
+
+static inline int lsb(unsigned int x)
+{
+	/* index of the lowest bit set in x, x must not be 0 */
+#if defined(__GNUC__) || defined(__clang__)
+	return(__builtin_ctz(x));
+#else
+	int i = 0;
+
+	while (!(x & 1)) {
+		x >>= 1;
+		i++;
+	}
+	return(i);
+#endif
+}
+
+static inline uint64_t hashbits(const uint64_t keys[32], unsigned int x)
+{
+	/* xor of the zobrist keys of all bits set in x */
+	uint64_t key = 0;
+
+	while (x) {
+		key ^= keys[lsb(x)];
+		x &= x - 1;
+	}
+	return(key);
+}
+
+#ifdef LOG_TIME_MGMT
+QString logfilename; // Use QString for path
+std::mutex logmutex; // searches running in parallel share the log file
+
+void init_logfile()
+{
+	// Use Qt to get Documents path and create directories/file
+    QString documentsPath = QStandardPaths::writableLocation(QStandardPaths::DocumentsLocation);
+    if (documentsPath.isEmpty()) {
+        qWarning() << "Could not find Documents directory.";
+        return; // Or fallback to current dir
+    }
+
+    QDir dir(documentsPath);
+    if (!dir.mkpath("Martin Fierz/Simplech")) {
+        qWarning() << "Could not create directories: Martin Fierz/Simplech in" << documentsPath;
+        // Fallback maybe?
+        logfilename = QDir::currentPath() + "/Simplech.log";
+    } else {
+         logfilename = dir.filePath("Martin Fierz/Simplech/Simplech.log");
+    }
+
+    // Create/clear the log file
+    QFile logFile(logfilename);
+    if (!logFile.open(QIODevice::WriteOnly | QIODevice::Text | QIODevice::Truncate)) {
+        qWarning() << "Could not open log file for writing:" << logfilename << logFile.errorString();
+    } else {
+        logFile.close(); // Just ensure it's created/cleared
+        qDebug() << "Log file initialized at:" << logfilename;
+    }
+}
+
+void log(const char *fmt, ...)
+{
+	std::lock_guard<std::mutex> lock(logmutex);
+
+	// Use Qt file handling
+    if (logfilename.isEmpty()) return; // Don't log if init failed
+
+    va_list args;
+    va_start(args, fmt);
+    QString message = QString::vasprintf(fmt, args);
+    va_end(args);
+
+    if (message.isNull()) return; // vasprintf can fail
+
+    QFile logFile(logfilename);
+    if (!logFile.open(QIODevice::Append | QIODevice::Text)) {
+        // Log failure to debug console, avoid infinite loop
+        qDebug() << "Failed to open log file for appending:" << logfilename << logFile.errorString();
+        return;
+    }
+
+    QTextStream out(&logFile);
+    out << message;
+    logFile.close();
+}
+#endif
+
+/*-------------- PART 1: dll stuff -------------------------------------------*/
+// Removed DllMain as it's Windows specific
+// For shared libraries on Linux/macOS, initialization/cleanup can be done
+// using constructor/destructor functions if needed, but often not necessary.
+
+static int pathparameter(const char *str, const char *param, char *path, int size)
+{
+	/* the path may contain blanks, it is the rest of the command after param */
+	const char *start = strstr(str, param) + strlen(param);
+	int n;
+
+	while (*start == ' ')
+		start++;
+	n = (int)strlen(start);
+	while (n > 0 && (start[n - 1] == ' ' || start[n - 1] == '\n' || start[n - 1] == '\r'))
+		n--;
+	if (n == 0 || n >= size)
+		return(0);
+	memcpy(path, start, n);
+	path[n] = 0;
+	return(1);
+}
+
+int WINAPI enginecommand(const char *str, char reply[256])
+{
+	// answer to commands sent by CheckerBoard.
+	// Simple Checkers does not answer to some of the commands,
+	// eg it has no engine options.
+	char command[256], param1[256], param2[256];
+
+	// Use sscanf_s on Windows, or standard sscanf otherwise
+    #ifdef _WIN32
+        sscanf_s(str, "%s %s %s", command, sizeof(command), param1, sizeof(param1), param2, sizeof(param2));
+    #else
+        sscanf(str, "%s %s %s", command, param1, param2);
+    #endif
+
+
+	// check for command keywords
+	if (strcmp(command, "name") == 0) {
+		sprintf(reply, "Simple Checkers %s", VERSION);
+		return 1;
+	}
+
+	if (strcmp(command, "about") == 0) {
+		sprintf(reply, "Simple Checkers %s\n\n2002 by Martin Fierz", VERSION);
+		return 1;
+	}
+
+	if (strcmp(command, "help") == 0) {
+		// Provide a relative path, assume help file is alongside engine library
+        // Or CheckerBoard needs to handle finding it based on engine location
+		sprintf(reply, "simplechhelp.htm");
+		return 1;
+	}
+
+	if (strcmp(command, "set") == 0) {
+		if (strcmp(param1, "hashsize") == 0) {
+			int mbytes = atoi(param2);
+
+			if (mbytes < 1 || hashtable_resize(mbytes) == 0) {
+				sprintf(reply, "?");
+				return 0;
+			}
+			sprintf(reply, "hashsize %i", hashmb);
+			return 1;
+		}
+
+		if (strcmp(param1, "searchthreads") == 0) {
+			int threads = atoi(param2);
+
+			if (threads < 1)
+				threads = 1;
+			if (threads > MAX_SEARCHTHREADS)
+				threads = MAX_SEARCHTHREADS;
+			searchthreads = threads;
+			sprintf(reply, "searchthreads %i", searchthreads);
+			return 1;
+		}
+
+		if (strcmp(param1, "allscores") == 0) {
+			allscores = atoi(param2) != 0;
+			sprintf(reply, "allscores %i", allscores);
+			return 1;
+		}
+
+		if (strcmp(param1, "multipv") == 0) {
+			int k = atoi(param2);
+
+			if (k < 0) {
+				sprintf(reply, "?");
+				return 0;
+			}
+			multipv = k;
+			sprintf(reply, "multipv %i", multipv);
+			return 1;
+		}
+
+		if (strcmp(param1, "book") == 0) {
+			int level = atoi(param2);
+
+			if (level < BOOK_OFF || level > BOOK_BEST) {
+				sprintf(reply, "?");
+				return 0;
+			}
+			booklevel = level;
+			sprintf(reply, "book %i", booklevel);
+			return 1;
+		}
+
+		if (strcmp(param1, "bookfile") == 0) {
+			std::lock_guard<std::mutex> lock(bookmutex);
+
+			if (!pathparameter(str, "bookfile", bookfile, sizeof(bookfile))) {
+				sprintf(reply, "?");
+				return 0;
+			}
+			bookdirty = 1;
+			sprintf(reply, "bookfile %s", bookfile);
+			return 1;
+		}
+
+		if (strcmp(param1, "gamehist") == 0) {
+			/* the rest of the command is a FEN and the moves played since */
+			char history[1024];
+
+			if (!pathparameter(str, "gamehist", history, sizeof(history)) || !gamehist_set(history)) {
+				sprintf(reply, "?");
+				return 0;
+			}
+			sprintf(reply, "gamehist %i", gamehistorylength - 1);
+			return 1;
+		}
+
+		if (strcmp(param1, "solve") == 0) {
+			solvemode = atoi(param2) != 0;
+			sprintf(reply, "solve %i", solvemode);
+			return 1;
+		}
+
+		if (strcmp(param1, "dbpath") == 0) {
+			std::lock_guard<std::mutex> lock(dbmutex);
+
+			if (!pathparameter(str, "dbpath", dbpath, sizeof(dbpath))) {
+				sprintf(reply, "?");
+				return 0;
+			}
+			dbdirty = 1;
+			sprintf(reply, "dbpath %s", dbpath);
+			return 1;
+		}
+
+		if (strcmp(param1, "mtcpath") == 0) {
+			std::lock_guard<std::mutex> lock(dbmutex);
+
+			if (!pathparameter(str, "mtcpath", mtcpath, sizeof(mtcpath))) {
+				sprintf(reply, "?");
+				return 0;
+			}
+			mtcdirty = 1;
+			sprintf(reply, "mtcpath %s", mtcpath);
+			return 1;
+		}
+
+		if (strcmp(param1, "check_mtc_dir") == 0) {
+			char path[256];
+
+			if (!pathparameter(str, "check_mtc_dir", path, sizeof(path))) {
+				sprintf(reply, "?");
+				return 0;
+			}
+			mtc_checkdir(path, reply);
+			return 1;
+		}
+
+		if (strcmp(param1, "dbmbytes") == 0) {
+			int mbytes = atoi(param2);
+
+			if (mbytes < 0) {
+				sprintf(reply, "?");
+				return 0;
+			}
+			std::lock_guard<std::mutex> lock(dbmutex);
+			dbmbytes = mbytes;
+			dbdirty = 1;
+			/* CheckerBoard shows a nonempty reply to this command */
+			reply[0] = 0;
+			return 1;
+		}
+
+		if (strcmp(param1, "enable_wld") == 0) {
+			std::lock_guard<std::mutex> lock(dbmutex);
+			enable_wld = atoi(param2) != 0;
+			dbdirty = 1;
+			sprintf(reply, "enable_wld %i", enable_wld);
+			return 1;
+		}
+
+		if (strcmp(param1, "enable_mtc") == 0) {
+			std::lock_guard<std::mutex> lock(dbmutex);
+			enable_mtc = atoi(param2) != 0;
+			mtcdirty = 1;
+			sprintf(reply, "enable_mtc %i", enable_mtc);
+			return 1;
+		}
+
+		if (strcmp(param1, "max_dbpieces") == 0) {
+			int pieces = atoi(param2);
+
+			if (pieces < 0) {
+				sprintf(reply, "?");
+				return 0;
+			}
+			std::lock_guard<std::mutex> lock(dbmutex);
+			max_dbpieces = pieces;
+			dbdirty = 1;
+			mtcdirty = 1;
+			sprintf(reply, "max_dbpieces %i", max_dbpieces);
+			return 1;
+		}
+	}
+
+	if (strcmp(command, "builddb") == 0) {
+		/* builddb n: build the databases with up to n pieces in dbpath */
+		int pieces = atoi(param1);
+
+		if (pieces < 2 || pieces > MAXDBPIECES) {
+			sprintf(reply, "builddb: number of pieces must be 2 to %i", MAXDBPIECES);
+			return 0;
+		}
+		return(build_start(0, pieces, reply));
+	}
+
+	if (strcmp(command, "buildmtc") == 0) {
+		/* buildmtc n: build the moves to conversion tables with up to n
+		   pieces in mtcpath, from the database in dbpath */
+		int pieces = atoi(param1);
+
+		if (pieces < 2 || pieces > MAXDBPIECES) {
+			sprintf(reply, "buildmtc: number of pieces must be 2 to %i", MAXDBPIECES);
+			return 0;
+		}
+		return(build_start(1, pieces, reply));
+	}
+
+	if (strcmp(command, "buildcancel") == 0) {
+		std::lock_guard<std::mutex> lock(buildmutex);
+
+		if (!buildrunning) {
+			sprintf(reply, "no build is running");
+			return 0;
+		}
+		buildcancel.store(1, std::memory_order_relaxed);
+		sprintf(reply, "cancelling the build");
+		return 1;
+	}
+
+	if (strcmp(command, "buildbook") == 0) {
+		/* buildbook file: build the book in bookfile from the games in the
+		   PDN file, whose name is the rest of the command */
+		char pdnfile[256];
+
+		if (!pathparameter(str, "buildbook", pdnfile, sizeof(pdnfile))) {
+			sprintf(reply, "buildbook: no PDN file");
+			return 0;
+		}
+		return(book_build(pdnfile, reply));
+	}
+
+	if (strcmp(command, "get") == 0) {
+		if (strcmp(param1, "hashsize") == 0) {
+			if (hashtable == NULL)
+				hashtable_resize(DEFAULT_HASHMB);
+			sprintf(reply, "%i", hashmb);
+			return 1;
+		}
+
+		if (strcmp(param1, "searchthreads") == 0) {
+			sprintf(reply, "%i", searchthreads);
+			return 1;
+		}
+
+		if (strcmp(param1, "cpus") == 0) {
+			sprintf(reply, "%u", std::thread::hardware_concurrency());
+			return 1;
+		}
+
+		if (strcmp(param1, "allscores") == 0) {
+			sprintf(reply, "%i", allscores);
+			return 1;
+		}
+
+		if (strcmp(param1, "multipv") == 0) {
+			sprintf(reply, "%i", multipv);
+			return 1;
+		}
+
+		if (strcmp(param1, "book") == 0) {
+			sprintf(reply, "%i", booklevel);
+			return 1;
+		}
+
+		if (strcmp(param1, "bookfile") == 0) {
+			std::lock_guard<std::mutex> lock(bookmutex);
+			sprintf(reply, "%s", bookfile);
+			return 1;
+		}
+
+		if (strcmp(param1, "solve") == 0) {
+			sprintf(reply, "%i", solvemode);
+			return 1;
+		}
+
+		if (strcmp(param1, "dbpath") == 0) {
+			std::lock_guard<std::mutex> lock(dbmutex);
+			sprintf(reply, "%s", dbpath);
+			return 1;
+		}
+
+		if (strcmp(param1, "dbmbytes") == 0) {
+			sprintf(reply, "%i", dbmbytes);
+			return 1;
+		}
+
+		if (strcmp(param1, "enable_wld") == 0) {
+			sprintf(reply, "%i", enable_wld);
+			return 1;
+		}
+
+		if (strcmp(param1, "mtcpath") == 0) {
+			std::lock_guard<std::mutex> lock(dbmutex);
+			sprintf(reply, "%s", mtcpath);
+			return 1;
+		}
+
+		if (strcmp(param1, "enable_mtc") == 0) {
+			sprintf(reply, "%i", enable_mtc);
+			return 1;
+		}
+
+		if (strcmp(param1, "max_dbpieces") == 0) {
+			sprintf(reply, "%i", max_dbpieces);
+			return 1;
+		}
+
+		if (strcmp(param1, "buildstatus") == 0) {
+			std::lock_guard<std::mutex> lock(buildmutex);
+			sprintf(reply, "%s", buildstatus);
+			return 1;
+		}
+
+		if (strcmp(param1, "dbstats") == 0) {
+			uint64_t hits, misses, evictions;
+
+			if (!dbcache_stats(&hits, &misses, &evictions)) {
+				sprintf(reply, "the database is being loaded or built");
+				return 1;
+			}
+			sprintf(reply, "hits %llu, misses %llu, evictions %llu",
+					(unsigned long long)hits, (unsigned long long)misses, (unsigned long long)evictions);
+			return 1;
+		}
+
+		if (strcmp(param1, "protocolversion") == 0) {
+			sprintf(reply, "2");
+			return 1;
+		}
+
+		if (strcmp(param1, "gametype") == 0) {
+			sprintf(reply, "21");
+			return 1;
+		}
+	}
+
+	sprintf(reply, "?");
+	return 0;
+}
+
+int WINAPI getmove
+		(
+			Board8x8 b,
+			int color,
+			double maxtime,
+			char str[255],
+			int *playnow,
+			int info,
+			int moreinfo,
+			CBmove *move // Note: move is unused in simplech for returning the move
+		)
+{
+	/* getmove is what checkerboard calls. you get 6 parameters:
+   b	 	is the current position. the values in the array are determined by
+   			the #defined values of CB_BLACK, CB_WHITE, CB_KING, CB_MAN. a black king for
+            instance is represented by CB_BLACK|CB_KING.
+   color		is the side to make a move. CB_BLACK or CB_WHITE.
+   maxtime	is the time your program should use to make a move. this is
+   		   what you specify as level in checkerboard. so if you exceed
+            this time it's not too bad - just don't exceed it too much...
+   str		is a pointer to the output string of the checkerboard status bar.
+   			you can use sprintf(str,"information"); to print any information you
+            want into the status bar.
+   *playnow	is a pointer to the playnow variable of checkerboard. if the user
+   			would like your engine to play immediately, this value is nonzero,
+            else zero. you should respond to a nonzero value of *playnow by
+            interrupting your search IMMEDIATELY.
+   CBmove *move
+   			is unused here. this parameter would allow engines playing different
+            versions of checkers to return a move to CB. for engines playing
+            english checkers this is not necessary.
+            */
+	int i, x, y;
+	int value;
+	int solved;
+	std::atomic<int> stop;
+	double desired, new_iter_maxtime;
+	pos position;
+	SearchContext ctx;
+	SEARCHTIMER timer;
+	std::thread timerthread;
+
+#ifdef LOG_TIME_MGMT
+    // Ensure log file is initialized on first call or if needed
+    {
+        std::lock_guard<std::mutex> lock(logmutex);
+        if (logfilename.isEmpty()) {
+            init_logfile();
+        }
+    }
+#endif
+
+
+	/* initialize bitboards: bit i is on row i / 4 of the 8x8 board
+	   (seen from black), on every second column starting at column 0
+	   for even rows and at column 1 for odd rows. */
+	position.bm = 0;
+	position.bk = 0;
+	position.wm = 0;
+	position.wk = 0;
+	for (i = 0; i < 32; i++) {
+		y = i / 4;
+		x = 2 * (i % 4) + (y & 1);
+		switch (b[x][y]) {
+		case BLACK | MAN:
+			position.bm |= 1u << i;
+			break;
+
+		case BLACK | KING:
+			position.bk |= 1u << i;
+			break;
+
+		case WHITE | MAN:
+			position.wm |= 1u << i;
+			break;
+
+		case WHITE | KING:
+			position.wk |= 1u << i;
+			break;
+		}
+	}
+
+	ctx = SearchContext();
+	stop.store(0, std::memory_order_relaxed);
+	ctx.play = &stop;
+
+	hashtable_newsearch();
+	db_newsearch();
+	book_newsearch();
+
+	/* while a database or a book is being built, search without them */
+	std::shared_lock<std::shared_mutex> tables(dbtables, std::try_to_lock);
+	ctx.tables = tables.owns_lock();
+	ctx.hashkey = hashposition(&position, color);
+	evalinit(&ctx.eval, &position);
+	gamehist_newsearch(&ctx);
+
+	ctx.starttime = std::chrono::steady_clock::now();
+	allocatetime(info, moreinfo, maxtime,
+				 bitcount(position.bm | position.bk | position.wm | position.wk),
+				 &desired, &ctx.absolute_maxtime);
+
+	/* no new iteration is started after new_iter_maxtime. with fixed time per
+	   move this results in an average search time of desired. */
+	new_iter_maxtime = 0.59 * desired;
+	if (info & CB_EXACT_TIME)
+		new_iter_maxtime = desired;
+
+	timer.finished = 0;
+	timer.playnow = playnow;
+	timer.stoptime = -1;
+	timerthread = std::thread(searchtimer, &ctx, &timer);
+
+	solved = 0;
+	if (solvemode)
+		value = solve(&ctx, &position, color, new_iter_maxtime, str, &solved);
+	else
+		value = checkers(&ctx, &position, color, new_iter_maxtime, str);
+
+	{
+		std::lock_guard<std::mutex> lock(timer.lock);
+		timer.finished = 1;
+	}
+	timer.wakeup.notify_one();
+	timerthread.join();
+
+#ifdef LOG_TIME_MGMT
+	{
+		double elapsed = searchtime(&ctx);
+		double increment, remaining;
+
+		if (get_incremental_times(info, moreinfo, &increment, &remaining))
+			log("incr %.3f, remaining %.3f, abs maxt %.3f, desired %.3f, new iter maxt %.3f, actual %.3f, margin %.3f %s\n",
+				increment, remaining, ctx.absolute_maxtime, desired, new_iter_maxtime,
+				elapsed, remaining - elapsed,
+				remaining - elapsed < 0 ? "***" : "");
+		if (timer.stoptime >= 0)
+			log("stopped at %.3f, returned at %.3f, abort latency %.1f ms\n",
+				timer.stoptime, elapsed, 1000 * (elapsed - timer.stoptime));
+	}
+#endif
+	/* return the board */
+	for (i = 0; i < 32; i++) {
+		y = i / 4;
+		x = 2 * (i % 4) + (y & 1);
+		b[x][y] = 0;
+		if (position.bm & (1u << i))
+			b[x][y] = BLACK | MAN;
+		if (position.bk & (1u << i))
+			b[x][y] = BLACK | KING;
+		if (position.wm & (1u << i))
+			b[x][y] = WHITE | MAN;
+		if (position.wk & (1u << i))
+			b[x][y] = WHITE | KING;
+	}
+	if (solved && value == 0)
+		return CB_DRAW;
+
+	if (color == BLACK) {
+		if (value > 4000)
+			return CB_WIN;
+		if (value < -4000)
+			return CB_LOSS;
+	}
+
+	if (color == WHITE) {
+		if (value > 4000)
+			return CB_LOSS;
+		if (value < -4000)
+			return CB_WIN;
+	}
+
+	return CB_UNKNOWN;
+}
+
+void movetonotation(bitmove move, char str[80])
+{
+	int from, to;
+	char c;
+
+	/* bit i is square 4 * (i / 4) + 4 - (i % 4) in standard notation */
+	from = 4 * (move.from / 4) + 4 - (move.from % 4);
+	to = 4 * (move.to / 4) + 4 - (move.to % 4);
+	/* a capture changes the bitboards of both sides, except for a king
+	   capturing its way back to its from square. */
+	c = '-';
+	if (((move.bm | move.bk) && (move.wm | move.wk)) || from == to)
+		c = 'x';
+	sprintf(str, "%2i%c%2i", from, c, to); // Was %2li, changed to %2i for int
+}
+
+void pvtonotation(SEARCHRESULT *result, char *str, int maxlength)
+{
+	/* write the principal variation of result to str, as many moves as fit
+	   into maxlength characters including the terminating 0 */
+	int i, n;
+	char move[80];
+
+	n = 0;
+	str[0] = 0;
+	for (i = 0; i < result->pvlength; i++) {
+		movetonotation(result->pv[i], move);
+		if (n + (int)strlen(move) + 2 > maxlength)
+			break;
+		n += sprintf(str + n, "%s%s", i ? " " : "", move);
+	}
+}
+
+void scorestonotation(ROOTMOVE *moves, int n, int color, char *str, int maxlength)
+{
+	/* write the root moves and their scores to str, "11-15 12, 9-13 5, ...".
+	   a score which is only a bound gets a "<" or ">" for black's point of
+	   view, as many moves as fit into maxlength characters. */
+	int i, length;
+	char move[80], entry[100];
+
+	length = 0;
+	str[0] = 0;
+	for (i = 0; i < n; i++) {
+		movetonotation(moves[i].move, move);
+		sprintf(entry, "%s%s %s%i", i ? ", " : "", move,
+				moves[i].exact ? "" : (color == BLACK ? "<" : ">"), moves[i].eval);
+		if (length + (int)strlen(entry) + 1 > maxlength)
+			break;
+		strcpy(str + length, entry);
+		length += (int)strlen(entry);
+	}
+}
+
+/*-------------- PART II: SEARCH ---------------------------------------------*/
+static inline int pvsearch(SearchContext *ctx, pos *p, int depth, int ply, int alpha, int beta, int color, int first)
+{
+	/* principal variation search of the position after a move of the side
+	   which is not color. the first move is searched with the full window,
+	   the others with a zero window which only proves that they are not
+	   better; if that fails they are searched again with the full window. */
+	int value;
+
+	if (first)
+		return(alphabeta(ctx, p, depth, ply, alpha, beta, color));
+
+	if (color == WHITE) {
+		/* black moved, black wants a value > alpha */
+		value = alphabeta(ctx, p, depth, ply, alpha, alpha + 1, color);
+		if (value > alpha && value < beta)
+			value = alphabeta(ctx, p, depth, ply, alpha, beta, color);
+	}
+	else {
+		/* white moved, white wants a value < beta */
+		value = alphabeta(ctx, p, depth, ply, beta - 1, beta, color);
+		if (value < beta && value > alpha)
+			value = alphabeta(ctx, p, depth, ply, alpha, beta, color);
+	}
+	return(value);
+}
+
+static inline void updatepv(SearchContext *ctx, int ply, bitmove &move)
+{
+	/* move is the new best move at ply: the pv from ply is move followed by
+	   the pv of the position after it */
+	int n;
+
+	if (ply >= MAXPV)
+		return;
+	ctx->pv[ply][0] = move;
+	n = 0;
+	if (ply + 1 < MAXPV)
+		n = std::min(ctx->pvlength[ply + 1], MAXPV - 1);
+	memcpy(&ctx->pv[ply][1], ctx->pv[ply + 1], n * sizeof(bitmove));
+	ctx->pvlength[ply] = n + 1;
+}
+
+static inline void pathpush(SearchContext *ctx, int ply, bitmove &move)
+{
+	/* record the position after move, at ply, for the repetition test. a
+	   move is reversible if it is a king move which captures nothing */
+	int n = ctx->rootindex + ply;
+
+	if (n >= MAXGAMEHISTORY + MAXPLY)
+		return;
+	ctx->pathkeys[n] = ctx->hashkey;
+	if ((move.bm | move.wm) == 0 && !(move.bk && move.wk))
+		ctx->reversible[n] = ctx->reversible[n - 1] + 1;
+	else
+		ctx->reversible[n] = 0;
+}
+
+static inline int repetition(SearchContext *ctx, int ply)
+{
+	/* is the position at ply a repetition of a position in the game or on
+	   the search path? only positions since the last irreversible move, with
+	   the same side to move, can be the same. */
+	int i, n = ctx->rootindex + ply;
+
+	if (n >= MAXGAMEHISTORY + MAXPLY)
+		return(0);
+	for (i = n - 4; i >= n - ctx->reversible[n]; i -= 2) {
+		if (ctx->pathkeys[i] == ctx->pathkeys[n])
+			return(1);
+	}
+	return(0);
+}
+
+int checkers(SearchContext *ctx, pos *p, int color, double maxtime, char *str)
+/*----------> purpose: entry point to checkers. find a move on position p for color
+  ---------->          in the time specified by maxtime, write the best move in
+  ---------->          board, returns information on the search in str
+  ---------->          with searchthreads > 1, helper threads search the same
+  ---------->          position and share the hashtable with this thread.
+  ----------> returns the value of the position, 0 if there is no legal
+  ----------> move in this position.
+  ----------> version: 1.5
+  ----------> date: 17th october 2026 */
+{
+	int i, k, numberofmoves;
+	int nhelpers;
+	std::atomic<int> helperstop;
+	bitmove movelist[MAXMOVES];
+	char str2[255];
+	SEARCHRESULT result;
+	SHAREDRESULT shared;
+	std::vector<SearchContext> helperctx;
+	std::vector<std::thread> helpers;
+
+	/*--------> check if there is only one move */
+	numberofmoves = generatebitcapturelist(p, movelist, color);
+	if (numberofmoves == 1) {
+		dobitmove(p, movelist[0]);
+		sprintf(str, "forced capture");
+		return(1);
+	}
+	else if (numberofmoves == 0) {
+		numberofmoves = generatebitmovelist(p, movelist, color);
+		if (numberofmoves == 1) {
+			dobitmove(p, movelist[0]);
+			sprintf(str, "only move");
+			return(1);
+		}
+
+		if (numberofmoves == 0) {
+			sprintf(str, "no legal moves in this position");
+			return(0);
+		}
+	}
+
+	/*--------> in the opening, play a book move without searching. analysis
+	  --------> with allscores wants a score for every move, not one move */
+	if (ctx->tables && !allscores && bookmove(p, color, &result.best, str)) {
+		dobitmove(p, result.best);
+		return(0);
+	}
+
+	/*--------> in a won endgame, play for the fastest conversion instead of
+	  --------> shuffling kings until the search sees one */
+	if (ctx->tables && !allscores && mtcprobe(p, color, &result.best, &k)) {
+		movetonotation(result.best, str2);
+		sprintf(str, "best:%s  database win, conversion in %i plies", str2, k);
+		dobitmove(p, result.best);
+		return(color == BLACK ? DBWIN : -DBWIN);
+	}
+
+	/*--------> analysis: a score for every root move instead of one best move */
+	if (allscores)
+		return(multipvsearch(ctx, p, color, maxtime, str));
+
+	result.depth = 0;
+	result.eval = 0;
+	result.best = movelist[0];
+	result.pvlength = 0;
+	searchiteration(ctx, p, 1, color, &result);
+
+	/*--------> start the helper threads. each gets a copy of the search context
+	  --------> and of the position; they are stopped with helperstop. */
+	shared.result = result;
+	helperstop.store(0, std::memory_order_relaxed);
+	nhelpers = searchthreads - 1;
+	if (result.eval == 5000 || result.eval == -5000)
+		nhelpers = 0;
+	helperctx.assign(nhelpers, *ctx);
+	for (k = 0; k < nhelpers; k++) {
+		helperctx[k].play = &helperstop;
+		helperctx[k].alphabetas = 0;
+#ifdef STATISTICS
+		helperctx[k].generatemovelists = 0;
+		helperctx[k].generatecapturelists = 0;
+		helperctx[k].evaluations = 0;
+		helperctx[k].testcaptures = 0;
+		helperctx[k].cutoffs = 0;
+		helperctx[k].firstmovecutoffs = 0;
+		helperctx[k].dbhits = 0;
+#endif
+		try {
+			helpers.emplace_back(helpersearch, &helperctx[k], *p, color, k + 1, &shared);
+		}
+		catch (...) {
+			/* could not create another thread, search with fewer */
+			break;
+		}
+	}
+
+	for (i = 2; (i <= MAXDEPTH) && (searchtime(ctx) < maxtime); i++) {
+		if (!searchiteration(ctx, p, i, color, &result))
+			break;
+
+		/*--------> take over the result of a helper which got deeper, and
+		  --------> continue from there. */
+		if (!helpers.empty()) {
+			shareresult(&shared, &result);
+			i = result.depth;
+		}
+		movetonotation(result.best, str2);
+#ifndef MUTE
+		sprintf(str, "best:%s time %2.2fs, depth %2i, value %4i", str2, searchtime(ctx), result.depth, result.eval);
+#ifdef STATISTICS
+		// Ensure correct format specifiers for int types if changed from long
+        sprintf(str2,
+                "  nodes %i, gms %i, gcs %i, evals %i, fmc %i%%, db %i",
+                ctx->alphabetas,
+                ctx->generatemovelists,
+                ctx->generatecapturelists,
+                ctx->evaluations,
+                ctx->cutoffs ? (int)(100.0 * ctx->firstmovecutoffs / ctx->cutoffs) : 0,
+                ctx->dbhits);
+		strcat(str, str2);
+#endif
+		strcat(str, "  pv ");
+		pvtonotation(&result, str2, 254 - (int)strlen(str));
+		strcat(str, str2);
+#endif
+		if (result.eval == 5000)
+			break;
+		if (result.eval == -5000)
+			break;
+	}
+
+	/*--------> stop the helpers, and use their result if it is deeper than the
+	  --------> last iteration this thread completed. */
+	helperstop.store(1, std::memory_order_relaxed);
+	for (k = 0; k < (int)helpers.size(); k++) {
+		helpers[k].join();
+		ctx->alphabetas += helperctx[k].alphabetas;
+#ifdef STATISTICS
+		ctx->generatemovelists += helperctx[k].generatemovelists;
+		ctx->generatecapturelists += helperctx[k].generatecapturelists;
+		ctx->evaluations += helperctx[k].evaluations;
+		ctx->cutoffs += helperctx[k].cutoffs;
+		ctx->firstmovecutoffs += helperctx[k].firstmovecutoffs;
+		ctx->dbhits += helperctx[k].dbhits;
+#endif
+	}
+	if (!helpers.empty())
+		shareresult(&shared, &result);
+
+	movetonotation(result.best, str2);
+
+    // Ensure correct format specifiers for int types if changed from long
+	sprintf(str,
+			"best:%s time %2.2f, depth %2i, value %4i  nodes %i, gms %i, gcs %i, evals %i, fmc %i%%, db %i  pv ",
+			str2,
+			searchtime(ctx),
+			result.depth,
+			result.eval,
+			ctx->alphabetas,
+			ctx->generatemovelists,
+			ctx->generatecapturelists,
+			ctx->evaluations,
+			ctx->cutoffs ? (int)(100.0 * ctx->firstmovecutoffs / ctx->cutoffs) : 0,
+			ctx->dbhits);
+	pvtonotation(&result, str2, 254 - (int)strlen(str));
+	strcat(str, str2);
+
+	dobitmove(p, result.best);
+	return result.eval;
+}
+
+int searchiteration(SearchContext *ctx, pos *p, int depth, int color, SEARCHRESULT *result)
+/*----------> purpose: search p to depth with an aspiration window around the
+  ---------->          value of the previous iteration in result. on a fail low
+  ---------->          or fail high the window is widened on that side and the
+  ---------->          position is searched again.
+  ----------> returns 1 and the new result, or 0 if the search was stopped; in
+  ----------> that case result is unchanged.
+  ----------> version: 1.0
+  ----------> date: 17th october 2026 */
+{
+	int alpha, beta, value, window;
+	bitmove best;
+
+	agehistory(ctx);
+
+	window = ASPIRATIONWINDOW;
+	alpha = -10000;
+	beta = 10000;
+	if (result->eval > -4000 && result->eval < 4000) {
+		alpha = result->eval - window;
+		beta = result->eval + window;
+	}
+
+	for (;;) {
+		best = result->best;
+		value = firstalphabeta(ctx, p, depth, alpha, beta, color, &best);
+		if (ctx->play->load(std::memory_order_relaxed))
+			return(0);
+
+		if (value <= alpha && alpha > -10000) {
+			window *= 4;
+			alpha = std::max(value - window, -10000);
+		}
+		else if (value >= beta && beta < 10000) {
+			window *= 4;
+			beta = std::min(value + window, 10000);
+		}
+		else
+			break;
+	}
+
+	result->depth = depth;
+	result->eval = value;
+	result->best = best;
+	result->pvlength = ctx->pvlength[0];
+	memcpy(result->pv, ctx->pv[0], result->pvlength * sizeof(bitmove));
+	return(1);
+}
+
+int multipvsearch(SearchContext *ctx, pos *p, int color, double maxtime, char *str)
+/*----------> purpose: search of the "allscores" analysis mode: iterative
+  ---------->          deepening like checkers(), but every root move gets a
+  ---------->          score of its own. the best multipv moves have exact
+  ---------->          scores, the others only bounds which show that they are
+  ---------->          worse; with multipv 0 all scores are exact. the root
+  ---------->          moves are searched one after the other on the shared
+  ---------->          hashtable, so each of them finds most of its tree from
+  ---------->          the previous iteration. plays the best move on p.
+  ----------> returns the value of the best move.
+  ----------> version: 1.0
+  ----------> date: 17th october 2026 */
+{
+	int i, n, k, depth, win;
+	char str2[255];
+	bitmove movelist[MAXMOVES];
+	ROOTMOVE moves[MAXMOVES];
+
+	n = generatebitcapturelist(p, movelist, color);
+	if (n == 0)
+		n = generatebitmovelist(p, movelist, color);
+	for (i = 0; i < n; i++) {
+		moves[i].move = movelist[i];
+		moves[i].eval = 0;
+		moves[i].exact = 0;
+	}
+	k = multipv;
+	if (k <= 0 || k > n)
+		k = n;
+
+	/*--------> stop when the best k moves win, or the best one loses */
+	win = (color == BLACK) ? 5000 : -5000;
+	depth = 0;
+	for (i = 1; (i <= MAXDEPTH) && (i == 1 || searchtime(ctx) < maxtime); i++) {
+		if (!multipviteration(ctx, p, i, color, moves, n, k))
+			break;
+		depth = i;
+		if (moves[k - 1].eval == win || moves[0].eval == -win)
+			break;
+	}
+
+	movetonotation(moves[0].move, str2);
+	sprintf(str, "best:%s time %2.2fs, depth %2i, value %4i  scores ", str2, searchtime(ctx), depth, moves[0].eval);
+	scorestonotation(moves, n, color, str2, 254 - (int)strlen(str));
+	strcat(str, str2);
+
+	dobitmove(p, moves[0].move);
+	return(moves[0].eval);
+}
+
+int multipviteration(SearchContext *ctx, pos *p, int depth, int color, ROOTMOVE *moves, int n, int k)
+/*----------> purpose: one iteration of multipvsearch(). moves is sorted by the
+  ---------->          previous iteration, best first. the first k moves are
+  ---------->          searched with an aspiration window around their last
+  ---------->          score, the others with a zero window at the k-th best
+  ---------->          score so far; a move which beats it is searched again
+  ---------->          for its exact score. moves is sorted again at the end.
+  ----------> returns 1, or 0 if the search was stopped; in that case moves is
+  ----------> unchanged.
+  ----------> version: 1.0
+  ----------> date: 17th october 2026 */
+{
+	int i, j, alpha, beta, value, window, bound, sign, count;
+	int scores[MAXMOVES];
+	uint64_t hashkey = ctx->hashkey;
+	EVALSTATE evalstate = ctx->eval;
+	ROOTMOVE next[MAXMOVES];
+
+	agehistory(ctx);
+
+	/* scores are searched from black's point of view; sign turns them
+	   into "higher is better" for color */
+	sign = (color == BLACK) ? 1 : -1;
+
+	for (j = 0; j < n; j++) {
+		next[j] = moves[j];
+		evalupdate(&ctx->eval, p, moves[j].move);
+		dobitmove(p, moves[j].move);
+		ctx->hashkey = hashkey ^ hashmove(moves[j].move);
+		pathpush(ctx, 1, moves[j].move);
+
+		next[j].exact = 1;
+		if (j >= k) {
+			/* the k-th best exact score of this iteration */
+			count = 0;
+			for (i = 0; i < j; i++) {
+				if (next[i].exact)
+					scores[count++] = sign * next[i].eval;
+			}
+			std::nth_element(scores, scores + k - 1, scores + count, std::greater<int>());
+			bound = sign * scores[k - 1];
+
+			if (color == BLACK)
+				value = alphabeta(ctx, p, depth - 1, 1, bound, bound + 1, WHITE);
+			else
+				value = alphabeta(ctx, p, depth - 1, 1, bound - 1, bound, BLACK);
+			if (sign * value <= sign * bound)
+				next[j].exact = 0;
+		}
+
+		if (next[j].exact) {
+			window = ASPIRATIONWINDOW;
+			alpha = -10000;
+			beta = 10000;
+			if (moves[j].exact && depth > 2 && moves[j].eval > -4000 && moves[j].eval < 4000) {
+				alpha = moves[j].eval - window;
+				beta = moves[j].eval + window;
+			}
+			for (;;) {
+				value = alphabeta(ctx, p, depth - 1, 1, alpha, beta, CB_CHANGECOLOR(color));
+				if (ctx->play->load(std::memory_order_relaxed))
+					break;
+				if (value <= alpha && alpha > -10000) {
+					window *= 4;
+					alpha = std::max(value - window, -10000);
+				}
+				else if (value >= beta && beta < 10000) {
+					window *= 4;
+					beta = std::min(value + window, 10000);
+				}
+				else
+					break;
+			}
+		}
+		next[j].eval = value;
+
+		undobitmove(p, moves[j].move);
+		ctx->hashkey = hashkey;
+		ctx->eval = evalstate;
+		if (ctx->play->load(std::memory_order_relaxed))
+			return(0);
+	}
+
+	/* a bound is never better than the k-th best exact score, so the exact
+	   scores go first and the best k moves are in front */
+	std::stable_sort(next, next + n, [sign](const ROOTMOVE &a, const ROOTMOVE &b) {
+		if (a.exact != b.exact)
+			return(a.exact > b.exact);
+		return(sign * a.eval > sign * b.eval);
+	});
+	memcpy(moves, next, n * sizeof(ROOTMOVE));
+	return(1);
+}
+
+void helpersearch(SearchContext *ctx, pos position, int color, int threadnumber, SHAREDRESULT *shared)
+/*----------> purpose: helper thread of the parallel search ("lazy smp"). it
+  ---------->          iterates on the same root position as the main thread
+  ---------->          and profits from, and contributes to, the shared
+  ---------->          hashtable. odd helpers search one ply deeper than even
+  ---------->          ones, so that not all threads search the same tree.
+  ----------> version: 1.1
+  ----------> date: 17th october 2026 */
+{
+	int depth;
+	SEARCHRESULT result;
+
+	{
+		std::lock_guard<std::mutex> lock(shared->lock);
+		result = shared->result;
+	}
+	while (result.depth < MAXDEPTH) {
+		depth = std::min(result.depth + 1 + (threadnumber & 1), MAXDEPTH);
+		if (!searchiteration(ctx, &position, depth, color, &result))
+			break;
+		shareresult(shared, &result);
+		if (result.eval == 5000 || result.eval == -5000)
+			break;
+	}
+}
+
+void shareresult(SHAREDRESULT *shared, SEARCHRESULT *result)
+/*----------> purpose: compare the result of a completed iteration with the best
+  ---------->          result of all threads. a deeper result is published,
+  ---------->          else the shared result is returned in result.
+  ----------> version: 1.1
+  ----------> date: 17th october 2026 */
+{
+	std::lock_guard<std::mutex> lock(shared->lock);
+
+	if (result->depth > shared->result.depth)
+		shared->result = *result;
+	else
+		*result = shared->result;
+}
+
+double searchtime(SearchContext *ctx)
+/*----------> purpose: wall clock time in seconds since the search started. cpu
+  ---------->          time would run too fast with more than one thread.
+  ----------> version: 1.0
+  ----------> date: 17th october 2026 */
+{
+	return(std::chrono::duration<double>(std::chrono::steady_clock::now() - ctx->starttime).count());
+}
+
+void searchtimer(SearchContext *ctx, SEARCHTIMER *timer)
+/*----------> purpose: thread function of the search timer. stops the search
+  ---------->          when ctx->absolute_maxtime is reached or playnow is set.
+  ---------->          playnow is polled every TIMER_RESOLUTION_MS, which bounds
+  ---------->          the time until the search sees the stop flag.
+  ----------> version: 1.0
+  ----------> date: 17th october 2026 */
+{
+	double remaining;
+	std::unique_lock<std::mutex> lock(timer->lock);
+
+	while (!timer->finished) {
+		remaining = ctx->absolute_maxtime - searchtime(ctx);
+		if (*timer->playnow || remaining <= 0) {
+			timer->stoptime = searchtime(ctx);
+			ctx->play->store(1, std::memory_order_relaxed);
+#ifdef LOG_TIME_MGMT
+			if (remaining <= 0)
+				log("max detected at %.3f\n", timer->stoptime);
+#endif
+			break;
+		}
+		timer->wakeup.wait_for(lock, std::min(std::chrono::duration<double>(remaining),
+											  std::chrono::duration<double>(TIMER_RESOLUTION_MS / 1000.0)));
+	}
+}
+
+void allocatetime(int info, int moreinfo, double maxtime, int pieces, double *desired, double *absolute)
+/*----------> purpose: decide how long to search. *desired is the average time
+  ---------->          the search should take, *absolute the time after which
+  ---------->          it is stopped.
+  ---------->          with a fischer clock the time left is spread over the
+  ---------->          moves we still expect to play, which are estimated from
+  ---------->          the number of pieces on the board. the increment is
+  ---------->          added to that in full, as it is paid back after the move.
+  ---------->          TIME_OVERHEAD per move is kept in reserve for the time
+  ---------->          lost outside of the search.
+  ----------> version: 1.0
+  ----------> date: 17th october 2026 */
+{
+	int movestogo;
+	double increment, remaining, usable;
+
+	if (!get_incremental_times(info, moreinfo, &increment, &remaining)) {
+		*desired = maxtime;
+		if (info & CB_EXACT_TIME)
+			*absolute = maxtime;
+		else
+			*absolute = 3 * maxtime;
+		return;
+	}
+
+	movestogo = 10 + pieces;
+	usable = remaining - TIME_OVERHEAD * movestogo / 4;
+	if (usable < remaining / 4)
+		usable = remaining / 4;
+
+	*desired = usable / movestogo + increment;
+	*absolute = std::min(3 * *desired, usable / 2 + increment / 2);
+	*absolute = std::min(*absolute, remaining - TIME_OVERHEAD);
+	if (*absolute < 0.001)
+		*absolute = 0.001;
+	if (*desired > *absolute)
+		*desired = *absolute;
+}
+
+int firstalphabeta(SearchContext *ctx, pos *p, int depth, int alpha, int beta, int color, bitmove *best)
+/*----------> purpose: search the game tree and find the best move. *best is
+  ---------->          set to the best move, or to the move that failed high.
+  ----------> version: 1.3
+  ----------> date: 17th october 2026 */
+{
+	int i, j;
+	int value;
+	int numberofmoves;
+	int capture;
+	int hashindex, bestindex;
+	int order[MAXMOVES];
+	int oldalpha = alpha, oldbeta = beta;
+	uint64_t hashkey = ctx->hashkey;
+	EVALSTATE evalstate = ctx->eval;
+	bitmove movelist[MAXMOVES];
+
+	ctx->alphabetas++;
+	ctx->pvlength[0] = 0;
+	if (ctx->play->load(std::memory_order_relaxed))
+		return 0;
+
+	/*----------> test if captures are possible */
+#ifdef STATISTICS
+	ctx->testcaptures++;
+#endif
+	capture = testbitcapture(p, color);
+
+	/*----------> recursion termination if no captures and depth=0*/
+	if (depth == 0) {
+		if (capture == 0)
+			return(evaluation(ctx, p, color));
+		else
+			depth = 1;
+	}
+
+	/*----------> generate all possible moves in the position */
+	if (capture == 0) {
+#ifdef STATISTICS
+		ctx->generatemovelists++;
+#endif
+		numberofmoves = generatebitmovelist(p, movelist, color);
+
+		/*----------> if there are no possible moves, we lose: */
+		if (numberofmoves == 0) {
+			if (color == BLACK)
+				return(-5000);
+			else
+				return(5000);
+		}
+	}
+	else {
+#ifdef STATISTICS
+		ctx->generatecapturelists++;
+#endif
+		numberofmoves = generatebitcapturelist(p, movelist, color);
+	}
+
+	/*----------> at the root the hashtable is only used for the best move of
+	  ----------> the previous iteration, which is searched first. */
+	hashindex = HASH_NOMOVE;
+	hashlookup(hashkey, 0, alpha, beta, &value, &hashindex);
+	if (hashindex >= numberofmoves)
+		hashindex = HASH_NOMOVE;
+	bestindex = HASH_NOMOVE;
+	ordermoves(ctx, movelist, numberofmoves, hashindex, 0, color, order);
+
+	/*----------> for all moves: execute the move, search tree, undo move. */
+	for (j = 0; j < numberofmoves; j++) {
+		i = order[j];
+		evalupdate(&ctx->eval, p, movelist[i]);
+		dobitmove(p, movelist[i]);
+		ctx->hashkey = hashkey ^ hashmove(movelist[i]);
+		pathpush(ctx, 1, movelist[i]);
+
+		value = pvsearch(ctx, p, depth - 1, 1, alpha, beta, CB_CHANGECOLOR(color), j == 0);
+
+		undobitmove(p, movelist[i]);
+		ctx->hashkey = hashkey;
+		ctx->eval = evalstate;
+		if (color == BLACK) {
+			if (value >= beta) {
+				*best = movelist[i];
+				if (!ctx->play->load(std::memory_order_relaxed)) {
+					hashstore(hashkey, depth, value, HASH_LOWER, i);
+					goodmove(ctx, movelist[i], depth, 0, color, j);
+				}
+				return(value);
+			}
+			if (value > alpha) {
+				alpha = value;
+				*best = movelist[i];
+				bestindex = i;
+				updatepv(ctx, 0, movelist[i]);
+			}
+		}
+
+		if (color == WHITE) {
+			if (value <= alpha) {
+				*best = movelist[i];
+				if (!ctx->play->load(std::memory_order_relaxed)) {
+					hashstore(hashkey, depth, value, HASH_UPPER, i);
+					goodmove(ctx, movelist[i], depth, 0, color, j);
+				}
+				return(value);
+			}
+			if (value < beta) {
+				beta = value;
+				*best = movelist[i];
+				bestindex = i;
+				updatepv(ctx, 0, movelist[i]);
+			}
+		}
+	}
+
+	if (ctx->play->load(std::memory_order_relaxed))
+		return(color == BLACK ? alpha : beta);
+
+	if (color == BLACK) {
+		hashstore(hashkey, depth, alpha, alpha > oldalpha ? HASH_EXACT : HASH_UPPER, bestindex);
+		return(alpha);
+	}
+	hashstore(hashkey, depth, beta, beta < oldbeta ? HASH_EXACT : HASH_LOWER, bestindex);
+	return(beta);
+}
+
+int alphabeta(SearchContext *ctx, pos *p, int depth, int ply, int alpha, int beta, int color)
+/*----------> purpose: search the game tree and find the best move. ply is the
+  ---------->          distance from the root.
+  ----------> version: 1.4
+  ----------> date: 17th october 2026 */
+{
+	int i, j;
+	int value;
+	int capture;
+	int numberofmoves;
+	int hashindex, bestindex;
+	int order[MAXMOVES];
+	int oldalpha = alpha, oldbeta = beta;
+	uint64_t hashkey = ctx->hashkey;
+	EVALSTATE evalstate = ctx->eval;
+	bitmove movelist[MAXMOVES];
+
+	/*----------> a repeated position is a draw */
+	if (repetition(ctx, ply)) {
+		if (ply < MAXPV)
+			ctx->pvlength[ply] = 0;
+		return(0);
+	}
+
+	/*----------> at depth 0 only captures are searched */
+	if (depth == 0)
+		return(quiescence(ctx, p, ply, alpha, beta, color));
+
+	ctx->alphabetas++;
+	if (ply < MAXPV)
+		ctx->pvlength[ply] = 0;
+	if (ctx->play->load(std::memory_order_relaxed))
+		return 0;
+
+	/*----------> positions in the endgame database need no search */
+	if (dbprobe(ctx, p, color, &value))
+		return(value);
+
+
+	/*----------> test if captures are possible */
+#ifdef STATISTICS
+	ctx->testcaptures++;
+#endif
+	capture = testbitcapture(p, color);
+
+	/*----------> look up the position in the hashtable. nodes with an open
+	  ----------> window are searched anyway, so that the pv is complete. */
+	if (hashlookup(hashkey, depth, alpha, beta, &value, &hashindex) && beta - alpha == 1)
+		return(value);
+
+	/*----------> generate all possible moves in the position */
+	if (capture == 0) {
+#ifdef STATISTICS
+		ctx->generatemovelists++;
+#endif
+		numberofmoves = generatebitmovelist(p, movelist, color);
+
+		/*----------> if there are no possible moves, we lose: */
+		if (numberofmoves == 0) {
+			if (color == BLACK)
+				return(-5000);
+			else
+				return(5000);
+		}
+	}
+	else {
+#ifdef STATISTICS
+		ctx->generatecapturelists++;
+#endif
+		numberofmoves = generatebitcapturelist(p, movelist, color);
+	}
+
+	if (hashindex >= numberofmoves)
+		hashindex = HASH_NOMOVE;
+	bestindex = HASH_NOMOVE;
+	ordermoves(ctx, movelist, numberofmoves, hashindex, ply, color, order);
+
+	/*----------> for all moves: execute the move, search tree, undo move. */
+	for (j = 0; j < numberofmoves; j++) {
+		i = order[j];
+		evalupdate(&ctx->eval, p, movelist[i]);
+		dobitmove(p, movelist[i]);
+		ctx->hashkey = hashkey ^ hashmove(movelist[i]);
+		pathpush(ctx, ply + 1, movelist[i]);
+
+		value = pvsearch(ctx, p, depth - 1, ply + 1, alpha, beta, CB_CHANGECOLOR(color), j == 0);
+
+		undobitmove(p, movelist[i]);
+		ctx->hashkey = hashkey;
+		ctx->eval = evalstate;
+
+		if (color == BLACK) {
+			if (value >= beta) {
+				if (!ctx->play->load(std::memory_order_relaxed)) {
+					hashstore(hashkey, depth, value, HASH_LOWER, i);
+					goodmove(ctx, movelist[i], depth, ply, color, j);
+				}
+				return(value);
+			}
+			if (value > alpha) {
+				alpha = value;
+				bestindex = i;
+				updatepv(ctx, ply, movelist[i]);
+			}
+		}
+
+		if (color == WHITE) {
+			if (value <= alpha) {
+				if (!ctx->play->load(std::memory_order_relaxed)) {
+					hashstore(hashkey, depth, value, HASH_UPPER, i);
+					goodmove(ctx, movelist[i], depth, ply, color, j);
+				}
+				return(value);
+			}
+			if (value < beta) {
+				beta = value;
+				bestindex = i;
+				updatepv(ctx, ply, movelist[i]);
+			}
+		}
+	}
+
+	if (ctx->play->load(std::memory_order_relaxed))
+		return(color == BLACK ? alpha : beta);
+
+	if (color == BLACK) {
+		hashstore(hashkey, depth, alpha, alpha > oldalpha ? HASH_EXACT : HASH_UPPER, bestindex);
+		return(alpha);
+	}
+	hashstore(hashkey, depth, beta, beta < oldbeta ? HASH_EXACT : HASH_LOWER, bestindex);
+	return(beta);
+}
+
+#ifdef DELTAPRUNING
+static inline int materialvalue(EVALSTATE *e)
+{
+	/* the material part of evaluation() */
+	int v1 = 100 * e->n[0] + 130 * e->n[1];
+	int v2 = 100 * e->n[2] + 130 * e->n[3];
+
+	if (v1 + v2 == 0)
+		return(0);
+	return(v1 - v2 + (250 * (v1 - v2)) / (v1 + v2));
+}
+#endif
+
+int quiescence(SearchContext *ctx, pos *p, int ply, int alpha, int beta, int color)
+/*----------> purpose: search the capture sequences at the end of the main
+  ---------->          search until the position is quiet. captures are
+  ---------->          compulsory, so the side to move can only stand pat on
+  ---------->          the static evaluation if it has none.
+  ----------> version: 1.0
+  ----------> date: 17th october 2026 */
+{
+	int i;
+	int value;
+	int numberofmoves;
+	EVALSTATE evalstate = ctx->eval;
+	bitmove movelist[MAXMOVES];
+
+	ctx->alphabetas++;
+	if (ply < MAXPV)
+		ctx->pvlength[ply] = 0;
+	if (ctx->play->load(std::memory_order_relaxed))
+		return 0;
+
+	if (dbprobe(ctx, p, color, &value))
+		return(value);
+
+#ifdef STATISTICS
+	ctx->testcaptures++;
+#endif
+	if (!testbitcapture(p, color))
+		return(evaluation(ctx, p, color));
+
+#ifdef STATISTICS
+	ctx->generatecapturelists++;
+#endif
+	numberofmoves = generatebitcapturelist(p, movelist, color);
+
+	for (i = 0; i < numberofmoves; i++) {
+		evalupdate(&ctx->eval, p, movelist[i]);
+#ifdef DELTAPRUNING
+		/*----------> skip captures which leave us too far behind even if the
+		  ----------> opponent has no capture in return. */
+		if (color == BLACK && materialvalue(&ctx->eval) + DELTAMARGIN <= alpha) {
+			ctx->eval = evalstate;
+			continue;
+		}
+		if (color == WHITE && materialvalue(&ctx->eval) - DELTAMARGIN >= beta) {
+			ctx->eval = evalstate;
+			continue;
+		}
+#endif
+		dobitmove(p, movelist[i]);
+
+		value = quiescence(ctx, p, ply + 1, alpha, beta, CB_CHANGECOLOR(color));
+
+		undobitmove(p, movelist[i]);
+		ctx->eval = evalstate;
+
+		if (color == BLACK) {
+			if (value >= beta)
+				return(value);
+			if (value > alpha) {
+				alpha = value;
+				updatepv(ctx, ply, movelist[i]);
+			}
+		}
+		else {
+			if (value <= alpha)
+				return(value);
+			if (value < beta) {
+				beta = value;
+				updatepv(ctx, ply, movelist[i]);
+			}
+		}
+	}
+	return(color == BLACK ? alpha : beta);
+}
+
+void domove(int b[46], move2 &move)
+/*----------> purpose: execute move on board
+  ----------> version: 1.1
+  ----------> date: 25th october 97 */
+{
+	int square, after;
+	int i;
+
+	for (i = 0; i < move.n; i++) {
+		square = (move.m[i] % 256);
+		after = ((move.m[i] >> 16) % 256);
+		b[square] = after;
+	}
+}
+
+void undomove(int b[46], move2 &move)
+{
+	int square, before;
+	int i;
+
+	for (i = move.n - 1; i >= 0; --i) {
+		square = (move.m[i] % 256);
+		before = ((move.m[i] >> 8) % 256);
+		b[square] = before;
+	}
+}
+
+int evaluation(SearchContext *ctx, pos *p, int color)
+/*----------> purpose: evaluate p from black's point of view. material, center,
+  ---------->          edge and tempo are taken from ctx->eval.
+  ----------> version: 1.3
+  ----------> date: 17th october 2026 */
+{
+	int eval;
+	int v1, v2;
+	int nbm, nbk, nwm, nwk;
+	int code = 0;
+	unsigned int men, occupied;
+	static const int backrankvalue[16] = { 0, -1, 1, 0, 1, 1, 2, 1, 1, 0, 7, 4, 2, 2, 9, 8 };
+	static const unsigned int safeedge = 0x11000088;	/* squares 1, 5, 28, 32 */
+
+	int tempo;
+	int nm, nk;
+
+	const int turn = 2;						//color to move gets +turn
+	const int brv = 3;						//multiplier for back rank
+	const int cramp = 5;					//multiplier for cramp
+	const int opening = -2;					// multipliers for tempo
+	const int midgame = -1;
+	const int endgame = 2;
+	const int intactdoublecorner = 3;
+
+	int backrank;
+
+	int stonesinsystem = 0;
+
+#ifdef STATISTICS
+	ctx->evaluations++;
+#endif
+	nbm = ctx->eval.n[0];
+	nbk = ctx->eval.n[1];
+	nwm = ctx->eval.n[2];
+	nwk = ctx->eval.n[3];
+
+	v1 = 100 * nbm + 130 * nbk;
+	v2 = 100 * nwm + 130 * nwk;
+
+	eval = v1 - v2;							/*material values*/
+    // Avoid division by zero if v1+v2 is 0
+    if (v1 + v2 != 0) {
+	    eval += (250 * (v1 - v2)) / (v1 + v2);	/*favor exchanges if in material plus*/
+    }
+
+	nm = nbm + nwm;
+	nk = nbk + nwk;
+
+	/*--------- fine evaluation below -------------*/
+	if (color == BLACK)
+		eval += turn;
+	else
+		eval -= turn;
+
+	/* (white)
+   				 28  29  30  31
+              24  25  26  27
+                20  21  22  23
+              16  17  18  19
+                12  13  14  15
+               8   9  10  11
+                 4   5   6   7
+               0   1   2   3
+         (black)   */
+
+	/* cramp */
+	if ((p->bm & (1u << 16)) && (p->wm & (1u << 20)))
+		eval += cramp;
+	if ((p->wm & (1u << 15)) && (p->bm & (1u << 11)))
+		eval -= cramp;
+
+	/* back rank guard */
+	men = p->bm | p->wm;
+	backrank = backrankvalue[men & 0xf];
+
+	code = 0;
+	if (men & (1u << 28))
+		code += 8;
+	if (men & (1u << 29))
+		code += 4;
+	if (men & (1u << 30))
+		code += 2;
+	if (men & (1u << 31))
+		code++;
+
+	backrank -= backrankvalue[code];
+	eval += brv * backrank;
+
+	/* intact double corner */
+	if (p->bm & (1u << 3)) {
+		if (p->bm & ((1u << 6) | (1u << 7)))
+			eval += intactdoublecorner;
+	}
+
+	if (p->wm & (1u << 28)) {
+		if (p->wm & ((1u << 24) | (1u << 25)))
+			eval -= intactdoublecorner;
+	}
+
+	/* center control and edge */
+	eval += ctx->eval.psq;
+
+	tempo = ctx->eval.tempo;
+	if (nm >= 16)
+		eval += opening * tempo;
+	if ((nm <= 15) && (nm >= 12))
+		eval += midgame * tempo;
+	if (nm < 9)
+		eval += endgame * tempo;
+
+	if (nbk + nbm > nwk + nwm && nwk < 3)
+		eval -= 15 * bitcount(p->wk & safeedge);
+
+	if (nwk + nwm > nbk + nbm && nbk < 3)
+		eval += 15 * bitcount(p->bk & safeedge);
+
+	/* the move */
+	if (nwm + nwk - nbk - nbm == 0) {
+		occupied = p->bm | p->bk | p->wm | p->wk;
+		if (color == BLACK) {
+			/* the black system is rows 0, 2, 4 and 6 */
+			stonesinsystem = bitcount(occupied & 0x0f0f0f0f);
+
+			if (stonesinsystem % 2) {
+				if (nm + nk <= 12)
+					eval++;
+				if (nm + nk <= 10)
+					eval++;
+				if (nm + nk <= 8)
+					eval += 2;
+				if (nm + nk <= 6)
+					eval += 2;
+			}
+			else {
+				if (nm + nk <= 12)
+					eval--;
+				if (nm + nk <= 10)
+					eval--;
+				if (nm + nk <= 8)
+					eval -= 2;
+				if (nm + nk <= 6)
+					eval -= 2;
+			}
+		}
+		else {
+			/* the white system is rows 1, 3, 5 and 7 */
+			stonesinsystem = bitcount(occupied & 0xf0f0f0f0);
+
+			if ((stonesinsystem % 2) == 0) {
+				if (nm + nk <= 12)
+					eval++;
+				if (nm + nk <= 10)
+					eval++;
+				if (nm + nk <= 8)
+					eval += 2;
+				if (nm + nk <= 6)
+					eval += 2;
+			}
+			else {
+				if (nm + nk <= 12)
+					eval--;
+				if (nm + nk <= 10)
+					eval--;
+				if (nm + nk <= 8)
+					eval -= 2;
+				if (nm + nk <= 6)
+					eval -= 2;
+			}
+		}
+	}
+
+	return(eval);
+}
+
+static inline int psqvalue(int kind, int square)
+{
+	/* center and edge value of a piece of kind 0..3 (bm, bk, wm, wk) on square,
+	   from black's point of view */
+	int v = 0;
+
+	if (center & (1u << square))
+		v += (kind & 1) ? kcv : mcv;
+	if (edge & (1u << square))
+		v -= (kind & 1) ? kev : mev;
+	return(kind < 2 ? v : -v);
+}
+
+static inline int tempovalue(int kind, int square)
+{
+	/* the row of a black man, 7 - row for a white man, kings don't count */
+	if (kind == 0)
+		return(square / 4);
+	if (kind == 2)
+		return(-(7 - square / 4));
+	return(0);
+}
+
+void evalinit(EVALSTATE *e, pos *p)
+/*----------> purpose: compute the incremental evaluation terms of p from scratch
+  ----------> version: 1.0
+  ----------> date: 17th october 2026 */
+{
+	int kind, square;
+	unsigned int x;
+	unsigned int pieces[4] = { p->bm, p->bk, p->wm, p->wk };
+
+	e->psq = 0;
+	e->tempo = 0;
+	for (kind = 0; kind < 4; kind++) {
+		e->n[kind] = bitcount(pieces[kind]);
+		for (x = pieces[kind]; x; x &= x - 1) {
+			square = lsb(x);
+			e->psq += psqvalue(kind, square);
+			e->tempo += tempovalue(kind, square);
+		}
+	}
+}
+
+void evalupdate(EVALSTATE *e, pos *p, bitmove &move)
+/*----------> purpose: update the incremental evaluation terms for move, which is
+  ---------->          about to be executed on p. a changed bit which is set in
+  ---------->          p is a piece that disappears, else one that appears.
+  ---------->          the caller restores e when the move is undone.
+  ----------> version: 1.0
+  ----------> date: 17th october 2026 */
+{
+	int kind, square, sign;
+	unsigned int x;
+	unsigned int pieces[4] = { p->bm, p->bk, p->wm, p->wk };
+	unsigned int changed[4] = { move.bm, move.bk, move.wm, move.wk };
+
+	for (kind = 0; kind < 4; kind++) {
+		for (x = changed[kind]; x; x &= x - 1) {
+			square = lsb(x);
+			sign = (pieces[kind] & (1u << square)) ? -1 : 1;
+			e->n[kind] += sign;
+			e->psq += sign * psqvalue(kind, square);
+			e->tempo += sign * tempovalue(kind, square);
+		}
+	}
+}
+
+/*-------------- PART IIb: HASHTABLE -----------------------------------------*/
+void inithashkeys(void)
+/*----------> purpose: fill the zobrist tables with random numbers. a fixed
+  ---------->          seed is used so that searches are reproducible.
+  ----------> version: 1.1
+  ----------> date: 17th october 2026 */
+{
+	int i, j;
+	uint64_t seed = 0x9e3779b97f4a7c15ULL;
+	uint64_t z;
+
+	for (i = 0; i <= 4; i++) {
+		for (j = 0; j < 32; j++) {
+			/* splitmix64 */
+			seed += 0x9e3779b97f4a7c15ULL;
+			z = seed;
+			z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+			z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+			z ^= z >> 31;
+			if (i < 4)
+				zobrist[i][j] = z;
+			else
+				zobrist_white = z;
+		}
+	}
+}
+
+static int hashtable_allocate(int mbytes)
+/*----------> purpose: (re)allocate the hashtable with at most mbytes MB. the
+  ---------->          number of entries is rounded down to a power of 2.
+  ---------->          the caller holds hashmutex.
+  ----------> returns 1 on success, 0 if no memory could be allocated; in that
+  ----------> case the old table is kept.
+  ----------> version: 1.0
+  ----------> date: 17th october 2026 */
+{
+	uint64_t entries;
+	HASHENTRY *newtable;
+
+	std::call_once(hashkeysonce, inithashkeys);
+
+	if (mbytes > MAX_HASHMB)
+		mbytes = MAX_HASHMB;
+	entries = 2;
+	while (2 * entries * sizeof(HASHENTRY) <= (uint64_t)mbytes * 1024 * 1024)
+		entries *= 2;
+
+	newtable = (HASHENTRY *)calloc((size_t)entries, sizeof(HASHENTRY));
+	if (newtable == NULL)
+		return(0);
+
+	free(hashtable);
+	hashtable = newtable;
+	hashmask = entries - 1;
+	hashmb = (int)((entries * sizeof(HASHENTRY)) >> 20);
+	if (hashmb == 0)
+		hashmb = 1;
+	return(1);
+}
+
+int hashtable_resize(int mbytes)
+/*----------> purpose: set the size of the hashtable to at most mbytes MB. must
+  ---------->          not be called while a search is running.
+  ----------> returns 1 on success, 0 if no memory could be allocated.
+  ----------> version: 1.1
+  ----------> date: 17th october 2026 */
+{
+	std::lock_guard<std::mutex> lock(hashmutex);
+
+	return(hashtable_allocate(mbytes));
+}
+
+void hashtable_newsearch(void)
+/*----------> purpose: allocate the hashtable on first use and start a new
+  ---------->          generation of entries. called at the start of every
+  ---------->          search, possibly from several threads at once.
+  ----------> version: 1.0
+  ----------> date: 17th october 2026 */
+{
+	std::lock_guard<std::mutex> lock(hashmutex);
+
+	if (hashtable == NULL)
+		hashtable_allocate(DEFAULT_HASHMB);
+	hashgeneration++;
+}
+
+uint64_t hashposition(pos *p, int color)
+/*----------> purpose: compute the hashkey of a position from scratch. during
+  ---------->          the search the key is updated incrementally instead.
+  ----------> version: 1.1
+  ----------> date: 17th october 2026 */
+{
+	uint64_t key = 0;
+
+	key ^= hashbits(zobrist[0], p->bm);
+	key ^= hashbits(zobrist[1], p->bk);
+	key ^= hashbits(zobrist[2], p->wm);
+	key ^= hashbits(zobrist[3], p->wk);
+	if (color == WHITE)
+		key ^= zobrist_white;
+	return(key);
+}
+
+uint64_t hashmove(bitmove &move)
+/*----------> purpose: the change of the hashkey caused by move, including the
+  ---------->          change of the side to move.
+  ----------> version: 1.0
+  ----------> date: 17th october 2026 */
+{
+	return(hashbits(zobrist[0], move.bm) ^ hashbits(zobrist[1], move.bk) ^
+		   hashbits(zobrist[2], move.wm) ^ hashbits(zobrist[3], move.wk) ^ zobrist_white);
+}
+
+int hashlookup(uint64_t hashkey, int depth, int alpha, int beta, int *value, int *bestindex)
+/*----------> purpose: look up the position with key hashkey in the hashtable.
+  ---------->          *bestindex is set to the stored best move or HASH_NOMOVE.
+  ----------> returns 1 if the stored score is deep enough to cut off the
+  ----------> search with *value, else 0.
+  ----------> version: 1.0
+  ----------> date: 17th october 2026 */
+{
+	int i;
+	int score;
+	uint64_t data;
+	HASHENTRY *bucket;
+
+	*bestindex = HASH_NOMOVE;
+	bucket = hashtable + (hashkey & hashmask & ~(uint64_t)1);
+	for (i = 0; i < 2; i++) {
+		data = bucket[i].data;
+		if ((bucket[i].lock ^ data) != hashkey)
+			continue;
+
+		*bestindex = (int)((data >> 26) & 63);
+		if ((int)((data >> 16) & 0xff) < depth)
+			return(0);
+
+		score = (int16_t)(data & 0xffff);
+		switch ((data >> 24) & 3) {
+		case HASH_EXACT:
+			*value = score;
+			return(1);
+
+		case HASH_LOWER:
+			if (score >= beta) {
+				*value = score;
+				return(1);
+			}
+			break;
+
+		case HASH_UPPER:
+			if (score <= alpha) {
+				*value = score;
+				return(1);
+			}
+			break;
+		}
+		return(0);
+	}
+	return(0);
+}
+
+void hashstore(uint64_t hashkey, int depth, int value, int bound, int bestindex)
+/*----------> purpose: store the search result for the position with key hashkey. the
+  ---------->          first entry of a bucket is replaced by deeper or newer
+  ---------->          results, the second entry is always replaced.
+  ----------> version: 1.0
+  ----------> date: 17th october 2026 */
+{
+	uint64_t data, olddata;
+	HASHENTRY *bucket, *entry;
+
+	data = (uint64_t)(uint16_t)value;
+	data |= (uint64_t)(depth & 0xff) << 16;
+	data |= (uint64_t)bound << 24;
+	data |= (uint64_t)(bestindex & 63) << 26;
+	data |= (uint64_t)(hashgeneration & 0xff) << 32;
+
+	bucket = hashtable + (hashkey & hashmask & ~(uint64_t)1);
+	entry = bucket + 1;
+	olddata = bucket[0].data;
+	if ((bucket[0].lock ^ olddata) == hashkey ||
+		(int)((olddata >> 32) & 0xff) != (hashgeneration & 0xff) ||
+		(int)((olddata >> 16) & 0xff) <= depth)
+		entry = bucket;
+
+	entry->lock = hashkey ^ data;
+	entry->data = data;
+}
+
+/*-------------- PART IIc: MOVE ORDERING -------------------------------------*/
+static inline int samemove(bitmove &a, bitmove &b)
+{
+	return(a.bm == b.bm && a.bk == b.bk && a.wm == b.wm && a.wk == b.wk);
+}
+
+void ordermoves(SearchContext *ctx, bitmove movelist[MAXMOVES], int n, int hashindex, int ply, int color, int order[MAXMOVES])
+/*----------> purpose: fill order with the indices of the moves in movelist in
+  ---------->          the order in which they should be searched: the hash
+  ---------->          move, then the two killer moves of this ply, then the
+  ---------->          other moves by their history value. the movelist itself
+  ---------->          stays in generator order, as the hashtable stores
+  ---------->          indices into it.
+  ----------> version: 1.0
+  ----------> date: 17th october 2026 */
+{
+	int i, j;
+	int score[MAXMOVES];
+	int (*history)[32] = ctx->history[color == BLACK];
+
+	for (i = 0; i < n; i++) {
+		if (i == hashindex)
+			score[i] = ORDER_HASHMOVE;
+		else if (ply < MAXPLY && samemove(movelist[i], ctx->killers[ply][0]))
+			score[i] = ORDER_KILLER + 1;
+		else if (ply < MAXPLY && samemove(movelist[i], ctx->killers[ply][1]))
+			score[i] = ORDER_KILLER;
+		else
+			score[i] = history[(int)movelist[i].from][(int)movelist[i].to];
+
+		/* insertion sort, the movelists are short */
+		for (j = i; j > 0 && score[order[j - 1]] < score[i]; j--)
+			order[j] = order[j - 1];
+		order[j] = i;
+	}
+}
+
+void goodmove(SearchContext *ctx, bitmove &move, int depth, int ply, int color, int j)
+/*----------> purpose: move, the j-th move searched, caused a cutoff at depth:
+  ---------->          make it a killer of this ply and raise its history value.
+  ----------> version: 1.0
+  ----------> date: 17th october 2026 */
+{
+	int *h;
+
+#ifdef STATISTICS
+	ctx->cutoffs++;
+	if (j == 0)
+		ctx->firstmovecutoffs++;
+#endif
+	if (ply < MAXPLY && !samemove(move, ctx->killers[ply][0])) {
+		ctx->killers[ply][1] = ctx->killers[ply][0];
+		ctx->killers[ply][0] = move;
+	}
+
+	h = &ctx->history[color == BLACK][(int)move.from][(int)move.to];
+	*h += depth * depth;
+	if (*h >= MAXHISTORY)
+		agehistory(ctx);
+}
+
+void agehistory(SearchContext *ctx)
+/*----------> purpose: halve all history values, so that what was learned in the
+  ---------->          current iteration counts more than older results.
+  ----------> version: 1.0
+  ----------> date: 17th october 2026 */
+{
+	int *h = &ctx->history[0][0][0];
+	int i;
+
+	for (i = 0; i < 2 * 32 * 32; i++)
+		h[i] /= 2;
+}
+
+/*-------------- PART IId: PROOF-NUMBER SEARCH -------------------------------*/
+static int dfpn_allocate(void)
+{
+	/* allocate the proof table on first use. the caller holds dfpnmutex */
+	uint64_t entries = DFPN_BUCKET;
+
+	if (dfpntable != NULL)
+		return(1);
+	while (2 * entries * sizeof(DFPNENTRY) <= (uint64_t)DFPN_MB * 1024 * 1024)
+		entries *= 2;
+	dfpntable = (DFPNENTRY *)calloc((size_t)entries, sizeof(DFPNENTRY));
+	if (dfpntable == NULL)
+		return(0);
+	dfpnmask = entries - 1;
+	return(1);
+}
+
+static int dfpn_lookup(uint64_t key, int *pn, int *dn, int *logwork = NULL)
+{
+	int i;
+	uint64_t data;
+	DFPNENTRY *bucket = dfpntable + (key & dfpnmask & ~(uint64_t)(DFPN_BUCKET - 1));
+
+	for (i = 0; i < DFPN_BUCKET; i++) {
+		data = bucket[i].data;
+		if ((bucket[i].lock ^ data) == key) {
+			*pn = (int)(data & DFPN_INFINITY);
+			*dn = (int)((data >> 28) & DFPN_INFINITY);
+			if (logwork != NULL)
+				*logwork = (int)(data >> 56);
+			return(1);
+		}
+	}
+	return(0);
+}
+
+static void dfpn_store(uint64_t key, int pn, int dn, uint64_t work)
+{
+	/* the entry with the least work in the bucket is replaced */
+	int i, replace = 0, logwork = 0, least = 256, w;
+	uint64_t data;
+	DFPNENTRY *bucket = dfpntable + (key & dfpnmask & ~(uint64_t)(DFPN_BUCKET - 1));
+
+	while (logwork < 255 && (work >> logwork) > 1)
+		logwork++;
+	for (i = 0; i < DFPN_BUCKET; i++) {
+		data = bucket[i].data;
+		if ((bucket[i].lock ^ data) == key) {
+			replace = i;
+			break;
+		}
+		w = (int)(data >> 56);
+		if (w < least) {
+			least = w;
+			replace = i;
+		}
+	}
+	data = (uint64_t)pn | ((uint64_t)dn << 28) | ((uint64_t)logwork << 56);
+	bucket[replace].data = data;
+	bucket[replace].lock = key ^ data;
+}
+
+static inline int dfpn_add(int a, int b)
+{
+	return(std::min(a + b, DFPN_INFINITY));
+}
+
+static uint64_t dfpn_mid(DFPNSEARCH *s, pos *p, int color, int ply, int thpn, int thdn, int *pn, int *dn, int *pathply)
+/*----------> purpose: expand p until its proof number reaches thpn or its
+  ---------->          disproof number reaches thdn. numbers are for the
+  ---------->          proof that s->attacker wins; the attacker's nodes are
+  ---------->          OR nodes, the defender's AND nodes. positions which
+  ---------->          repeat the path from the root count as not won for the
+  ---------->          attacker, as repetitions are draws.
+  ---------->          such a disproof only holds on this path: *pathply is
+  ---------->          the ply of the earliest position on the path which it
+  ---------->          repeats, -1 if it needs a line cut off at DFPN_MAXPLY,
+  ---------->          DFPN_MAXPLY if it holds on every path. it is only
+  ---------->          stored in the proof table if it does not reach above
+  ---------->          p. proofs never depend on the path.
+  ----------> returns the number of nodes searched.
+  ----------> version: 1.1
+  ----------> date: 17th october 2026 */
+{
+	int i, n, best, second, cthpn, cthdn, result;
+	int cpn[MAXMOVES], cdn[MAXMOVES], cpathply[MAXMOVES];
+	char local[MAXMOVES];		/* the child's disproof is not in the table, it only holds on this path */
+	int ornode = color == s->attacker;
+	uint64_t key = s->ctx->hashkey ^ s->attackerkey;
+	uint64_t childkey[MAXMOVES];
+	uint64_t work = 1;
+	bitmove movelist[MAXMOVES];
+	EVALSTATE evalstate = s->ctx->eval;
+
+	s->ctx->alphabetas++;
+	if ((s->ctx->alphabetas & 1023) == 0 && searchtime(s->ctx) > s->maxtime)
+		s->stop = 1;
+
+	/*----------> terminal positions: no moves, or in the endgame database */
+	result = DB_UNKNOWN;
+	if (s->ctx->tables && s->ctx->eval.n[0] + s->ctx->eval.n[1] + s->ctx->eval.n[2] + s->ctx->eval.n[3] <= dbprobepieces)
+		result = dblookup(p, color, dbprobepieces);
+	if (result == DB_UNKNOWN) {
+		if (testbitcapture(p, color))
+			n = generatebitcapturelist(p, movelist, color);
+		else
+			n = generatebitmovelist(p, movelist, color);
+		if (n == 0)
+			result = DB_LOSS;
+	}
+	if (result != DB_UNKNOWN) {
+		/* a draw disproves the attacker's win at either kind of node */
+		if (ornode ? result == DB_WIN : result == DB_LOSS) {
+			*pn = 0;
+			*dn = DFPN_INFINITY;
+		}
+		else {
+			*pn = DFPN_INFINITY;
+			*dn = 0;
+		}
+		*pathply = DFPN_MAXPLY;
+		dfpn_store(key, *pn, *dn, work);
+		return(work);
+	}
+
+	s->path[ply] = s->ctx->hashkey;
+	for (i = 0; i < n; i++) {
+		childkey[i] = s->ctx->hashkey ^ hashmove(movelist[i]);
+		local[i] = 0;
+	}
+
+	for (;;) {
+		/*----------> proof and disproof numbers of the children */
+		for (i = 0; i < n; i++) {
+			int j;
+
+			if (local[i])
+				continue;
+			for (j = ply - 1; j >= 0 && s->path[j] != childkey[i]; j--)
+				;
+			cpathply[i] = DFPN_MAXPLY;
+			if (j >= 0 || ply + 1 >= DFPN_MAXPLY) {
+				cpn[i] = DFPN_INFINITY;
+				cdn[i] = 0;
+				cpathply[i] = j;
+			}
+			else if (!dfpn_lookup(childkey[i] ^ s->attackerkey, &cpn[i], &cdn[i])) {
+				cpn[i] = 1;
+				cdn[i] = 1;
+			}
+		}
+
+		/*----------> this node, and the child to expand with the second best
+		  ----------> child's number as its threshold */
+		best = 0;
+		second = DFPN_INFINITY;
+		if (ornode) {
+			*pn = DFPN_INFINITY;
+			*dn = 0;
+			for (i = 0; i < n; i++) {
+				*dn = dfpn_add(*dn, cdn[i]);
+				if (cpn[i] < *pn) {
+					second = *pn;
+					*pn = cpn[i];
+					best = i;
+				}
+				else if (cpn[i] < second)
+					second = cpn[i];
+			}
+		}
+		else {
+			*pn = 0;
+			*dn = DFPN_INFINITY;
+			for (i = 0; i < n; i++) {
+				*pn = dfpn_add(*pn, cpn[i]);
+				if (cdn[i] < *dn) {
+					second = *dn;
+					*dn = cdn[i];
+					best = i;
+				}
+				else if (cdn[i] < second)
+					second = cdn[i];
+			}
+		}
+
+		if (*pn >= thpn || *dn >= thdn || s->stop || s->ctx->play->load(std::memory_order_relaxed))
+			break;
+
+		if (ornode) {
+			cthpn = std::min(thpn, dfpn_add(second, 1));
+			cthdn = thdn - *dn + cdn[best];
+		}
+		else {
+			cthpn = thpn - *pn + cpn[best];
+			cthdn = std::min(thdn, dfpn_add(second, 1));
+		}
+
+		evalupdate(&s->ctx->eval, p, movelist[best]);
+		dobitmove(p, movelist[best]);
+		s->ctx->hashkey = childkey[best];
+		work += dfpn_mid(s, p, CB_CHANGECOLOR(color), ply + 1, cthpn, cthdn, &cpn[best], &cdn[best], &cpathply[best]);
+		undobitmove(p, movelist[best]);
+		s->ctx->hashkey = s->path[ply];
+		s->ctx->eval = evalstate;
+		if (cdn[best] == 0 && cpathply[best] <= ply)
+			local[best] = 1;
+	}
+
+	/*----------> a disproof holds where all disproofs of the attacker's
+	  ----------> moves hold, or where one of the defender's does */
+	*pathply = DFPN_MAXPLY;
+	if (*dn == 0) {
+		if (!ornode)
+			*pathply = -1;
+		for (i = 0; i < n; i++) {
+			if (ornode)
+				*pathply = std::min(*pathply, cpathply[i]);
+			else if (cdn[i] == 0)
+				*pathply = std::max(*pathply, cpathply[i]);
+		}
+	}
+	if (ply == 0) {
+		s->rootmove = movelist[best];
+		s->rootmoves = 1;
+	}
+	if (*dn != 0 || *pathply >= ply)
+		dfpn_store(key, *pn, *dn, work);
+	return(work);
+}
+
+static int dfpn_prove(DFPNSEARCH *s, pos *p, int color, int attacker)
+{
+	/* try to prove that attacker wins p. returns 1 if proven, 0 if
+	   disproven, -1 if the time ran out or the disproof needs a line which
+	   was cut off */
+	int pn, dn, pathply;
+
+	s->attacker = attacker;
+	s->attackerkey = attacker == WHITE ? DFPN_WHITEATTACKS : 0;
+	s->rootmoves = 0;
+	dfpn_mid(s, p, color, 0, DFPN_INFINITY, DFPN_INFINITY, &pn, &dn, &pathply);
+	if (pn == 0)
+		return(1);
+	if (dn == 0 && pathply >= 0)
+		return(0);
+	return(-1);
+}
+
+static int dfpn_proofsize(DFPNSEARCH *s, pos *p, int color, int proof, std::unordered_set<uint64_t> &seen)
+{
+	/* number of positions in the proof (proof = 1) or disproof (proof = 0)
+	   tree of p, as far as it is still in the table: where one child
+	   suffices, the first one which is proven is followed. */
+	int i, n, pn, dn, size = 1, all;
+	bitmove movelist[MAXMOVES];
+	uint64_t hashkey = s->ctx->hashkey;
+
+	if (seen.size() >= DFPN_MAXPROOFSIZE || !seen.insert(hashkey).second)
+		return(0);
+	if (!dfpn_lookup(hashkey ^ s->attackerkey, &pn, &dn) || (proof ? pn : dn) != 0)
+		return(1);
+	if (s->ctx->tables && bitcount(p->bm | p->bk | p->wm | p->wk) <= dbprobepieces)
+		return(1);
+
+	if (testbitcapture(p, color))
+		n = generatebitcapturelist(p, movelist, color);
+	else
+		n = generatebitmovelist(p, movelist, color);
+
+	/* a proof needs all moves of the defender, a disproof all of the attacker */
+	all = (color == s->attacker) != proof;
+	for (i = 0; i < n; i++) {
+		s->ctx->hashkey = hashkey ^ hashmove(movelist[i]);
+		if (!all && (!dfpn_lookup(s->ctx->hashkey ^ s->attackerkey, &pn, &dn) || (proof ? pn : dn) != 0))
+			continue;
+		dobitmove(p, movelist[i]);
+		size += dfpn_proofsize(s, p, CB_CHANGECOLOR(color), proof, seen);
+		undobitmove(p, movelist[i]);
+		if (!all)
+			break;
+	}
+	s->ctx->hashkey = hashkey;
+	return(size);
+}
+
+static int dfpn_bestmove(DFPNSEARCH *s, pos *p, int color, int proof, bitmove *best)
+{
+	/* find a root move which keeps the proof (proof = 1) or disproof. if
+	   all moves are proven wins for the attacker, the one which took the
+	   most work, as it is probably the longest. returns 0 if no move is
+	   in the table any more. */
+	int i, n, pn, dn, logwork, most = -1;
+	bitmove movelist[MAXMOVES];
+
+	if (testbitcapture(p, color))
+		n = generatebitcapturelist(p, movelist, color);
+	else
+		n = generatebitmovelist(p, movelist, color);
+	for (i = 0; i < n; i++) {
+		if (!dfpn_lookup(s->ctx->hashkey ^ hashmove(movelist[i]) ^ s->attackerkey, &pn, &dn, &logwork)
+			|| (proof ? pn : dn) != 0)
+			continue;
+		if (color != s->attacker && proof) {
+			if (logwork > most) {
+				most = logwork;
+				*best = movelist[i];
+			}
+			continue;
+		}
+		*best = movelist[i];
+		return(1);
+	}
+	return(most >= 0);
+}
+
+int solve(SearchContext *ctx, pos *p, int color, double maxtime, char *str, int *solved)
+/*----------> purpose: solve mode. prove with a df-pn search that p is a win,
+  ---------->          loss or draw for color: first try to prove that color
+  ---------->          wins, then that the opponent wins. if both wins are
+  ---------->          disproven, the position is a draw. a move which keeps
+  ---------->          the result is played. if no proof or disproof is found
+  ---------->          in half of the time, the normal search chooses the move.
+  ----------> returns the value of the position like checkers(), *solved is set
+  ----------> if it was proven.
+  ----------> version: 1.1
+  ----------> date: 17th october 2026 */
+{
+	int win, loss = 0, value, size = 0, found;
+	double t;
+	bitmove best;
+	char result[16], str2[80];
+	DFPNSEARCH s;
+	std::unordered_set<uint64_t> seen;
+
+	*solved = 0;
+	{
+		std::lock_guard<std::mutex> lock(dfpnmutex);
+
+		if (!dfpn_allocate())
+			return(checkers(ctx, p, color, maxtime, str));
+	}
+
+	/* leave half of the time to the search if the proof fails */
+	s.ctx = ctx;
+	s.maxtime = maxtime / 2;
+	s.stop = 0;
+	win = dfpn_prove(&s, p, color, color);
+	if (win == 0) {
+		/* the disproof of the win is half of the proof of a draw */
+		size = dfpn_proofsize(&s, p, color, 0, seen);
+		seen.clear();
+		loss = dfpn_prove(&s, p, color, CB_CHANGECOLOR(color));
+	}
+	t = searchtime(ctx);
+	if (win == -1 || loss == -1)
+		return(checkers(ctx, p, color, maxtime, str));
+
+	*solved = 1;
+	if (win == 1) {
+		size = dfpn_proofsize(&s, p, color, 1, seen);
+		value = 5000;
+		sprintf(result, "win");
+	}
+	else if (loss == 1) {
+		size = dfpn_proofsize(&s, p, color, 1, seen);
+		value = -5000;
+		sprintf(result, "loss");
+	}
+	else {
+		size += dfpn_proofsize(&s, p, color, 0, seen);
+		value = 0;
+		sprintf(result, "draw");
+	}
+
+	/* disproofs which hold only on the path from the root are not in the
+	   table, the root move which decided the last proof then is played */
+	found = dfpn_bestmove(&s, p, color, win == 1 || loss == 1, &best);
+	if (!found && s.rootmoves) {
+		best = s.rootmove;
+		found = 1;
+	}
+	if (found) {
+		movetonotation(best, str2);
+		dobitmove(p, best);
+	}
+	else {
+		/* the table lost the root moves: search for one, and find out
+		   which one it played */
+		pos q = *p;
+		bitmove movelist[MAXMOVES];
+		int i, n;
+
+		checkers(ctx, p, color, 0, str);
+		if (testbitcapture(&q, color))
+			n = generatebitcapturelist(&q, movelist, color);
+		else
+			n = generatebitmovelist(&q, movelist, color);
+		sprintf(str2, "?");
+		for (i = 0; i < n; i++) {
+			dobitmove(&q, movelist[i]);
+			if (q.bm == p->bm && q.bk == p->bk && q.wm == p->wm && q.wk == p->wk) {
+				movetonotation(movelist[i], str2);
+				break;
+			}
+			undobitmove(&q, movelist[i]);
+		}
+	}
+
+	sprintf(str, "solved: %s, proof %i positions, time %.2fs, nodes %i, %.0f kN/s  best:%s",
+			result, size, t, ctx->alphabetas, t > 0 ? ctx->alphabetas / t / 1000 : 0.0, str2);
+	return(color == BLACK ? value : -value);
+}
+
+/*-------------- PART IIe: GAME HISTORY --------------------------------------*/
+static int fentoposition(const char *fen, pos *p, int *color)
+{
+	/* read a FEN like "B:W21-32:BK1,2,3". returns the position and the side
+	   to move in p and color, or 0 if fen is not a FEN. */
+	int side, king, from, to, square;
+
+	if (*fen == 'B')
+		*color = BLACK;
+	else if (*fen == 'W')
+		*color = WHITE;
+	else
+		return(0);
+	fen++;
+
+	p->bm = 0;
+	p->bk = 0;
+	p->wm = 0;
+	p->wk = 0;
+	while (*fen == ':') {
+		fen++;
+		if (*fen == 'B')
+			side = BLACK;
+		else if (*fen == 'W')
+			side = WHITE;
+		else
+			return(0);
+		fen++;
+
+		while (*fen && *fen != ':' && *fen != ' ' && *fen != '.') {
+			king = 0;
+			if (*fen == 'K') {
+				king = 1;
+				fen++;
+			}
+			if (*fen < '0' || *fen > '9')
+				return(0);
+			from = (int)strtol(fen, (char **)&fen, 10);
+			to = from;
+			if (*fen == '-') {
+				fen++;
+				to = (int)strtol(fen, (char **)&fen, 10);
+			}
+			if (from < 1 || to > 32 || from > to)
+				return(0);
+			for (square = from; square <= to; square++) {
+				if (side == BLACK && king)
+					p->bk |= 1u << bitsquare(square);
+				else if (side == BLACK)
+					p->bm |= 1u << bitsquare(square);
+				else if (king)
+					p->wk |= 1u << bitsquare(square);
+				else
+					p->wm |= 1u << bitsquare(square);
+			}
+			if (*fen == ',')
+				fen++;
+		}
+	}
+	return(1);
+}
+
+static uint32_t pdncaptures(Squarelist &squares)
+{
+	/* the bit squares of the pieces captured by a capture which is written
+	   with all the squares it lands on, like "1x10x19". 0 if squares is not
+	   such a capture. */
+	int i, from, to, row, x, x2;
+	uint32_t captured = 0;
+
+	for (i = 0; i + 1 < squares.size(); i++) {
+		from = squares.read(i) - 1;
+		to = squares.read(i + 1) - 1;
+		if (from < 0 || from > 31 || to < 0 || to > 31 || abs(from / 4 - to / 4) != 2)
+			return(0);
+		/* columns 0-7, squares 1-4 are in row 0 on the odd columns */
+		x = 2 * (from % 4) + ((from / 4) % 2 == 0);
+		x2 = 2 * (to % 4) + ((to / 4) % 2 == 0);
+		if (abs(x - x2) != 2)
+			return(0);
+		row = (from / 4 + to / 4) / 2;
+		captured |= 1u << bitsquare(1 + 4 * row + ((x + x2) / 2 - (row % 2 == 0)) / 2);
+	}
+	return(captured);
+}
+
+int gamehist_set(const char *history)
+/*----------> purpose: read the game history of "set gamehist": a FEN of the
+  ---------->          position after the last irreversible move, followed by
+  ---------->          the moves played since. the hashkeys of all of these
+  ---------->          positions are kept for the repetition test of the next
+  ---------->          search. at most MAXGAMEHISTORY are kept, older positions
+  ---------->          are dropped.
+  ---------->          a move is found by its first and last square. captures
+  ---------->          which those do not tell apart must be written with all
+  ---------->          the squares they land on.
+  ----------> returns 1, or 0 if history can not be read.
+  ----------> version: 1.1
+  ----------> date: 17th october 2026 */
+{
+	char token[256];
+	const char *next;
+	int i, n, color, match;
+	uint32_t captured;
+	Squarelist squares;
+	bitmove movelist[MAXMOVES];
+	std::vector<uint64_t> keys;
+	pos p;
+
+	std::call_once(hashkeysonce, inithashkeys);
+	if (!fentoposition(history, &p, &color))
+		return(0);
+	keys.push_back(hashposition(&p, color));
+
+	next = strchr(history, ' ');
+	while (next && PDNparseGetnextPDNtoken(&next, token, sizeof(token))) {
+		if (PDNparseMove(token, squares) == 0)
+			continue;
+
+		if (testbitcapture(&p, color))
+			n = generatebitcapturelist(&p, movelist, color);
+		else
+			n = generatebitmovelist(&p, movelist, color);
+		captured = pdncaptures(squares);
+		match = -1;
+		for (i = 0; i < n; i++) {
+			if (squarenumber(movelist[i].from) != squares.first() || squarenumber(movelist[i].to) != squares.last())
+				continue;
+			if (captured && (color == BLACK ? movelist[i].wm | movelist[i].wk : movelist[i].bm | movelist[i].bk) != captured)
+				continue;
+			/* two captures with the same first and last square */
+			if (match >= 0)
+				return(0);
+			match = i;
+		}
+		if (match < 0)
+			return(0);
+
+		/* an irreversible move starts the history again */
+		if ((movelist[match].bm | movelist[match].wm) || (movelist[match].bk && movelist[match].wk))
+			keys.clear();
+		dobitmove(&p, movelist[match]);
+		color = CB_CHANGECOLOR(color);
+		keys.push_back(hashposition(&p, color));
+	}
+
+	if ((int)keys.size() > MAXGAMEHISTORY + 1)
+		keys.erase(keys.begin(), keys.end() - (MAXGAMEHISTORY + 1));
+
+	std::lock_guard<std::mutex> lock(gamehistmutex);
+	memcpy(gamehistory, keys.data(), keys.size() * sizeof(uint64_t));
+	gamehistorylength = (int)keys.size();
+	return(1);
+}
+
+void gamehist_newsearch(SearchContext *ctx)
+/*----------> purpose: start the search path of ctx with the game history, if
+  ---------->          it ends in the root position of the search; else the
+  ---------->          history belongs to another game and is not used.
+  ----------> version: 1.0
+  ----------> date: 17th october 2026 */
+{
+	int i, n;
+
+	std::lock_guard<std::mutex> lock(gamehistmutex);
+	n = 0;
+	if (gamehistorylength > 0 && gamehistory[gamehistorylength - 1] == ctx->hashkey)
+		n = gamehistorylength - 1;
+	for (i = 0; i < n; i++) {
+		ctx->pathkeys[i] = gamehistory[i];
+		ctx->reversible[i] = i;
+	}
+	ctx->rootindex = n;
+	ctx->pathkeys[n] = ctx->hashkey;
+	ctx->reversible[n] = n;
+}
+
+/*-------------- PART III: MOVE GENERATION -----------------------------------*/
+int generatemovelist(int b[46], move2 movelist[MAXMOVES], int color)
+/*----------> purpose:generates all moves. no captures. returns number of moves
+  ----------> version: 1.0
+  ----------> date: 25th october 97 */
+{
+	int n = 0, m;
+	int i;
+
+	if (color == BLACK) {
+		for (i = 5; i <= 40; i++) {
+			if ((b[i] & BLACK) != 0) {
+				if ((b[i] & MAN) != 0) {
+					if ((b[i + 4] & FREE) != 0) {
+						movelist[n].n = 2;
+						if (i >= 32)
+							m = (BLACK | KING);
+						else
+							m = (BLACK | MAN);
+						m = m << 8;
+						m += FREE;
+						m = m << 8;
+						m += i + 4;
+						movelist[n].m[1] = m;
+						m = FREE;
+						m = m << 8;
+						m += (BLACK | MAN);
+						m = m << 8;
+						m += i;
+						movelist[n].m[0] = m;
+						n++;
+					}
+
+					if ((b[i + 5] & FREE) != 0) {
+						movelist[n].n = 2;
+						if (i >= 32)
+							m = (BLACK | KING);
+						else
+							m = (BLACK | MAN);
+						m = m << 8;
+						m += FREE;
+						m = m << 8;
+						m += i + 5;
+						movelist[n].m[1] = m;
+						m = FREE;
+						m = m << 8;
+						m += (BLACK | MAN);
+						m = m << 8;
+						m += i;
+						movelist[n].m[0] = m;
+						n++;
+					}
+				}
+
+				if ((b[i] & KING) != 0) {
+					if ((b[i + 4] & FREE) != 0) {
+						movelist[n].n = 2;
+						m = (BLACK | KING);
+						m = m << 8;
+						m += FREE;
+						m = m << 8;
+						m += i + 4;
+						movelist[n].m[1] = m;
+						m = FREE;
+						m = m << 8;
+						m += (BLACK | KING);
+						m = m << 8;
+						m += i;
+						movelist[n].m[0] = m;
+						n++;
+					}
+
+					if ((b[i + 5] & FREE) != 0) {
+						movelist[n].n = 2;
+						m = (BLACK | KING);
+						m = m << 8;
+						m += FREE;
+						m = m << 8;
+						m += i + 5;
+						movelist[n].m[1] = m;
+						m = FREE;
+						m = m << 8;
+						m += (BLACK | KING);
+						m = m << 8;
+						m += i;
+						movelist[n].m[0] = m;
+						n++;
+					}
+
+					if ((b[i - 4] & FREE) != 0) {
+						movelist[n].n = 2;
+						m = (BLACK | KING);
+						m = m << 8;
+						m += FREE;
+						m = m << 8;
+						m += i - 4;
+						movelist[n].m[1] = m;
+						m = FREE;
+						m = m << 8;
+						m += (BLACK | KING);
+						m = m << 8;
+						m += i;
+						movelist[n].m[0] = m;
+						n++;
+					}
+
+					if ((b[i - 5] & FREE) != 0) {
+						movelist[n].n = 2;
+						m = (BLACK | KING);
+						m = m << 8;
+						m += FREE;
+						m = m << 8;
+						m += i - 5;
+						movelist[n].m[1] = m;
+						m = FREE;
+						m = m << 8;
+						m += (BLACK | KING);
+						m = m << 8;
+						m += i;
+						movelist[n].m[0] = m;
+						n++;
+					}
+				}
+			}
+		}
+	}
+	else {
+
+		/* color = WHITE */
+		for (i = 5; i <= 40; i++) {
+			if ((b[i] & WHITE) != 0) {
+				if ((b[i] & MAN) != 0) {
+					if ((b[i - 4] & FREE) != 0) {
+						movelist[n].n = 2;
+						if (i <= 13)
+							m = (WHITE | KING);
+						else
+							m = (WHITE | MAN);
+						m = m << 8;
+						m += FREE;
+						m = m << 8;
+						m += i - 4;
+						movelist[n].m[1] = m;
+						m = FREE;
+						m = m << 8;
+						m += (WHITE | MAN);
+						m = m << 8;
+						m += i;
+						movelist[n].m[0] = m;
+						n++;
+					}
+
+					if ((b[i - 5] & FREE) != 0) {
+						movelist[n].n = 2;
+						if (i <= 13)
+							m = (WHITE | KING);
+						else
+							m = (WHITE | MAN);
+						m = m << 8;
+						m += FREE;
+						m = m << 8;
+						m += i - 5;
+						movelist[n].m[1] = m;
+						m = FREE;
+						m = m << 8;
+						m += (WHITE | MAN);
+						m = m << 8;
+						m += i;
+						movelist[n].m[0] = m;
+						n++;
+					}
+				}
+
+				if ((b[i] & KING) != 0) {
+
+					/* or else */
+					if ((b[i + 4] & FREE) != 0) {
+						movelist[n].n = 2;
+						m = (WHITE | KING);
+						m = m << 8;
+						m += FREE;
+						m = m << 8;
+						m += i + 4;
+						movelist[n].m[1] = m;
+						m = FREE;
+						m = m << 8;
+						m += (WHITE | KING);
+						m = m << 8;
+						m += i;
+						movelist[n].m[0] = m;
+						n++;
+					}
+
+					if ((b[i + 5] & FREE) != 0) {
+						movelist[n].n = 2;
+						m = (WHITE | KING);
+						m = m << 8;
+						m += FREE;
+						m = m << 8;
+						m += i + 5;
+						movelist[n].m[1] = m;
+						m = FREE;
+						m = m << 8;
+						m += (WHITE | KING);
+						m = m << 8;
+						m += i;
+						movelist[n].m[0] = m;
+						n++;
+					}
+
+					if ((b[i - 4] & FREE) != 0) {
+						movelist[n].n = 2;
+						m = (WHITE | KING);
+						m = m << 8;
+						m += FREE;
+						m = m << 8;
+						m += i - 4;
+						movelist[n].m[1] = m;
+						m = FREE;
+						m = m << 8;
+						m += (WHITE | KING);
+						m = m << 8;
+						m += i;
+						movelist[n].m[0] = m;
+						n++;
+					}
+
+					if ((b[i - 5] & FREE) != 0) {
+						movelist[n].n = 2;
+						m = (WHITE | KING);
+						m = m << 8;
+						m += FREE;
+						m = m << 8;
+						m += i - 5;
+						movelist[n].m[1] = m;
+						m = FREE;
+						m = m << 8;
+						m += (WHITE | KING);
+						m = m << 8;
+						m += i;
+						movelist[n].m[0] = m;
+						n++;
+					}
+				}
+			}
+		}
+	}
+
+	return(n);
+}
+
+int generatecapturelist(int b[46], move2 movelist[MAXMOVES], int color)
+/*----------> purpose: generate all possible captures
+  ----------> version: 1.0
+  ----------> date: 25th october 97 */
+{
+	int n = 0;
+	int m;
+	int i;
+	int tmp;
+
+	if (color == BLACK) {
+		for (i = 5; i <= 40; i++) {
+			if ((b[i] & BLACK) != 0) {
+				if ((b[i] & MAN) != 0) {
+					if ((b[i + 4] & WHITE) != 0) {
+						if ((b[i + 8] & FREE) != 0) {
+							movelist[n].n = 3;
+							if (i >= 28)
+								m = (BLACK | KING);
+							else
+								m = (BLACK | MAN);
+							m = m << 8;
+							m += FREE;
+							m = m << 8;
+							m += i + 8;
+							movelist[n].m[1] = m;
+							m = FREE;
+							m = m << 8;
+							m += (BLACK | MAN);
+							m = m << 8;
+							m += i;
+							movelist[n].m[0] = m;
+							m = FREE;
+							m = m << 8;
+							m += b[i + 4];
+							m = m << 8;
+							m += i + 4;
+							movelist[n].m[2] = m;
+							blackmancapture(b, &n, movelist, i + 8);
+						}
+					}
+
+					if ((b[i + 5] & WHITE) != 0) {
+						if ((b[i + 10] & FREE) != 0) {
+							movelist[n].n = 3;
+							if (i >= 28)
+								m = (BLACK | KING);
+							else
+								m = (BLACK | MAN);
+							m = m << 8;
+							m += FREE;
+							m = m << 8;
+							m += i + 10;
+							movelist[n].m[1] = m;
+							m = FREE;
+							m = m << 8;
+							m += (BLACK | MAN);
+							m = m << 8;
+							m += i;
+							movelist[n].m[0] = m;
+							m = FREE;
+							m = m << 8;
+							m += b[i + 5];
+							m = m << 8;
+							m += i + 5;
+							movelist[n].m[2] = m;
+							blackmancapture(b, &n, movelist, i + 10);
+						}
+					}
+				}
+				else {
+
+					/* b[i] is a KING */
+					if ((b[i + 4] & WHITE) != 0) {
+						if ((b[i + 8] & FREE) != 0) {
+							movelist[n].n = 3;
+							m = (BLACK | KING);
+							m = m << 8;
+							m += FREE;
+							m = m << 8;
+							m += i + 8;
+							movelist[n].m[1] = m;
+							m = FREE;
+							m = m << 8;
+							m += (BLACK | KING);
+							m = m << 8;
+							m += i;
+							movelist[n].m[0] = m;
+							m = FREE;
+							m = m << 8;
+							m += b[i + 4];
+							m = m << 8;
+							m += i + 4;
+							movelist[n].m[2] = m;
+							tmp = b[i + 4];
+							b[i + 4] = FREE;	/* Remove captured piece. */
+							b[i] = FREE;		/* Remove capturing king. */
+							blackkingcapture(b, &n, movelist, i + 8);
+							b[i + 4] = tmp;		/* Restore captured piece. */
+							b[i] = BLACK | KING;	/* Restore capturing king. */
+						}
+					}
+
+					if ((b[i + 5] & WHITE) != 0) {
+						if ((b[i + 10] & FREE) != 0) {
+							movelist[n].n = 3;
+							m = (BLACK | KING);
+							m = m << 8;
+							m += FREE;
+							m = m << 8;
+							m += i + 10;
+							movelist[n].m[1] = m;
+							m = FREE;
+							m = m << 8;
+							m += (BLACK | KING);
+							m = m << 8;
+							m += i;
+							movelist[n].m[0] = m;
+							m = FREE;
+							m = m << 8;
+							m += b[i + 5];
+							m = m << 8;
+							m += i + 5;
+							movelist[n].m[2] = m;
+							tmp = b[i + 5];
+							b[i + 5] = FREE;
+							b[i] = FREE;			/* Remove capturing king. */
+							blackkingcapture(b, &n, movelist, i + 10);
+							b[i + 5] = tmp;
+							b[i] = BLACK | KING;	/* Restore capturing king. */
+						}
+					}
+
+					if ((b[i - 4] & WHITE) != 0) {
+						if ((b[i - 8] & FREE) != 0) {
+							movelist[n].n = 3;
+							m = (BLACK | KING);
+							m = m << 8;
+							m += FREE;
+							m = m << 8;
+							m += i - 8;
+							movelist[n].m[1] = m;
+							m = FREE;
+							m = m << 8;
+							m += (BLACK | KING);
+							m = m << 8;
+							m += i;
+							movelist[n].m[0] = m;
+							m = FREE;
+							m = m << 8;
+							m += b[i - 4];
+							m = m << 8;
+							m += i - 4;
+							movelist[n].m[2] = m;
+							tmp = b[i - 4];
+							b[i - 4] = FREE;
+							b[i] = FREE;			/* Remove capturing king. */
+							blackkingcapture(b, &n, movelist, i - 8);
+							b[i - 4] = tmp;
+							b[i] = BLACK | KING;	/* Restore capturing king. */
+						}
+					}
+
+					if ((b[i - 5] & WHITE) != 0) {
+						if ((b[i - 10] & FREE) != 0) {
+							movelist[n].n = 3;
+							m = (BLACK | KING);
+							m = m << 8;
+							m += FREE;
+							m = m << 8;
+							m += i - 10;
+							movelist[n].m[1] = m;
+							m = FREE;
+							m = m << 8;
+							m += (BLACK | KING);
+							m = m << 8;
+							m += i;
+							movelist[n].m[0] = m;
+							m = FREE;
+							m = m << 8;
+							m += b[i - 5];
+							m = m << 8;
+							m += i - 5;
+							movelist[n].m[2] = m;
+							tmp = b[i - 5];
+							b[i - 5] = FREE;
+							b[i] = FREE;			/* Remove capturing king. */
+							blackkingcapture(b, &n, movelist, i - 10);
+							b[i - 5] = tmp;
+							b[i] = BLACK | KING;	/* Restore capturing king. */
+						}
+					}
+				}
+			}
+		}
+	}
+	else {
+
+		/* color is WHITE */
+		for (i = 5; i <= 40; i++) {
+			if ((b[i] & WHITE) != 0) {
+				if ((b[i] & MAN) != 0) {
+					if ((b[i - 4] & BLACK) != 0) {
+						if ((b[i - 8] & FREE) != 0) {
+							movelist[n].n = 3;
+							if (i <= 17)
+								m = (WHITE | KING);
+							else
+								m = (WHITE | MAN);
+							m = m << 8;
+							m += FREE;
+							m = m << 8;
+							m += i - 8;
+							movelist[n].m[1] = m;
+							m = FREE;
+							m = m << 8;
+							m += (WHITE | MAN);
+							m = m << 8;
+							m += i;
+							movelist[n].m[0] = m;
+							m = FREE;
+							m = m << 8;
+							m += b[i - 4];
+							m = m << 8;
+							m += i - 4;
+							movelist[n].m[2] = m;
+							whitemancapture(b, &n, movelist, i - 8);
+						}
+					}
+
+					if ((b[i - 5] & BLACK) != 0) {
+						if ((b[i - 10] & FREE) != 0) {
+							movelist[n].n = 3;
+							if (i <= 17)
+								m = (WHITE | KING);
+							else
+								m = (WHITE | MAN);
+							m = m << 8;
+							m += FREE;
+							m = m << 8;
+							m += i - 10;
+							movelist[n].m[1] = m;
+							m = FREE;
+							m = m << 8;
+							m += (WHITE | MAN);
+							m = m << 8;
+							m += i;
+							movelist[n].m[0] = m;
+							m = FREE;
+							m = m << 8;
+							m += b[i - 5];
+							m = m << 8;
+							m += i - 5;
+							movelist[n].m[2] = m;
+							whitemancapture(b, &n, movelist, i - 10);
+						}
+					}
+				}
+				else {
+
+					/* b[i] is a KING */
+					if ((b[i + 4] & BLACK) != 0) {
+						if ((b[i + 8] & FREE) != 0) {
+							movelist[n].n = 3;
+							m = (WHITE | KING);
+							m = m << 8;
+							m += FREE;
+							m = m << 8;
+							m += i + 8;
+							movelist[n].m[1] = m;
+							m = FREE;
+							m = m << 8;
+							m += (WHITE | KING);
+							m = m << 8;
+							m += i;
+							movelist[n].m[0] = m;
+							m = FREE;
+							m = m << 8;
+							m += b[i + 4];
+							m = m << 8;
+							m += i + 4;
+							movelist[n].m[2] = m;
+							tmp = b[i + 4];
+							b[i + 4] = FREE;
+							b[i] = FREE;			/* Remove capturing king. */
+							whitekingcapture(b, &n, movelist, i + 8);
+							b[i + 4] = tmp;
+							b[i] = WHITE | KING;
+						}
+					}
+
+					if ((b[i + 5] & BLACK) != 0) {
+						if ((b[i + 10] & FREE) != 0) {
+							movelist[n].n = 3;
+							m = (WHITE | KING);
+							m = m << 8;
+							m += FREE;
+							m = m << 8;
+							m += i + 10;
+							movelist[n].m[1] = m;
+							m = FREE;
+							m = m << 8;
+							m += (WHITE | KING);
+							m = m << 8;
+							m += i;
+							movelist[n].m[0] = m;
+							m = FREE;
+							m = m << 8;
+							m += b[i + 5];
+							m = m << 8;
+							m += i + 5;
+							movelist[n].m[2] = m;
+							tmp = b[i + 5];
+							b[i + 5] = FREE;
+							b[i] = FREE;			/* Remove capturing king. */
+							whitekingcapture(b, &n, movelist, i + 10);
+							b[i + 5] = tmp;
+							b[i] = WHITE | KING;
+						}
+					}
+
+					if ((b[i - 4] & BLACK) != 0) {
+						if ((b[i - 8] & FREE) != 0) {
+							movelist[n].n = 3;
+							m = (WHITE | KING);
+							m = m << 8;
+							m += FREE;
+							m = m << 8;
+							m += i - 8;
+							movelist[n].m[1] = m;
+							m = FREE;
+							m = m << 8;
+							m += (WHITE | KING);
+							m = m << 8;
+							m += i;
+							movelist[n].m[0] = m;
+							m = FREE;
+							m = m << 8;
+							m += b[i - 4];
+							m = m << 8;
+							m += i - 4;
+							movelist[n].m[2] = m;
+							tmp = b[i - 4];
+							b[i - 4] = FREE;
+							b[i] = FREE;			/* Remove capturing king. */
+							whitekingcapture(b, &n, movelist, i - 8);
+							b[i - 4] = tmp;
+							b[i] = WHITE | KING;
+						}
+					}
+
+					if ((b[i - 5] & BLACK) != 0) {
+						if ((b[i - 10] & FREE) != 0) {
+							movelist[n].n = 3;
+							m = (WHITE | KING);
+							m = m << 8;
+							m += FREE;
+							m = m << 8;
+							m += i - 10;
+							movelist[n].m[1] = m;
+							m = FREE;
+							m = m << 8;
+							m += (WHITE | KING);
+							m = m << 8;
+							m += i;
+							movelist[n].m[0] = m;
+							m = FREE;
+							m = m << 8;
+							m += b[i - 5];
+							m = m << 8;
+							m += i - 5;
+							movelist[n].m[2] = m;
+							tmp = b[i - 5];
+							b[i - 5] = FREE;
+							b[i] = FREE;			/* Remove capturing king. */
+							whitekingcapture(b, &n, movelist, i - 10);
+							b[i - 5] = tmp;
+							b[i] = WHITE | KING;
+						}
+					}
+				}
+			}
+		}
+	}
+
+	return(n);
+}
+
+void blackmancapture(int b[46], int *n, move2 movelist[MAXMOVES], int i)
+{
+	int m;
+	int found = 0;
+	move2 move, orgmove;
+
+	orgmove = movelist[*n];
+	move = orgmove;
+
+	if ((b[i + 4] & WHITE) != 0) {
+		if ((b[i + 8] & FREE) != 0) {
+			move.n++;
+			if (i >= 28)
+				m = (BLACK | KING);
+			else
+				m = (BLACK | MAN);
+			m = m << 8;
+			m += FREE;
+			m = m << 8;
+			m += (i + 8);
+			move.m[1] = m;
+			m = FREE;
+			m = m << 8;
+			m += b[i + 4];
+			m = m << 8;
+			m += (i + 4);
+			move.m[move.n - 1] = m;
+			found = 1;
+			movelist[*n] = move;
+			blackmancapture(b, n, movelist, i + 8);
+		}
+	}
+
+	move = orgmove;
+	if ((b[i + 5] & WHITE) != 0) {
+		if ((b[i + 10] & FREE) != 0) {
+			move.n++;
+			if (i >= 28)
+				m = (BLACK | KING);
+			else
+				m = (BLACK | MAN);
+			m = m << 8;
+			m += FREE;
+			m = m << 8;
+			m += (i + 10);
+			move.m[1] = m;
+			m = FREE;
+			m = m << 8;
+			m += b[i + 5];
+			m = m << 8;
+			m += (i + 5);
+			move.m[move.n - 1] = m;
+			found = 1;
+			movelist[*n] = move;
+			blackmancapture(b, n, movelist, i + 10);
+		}
+	}
+
+	if (!found)
+		(*n)++;
+}
+
+void blackkingcapture(int b[46], int *n, move2 movelist[MAXMOVES], int i)
+{
+	int m;
+	int tmp;
+	int found = 0;
+	move2 move, orgmove;
+
+	orgmove = movelist[*n];
+	move = orgmove;
+
+	if ((b[i - 4] & WHITE) != 0) {
+		if ((b[i - 8] & FREE) != 0) {
+			move.n++;
+			m = (BLACK | KING);
+			m = m << 8;
+			m += FREE;
+			m = m << 8;
+			m += i - 8;
+			move.m[1] = m;
+			m = FREE;
+			m = m << 8;
+			m += b[i - 4];
+			m = m << 8;
+			m += i - 4;
+			move.m[move.n - 1] = m;
+			found = 1;
+			movelist[*n] = move;
+			tmp = b[i - 4];
+			b[i - 4] = FREE;
+			blackkingcapture(b, n, movelist, i - 8);
+			b[i - 4] = tmp;
+		}
+	}
+
+	move = orgmove;
+	if ((b[i - 5] & WHITE) != 0) {
+		if ((b[i - 10] & FREE) != 0) {
+			move.n++;
+			m = (BLACK | KING);
+			m = m << 8;
+			m += FREE;
+			m = m << 8;
+			m += i - 10;
+			move.m[1] = m;
+			m = FREE;
+			m = m << 8;
+			m += b[i - 5];
+			m = m << 8;
+			m += i - 5;
+			move.m[move.n - 1] = m;
+			found = 1;
+			movelist[*n] = move;
+			tmp = b[i - 5];
+			b[i - 5] = FREE;
+			blackkingcapture(b, n, movelist, i - 10);
+			b[i - 5] = tmp;
+		}
+	}
+
+	move = orgmove;
+	if ((b[i + 4] & WHITE) != 0) {
+		if ((b[i + 8] & FREE) != 0) {
+			move.n++;
+			m = (BLACK | KING);
+			m = m << 8;
+			m += FREE;
+			m = m << 8;
+			m += i + 8;
+			move.m[1] = m;
+			m = FREE;
+			m = m << 8;
+			m += b[i + 4];
+			m = m << 8;
+			m += i + 4;
+			move.m[move.n - 1] = m;
+			found = 1;
+			movelist[*n] = move;
+			tmp = b[i + 4];
+			b[i + 4] = FREE;
+			blackkingcapture(b, n, movelist, i + 8);
+			b[i + 4] = tmp;
+		}
+	}
+
+	move = orgmove;
+	if ((b[i + 5] & WHITE) != 0) {
+		if ((b[i + 10] & FREE) != 0) {
+			move.n++;
+			m = (BLACK | KING);
+			m = m << 8;
+			m += FREE;
+			m = m << 8;
+			m += i + 10;
+			move.m[1] = m;
+			m = FREE;
+			m = m << 8;
+			m += b[i + 5];
+			m = m << 8;
+			m += i + 5;
+			move.m[move.n - 1] = m;
+			found = 1;
+			movelist[*n] = move;
+			tmp = b[i + 5];
+			b[i + 5] = FREE;
+			blackkingcapture(b, n, movelist, i + 10);
+			b[i + 5] = tmp;
+		}
+	}
+
+	if (!found)
+		(*n)++;
+}
+
+void whitemancapture(int b[46], int *n, move2 movelist[MAXMOVES], int i)
+{
+	int m;
+	int found = 0;
+	move2 move, orgmove;
+
+	orgmove = movelist[*n];
+	move = orgmove;
+
+	if ((b[i - 4] & BLACK) != 0) {
+		if ((b[i - 8] & FREE) != 0) {
+			move.n++;
+			if (i <= 17)
+				m = (WHITE | KING);
+			else
+				m = (WHITE | MAN);
+			m = m << 8;
+			m += FREE;
+			m = m << 8;
+			m += i - 8;
+			move.m[1] = m;
+			m = FREE;
+			m = m << 8;
+			m += b[i - 4];
+			m = m << 8;
+			m += i - 4;
+			move.m[move.n - 1] = m;
+			found = 1;
+			movelist[*n] = move;
+			whitemancapture(b, n, movelist, i - 8);
+		}
+	}
+
+	move = orgmove;
+	if ((b[i - 5] & BLACK) != 0) {
+		if ((b[i - 10] & FREE) != 0) {
+			move.n++;
+			if (i <= 17)
+				m = (WHITE | KING);
+			else
+				m = (WHITE | MAN);
+			m = m << 8;
+			m += FREE;
+			m = m << 8;
+			m += i - 10;
+			move.m[1] = m;
+			m = FREE;
+			m = m << 8;
+			m += b[i - 5];
+			m = m << 8;
+			m += i - 5;
+			move.m[move.n - 1] = m;
+			found = 1;
+			movelist[*n] = move;
+			whitemancapture(b, n, movelist, i - 10);
+		}
+	}
+
+	if (!found)
+		(*n)++;
+}
+
+void whitekingcapture(int b[46], int *n, move2 movelist[MAXMOVES], int i)
+{
+	int m;
+	int tmp;
+	int found = 0;
+	move2 move, orgmove;
+
+	orgmove = movelist[*n];
+	move = orgmove;
+
+	if ((b[i - 4] & BLACK) != 0) {
+		if ((b[i - 8] & FREE) != 0) {
+			move.n++;
+			m = (WHITE | KING);
+			m = m << 8;
+			m += FREE;
+			m = m << 8;
+			m += i - 8;
+			move.m[1] = m;
+			m = FREE;
+			m = m << 8;
+			m += b[i - 4];
+			m = m << 8;
+			m += i - 4;
+			move.m[move.n - 1] = m;
+			found = 1;
+			movelist[*n] = move;
+			tmp = b[i - 4];
+			b[i - 4] = FREE;
+			whitekingcapture(b, n, movelist, i - 8);
+			b[i - 4] = tmp;
+		}
+	}
+
+	move = orgmove;
+	if ((b[i - 5] & BLACK) != 0) {
+		if ((b[i - 10] & FREE) != 0) {
+			move.n++;
+			m = (WHITE | KING);
+			m = m << 8;
+			m += FREE;
+			m = m << 8;
+			m += i - 10;
+			move.m[1] = m;
+			m = FREE;
+			m = m << 8;
+			m += b[i - 5];
+			m = m << 8;
+			m += i - 5;
+			move.m[move.n - 1] = m;
+			found = 1;
+			movelist[*n] = move;
+			tmp = b[i - 5];
+			b[i - 5] = FREE;
+			whitekingcapture(b, n, movelist, i - 10);
+			b[i - 5] = tmp;
+		}
+	}
+
+	move = orgmove;
+	if ((b[i + 4] & BLACK) != 0) {
+		if ((b[i + 8] & FREE) != 0) {
+			move.n++;
+			m = (WHITE | KING);
+			m = m << 8;
+			m += FREE;
+			m = m << 8;
+			m += i + 8;
+			move.m[1] = m;
+			m = FREE;
+			m = m << 8;
+			m += b[i + 4];
+			m = m << 8;
+			m += i + 4;
+			move.m[move.n - 1] = m;
+			found = 1;
+			movelist[*n] = move;
+			tmp = b[i + 4];
+			b[i + 4] = FREE;
+			whitekingcapture(b, n, movelist, i + 8);
+			b[i + 4] = tmp;
+		}
+	}
+
+	move = orgmove;
+	if ((b[i + 5] & BLACK) != 0) {
+		if ((b[i + 10] & FREE) != 0) {
+			move.n++;
+			m = (WHITE | KING);
+			m = m << 8;
+			m += FREE;
+			m = m << 8;
+			m += i + 10;
+			move.m[1] = m;
+			m = FREE;
+			m = m << 8;
+			m += b[i + 5];
+			m = m << 8;
+			m += i + 5;
+			move.m[move.n - 1] = m;
+			found = 1;
+			movelist[*n] = move;
+			tmp = b[i + 5];
+			b[i + 5] = FREE;
+			whitekingcapture(b, n, movelist, i + 10);
+			b[i + 5] = tmp;
+		}
+	}
+
+	if (!found)
+		(*n)++;
+}
+
+int testcapture(int b[46], int color)
+/*----------> purpose: test if color has a capture on b
+  ----------> version: 1.0
+  ----------> date: 25th october 97 */
+{
+	int i;
+
+	if (color == BLACK) {
+		for (i = 5; i <= 40; i++) {
+			if ((b[i] & BLACK) != 0) {
+				if ((b[i] & MAN) != 0) {
+					if ((b[i + 4] & WHITE) != 0) {
+						if ((b[i + 8] & FREE) != 0)
+							return(1);
+					}
+
+					if ((b[i + 5] & WHITE) != 0) {
+						if ((b[i + 10] & FREE) != 0)
+							return(1);
+					}
+				}
+				else {
+
+					/* b[i] is a KING */
+					if ((b[i + 4] & WHITE) != 0) {
+						if ((b[i + 8] & FREE) != 0)
+							return(1);
+					}
+
+					if ((b[i + 5] & WHITE) != 0) {
+						if ((b[i + 10] & FREE) != 0)
+							return(1);
+					}
+
+					if ((b[i - 4] & WHITE) != 0) {
+						if ((b[i - 8] & FREE) != 0)
+							return(1);
+					}
+
+					if ((b[i - 5] & WHITE) != 0) {
+						if ((b[i - 10] & FREE) != 0)
+							return(1);
+					}
+				}
+			}
+		}
+	}
+	else {
+
+		/* color is WHITE */
+		for (i = 5; i <= 40; i++) {
+			if ((b[i] & WHITE) != 0) {
+				if ((b[i] & MAN) != 0) {
+					if ((b[i - 4] & BLACK) != 0) {
+						if ((b[i - 8] & FREE) != 0)
+							return(1);
+					}
+
+					if ((b[i - 5] & BLACK) != 0) {
+						if ((b[i - 10] & FREE) != 0)
+							return(1);
+					}
+				}
+				else {
+
+					/* b[i] is a KING */
+					if ((b[i + 4] & BLACK) != 0) {
+						if ((b[i + 8] & FREE) != 0)
+							return(1);
+					}
+
+					if ((b[i + 5] & BLACK) != 0) {
+						if ((b[i + 10] & FREE) != 0)
+							return(1);
+					}
+
+					if ((b[i - 4] & BLACK) != 0) {
+						if ((b[i - 8] & FREE) != 0)
+							return(1);
+					}
+
+					if ((b[i - 5] & BLACK) != 0) {
+						if ((b[i - 10] & FREE) != 0)
+							return(1);
+					}
+				}
+			}
+		}
+	}
+
+	return(0);
+}
+
+
+/*-------------- PART IIIb: BITBOARD MOVE GENERATION -------------------------*/
+/* the bitboard generator works on all pieces of one kind at once: shifting a
+   bitboard by one step in a direction gives the squares all these pieces
+   would move to. on even rows (squares 0-3, 8-11, ...) the neighbours are at
+   +3/+4 upwards and -4/-5 downwards, on odd rows at +4/+5 and -3/-4. the masks
+   remove the pieces on the side of the board which have no neighbour in that
+   direction. up is towards white. */
+#define EVENROWS 0x0f0f0f0f
+#define ODDROWS 0xf0f0f0f0
+#define LEFTOUT 0x0e0e0e0e		/* even rows without the left column */
+#define RIGHTOUT 0x70707070		/* odd rows without the right column */
+#define BLACKKINGROW 0xf0000000	/* row where black men are crowned */
+#define WHITEKINGROW 0x0000000f	/* row where white men are crowned */
+
+static inline unsigned int upleft(unsigned int x)
+{
+	return(((x & LEFTOUT) << 3) | ((x & ODDROWS) << 4));
+}
+
+static inline unsigned int upright(unsigned int x)
+{
+	return(((x & EVENROWS) << 4) | ((x & RIGHTOUT) << 5));
+}
+
+static inline unsigned int downleft(unsigned int x)
+{
+	return(((x & LEFTOUT) >> 5) | ((x & ODDROWS) >> 4));
+}
+
+static inline unsigned int downright(unsigned int x)
+{
+	return(((x & EVENROWS) >> 4) | ((x & RIGHTOUT) >> 3));
+}
+
+static inline unsigned int step(unsigned int x, int direction)
+{
+	switch (direction) {
+	case 0:
+		return(upleft(x));
+
+	case 1:
+		return(upright(x));
+
+	case 2:
+		return(downleft(x));
+
+	default:
+		return(downright(x));
+	}
+}
+
+static inline int addbitmoves(bitmove movelist[MAXMOVES], int n, unsigned int dest, int direction, int color, int king)
+/*----------> purpose: add one move for every square in dest, which the pieces
+  ---------->          reached by one step in direction. returns the new n.
+  ----------> version: 1.0
+  ----------> date: 17th october 2026 */
+{
+	unsigned int from, to, promote;
+	bitmove *m;
+
+	while (dest) {
+		to = dest & (0 - dest);
+		dest &= dest - 1;
+
+		/* step back: up and down are swapped by xor 3 */
+		from = step(to, direction ^ 3);
+		m = &movelist[n++];
+		m->bm = m->bk = m->wm = m->wk = 0;
+		m->from = (char)lsb(from);
+		m->to = (char)lsb(to);
+		if (color == BLACK) {
+			promote = to & BLACKKINGROW;
+			if (king)
+				m->bk = from | to;
+			else {
+				m->bm = from | (to & ~promote);
+				m->bk = promote;
+			}
+		}
+		else {
+			promote = to & WHITEKINGROW;
+			if (king)
+				m->wk = from | to;
+			else {
+				m->wm = from | (to & ~promote);
+				m->wk = promote;
+			}
+		}
+	}
+	return(n);
+}
+
+int generatebitmovelist(pos *p, bitmove movelist[MAXMOVES], int color)
+/*----------> purpose: generates all moves. no captures. returns number of moves
+  ----------> version: 1.0
+  ----------> date: 17th october 2026 */
+{
+	int n = 0;
+	unsigned int empty;
+
+	empty = ~(p->bm | p->bk | p->wm | p->wk);
+	if (color == BLACK) {
+		if (p->bk) {
+			n = addbitmoves(movelist, n, upleft(p->bk) & empty, 0, BLACK, 1);
+			n = addbitmoves(movelist, n, upright(p->bk) & empty, 1, BLACK, 1);
+			n = addbitmoves(movelist, n, downleft(p->bk) & empty, 2, BLACK, 1);
+			n = addbitmoves(movelist, n, downright(p->bk) & empty, 3, BLACK, 1);
+		}
+		n = addbitmoves(movelist, n, upleft(p->bm) & empty, 0, BLACK, 0);
+		n = addbitmoves(movelist, n, upright(p->bm) & empty, 1, BLACK, 0);
+	}
+	else {
+		if (p->wk) {
+			n = addbitmoves(movelist, n, upleft(p->wk) & empty, 0, WHITE, 1);
+			n = addbitmoves(movelist, n, upright(p->wk) & empty, 1, WHITE, 1);
+			n = addbitmoves(movelist, n, downleft(p->wk) & empty, 2, WHITE, 1);
+			n = addbitmoves(movelist, n, downright(p->wk) & empty, 3, WHITE, 1);
+		}
+		n = addbitmoves(movelist, n, downleft(p->wm) & empty, 2, WHITE, 0);
+		n = addbitmoves(movelist, n, downright(p->wm) & empty, 3, WHITE, 0);
+	}
+
+	return(n);
+}
+
+static void bitcapture(pos *p, int *n, bitmove movelist[MAXMOVES], int color, int king,
+				unsigned int from, unsigned int square, unsigned int captured, unsigned int empty)
+/*----------> purpose: continue a capture of the piece that started on from
+  ---------->          and now stands on square, having captured the pieces in
+  ---------->          captured. adds a move when no further capture is possible.
+  ----------> version: 1.0
+  ----------> date: 17th october 2026 */
+{
+	int direction, first, last;
+	int found = 0;
+	unsigned int opponent, over, land, promote;
+	bitmove *m;
+
+	if (color == BLACK) {
+		opponent = (p->wm | p->wk) & ~captured;
+		first = 0;
+		last = king ? 3 : 1;
+	}
+	else {
+		opponent = (p->bm | p->bk) & ~captured;
+		first = king ? 0 : 2;
+		last = 3;
+	}
+
+	for (direction = first; direction <= last; direction++) {
+		over = step(square, direction) & opponent;
+		if (over) {
+			land = step(over, direction) & empty;
+			if (land) {
+				found = 1;
+				bitcapture(p, n, movelist, color, king, from, land, captured | over, empty);
+			}
+		}
+	}
+
+	if (found || *n >= MAXMOVES)
+		return;
+
+	m = &movelist[(*n)++];
+	m->from = (char)lsb(from);
+	m->to = (char)lsb(square);
+	if (color == BLACK) {
+		m->wm = captured & p->wm;
+		m->wk = captured & p->wk;
+		promote = square & BLACKKINGROW;
+		if (king) {
+			m->bm = 0;
+			m->bk = from ^ square;
+		}
+		else {
+			m->bm = from | (square & ~promote);
+			m->bk = promote;
+		}
+	}
+	else {
+		m->bm = captured & p->bm;
+		m->bk = captured & p->bk;
+		promote = square & WHITEKINGROW;
+		if (king) {
+			m->wm = 0;
+			m->wk = from ^ square;
+		}
+		else {
+			m->wm = from | (square & ~promote);
+			m->wk = promote;
+		}
+	}
+}
+
+static inline unsigned int bitjumpers(unsigned int pieces, unsigned int opponent, unsigned int empty, int direction)
+{
+	/* pieces which can capture in direction: one step is an opponent piece,
+	   the step after that is empty. */
+	return(pieces & step(step(empty, direction ^ 3) & opponent, direction ^ 3));
+}
+
+int generatebitcapturelist(pos *p, bitmove movelist[MAXMOVES], int color)
+/*----------> purpose: generate all possible captures
+  ----------> version: 1.0
+  ----------> date: 17th october 2026 */
+{
+	int n = 0;
+	unsigned int empty, opponent, men, kings, piece;
+
+	empty = ~(p->bm | p->bk | p->wm | p->wk);
+	if (color == BLACK) {
+		opponent = p->wm | p->wk;
+		men = bitjumpers(p->bm, opponent, empty, 0) | bitjumpers(p->bm, opponent, empty, 1);
+		kings = p->bk;
+	}
+	else {
+		opponent = p->bm | p->bk;
+		men = bitjumpers(p->wm, opponent, empty, 2) | bitjumpers(p->wm, opponent, empty, 3);
+		kings = p->wk;
+	}
+	if (kings)
+		kings = bitjumpers(kings, opponent, empty, 0) | bitjumpers(kings, opponent, empty, 1) |
+				bitjumpers(kings, opponent, empty, 2) | bitjumpers(kings, opponent, empty, 3);
+
+	while (kings) {
+		piece = kings & (0 - kings);
+		kings &= kings - 1;
+
+		/* the capturing king has left its square */
+		bitcapture(p, &n, movelist, color, 1, piece, piece, 0, empty | piece);
+	}
+
+	while (men) {
+		piece = men & (0 - men);
+		men &= men - 1;
+		bitcapture(p, &n, movelist, color, 0, piece, piece, 0, empty);
+	}
+
+	return(n);
+}
+
+int testbitcapture(pos *p, int color)
+/*----------> purpose: test if color has a capture on p
+  ----------> version: 1.0
+  ----------> date: 17th october 2026 */
+{
+	unsigned int empty, opponent;
+
+	empty = ~(p->bm | p->bk | p->wm | p->wk);
+	if (color == BLACK) {
+		opponent = p->wm | p->wk;
+		if (bitjumpers(p->bm | p->bk, opponent, empty, 0) | bitjumpers(p->bm | p->bk, opponent, empty, 1))
+			return(1);
+		if (p->bk && (bitjumpers(p->bk, opponent, empty, 2) | bitjumpers(p->bk, opponent, empty, 3)))
+			return(1);
+	}
+	else {
+		opponent = p->bm | p->bk;
+		if (bitjumpers(p->wm | p->wk, opponent, empty, 2) | bitjumpers(p->wm | p->wk, opponent, empty, 3))
+			return(1);
+		if (p->wk && (bitjumpers(p->wk, opponent, empty, 0) | bitjumpers(p->wk, opponent, empty, 1)))
+			return(1);
+	}
+
+	return(0);
+}
+
+void dobitmove(pos *p, bitmove &move)
+/*----------> purpose: execute move on p
+  ----------> version: 1.0
+  ----------> date: 17th october 2026 */
+{
+	p->bm ^= move.bm;
+	p->bk ^= move.bk;
+	p->wm ^= move.wm;
+	p->wk ^= move.wk;
+}
+
+void undobitmove(pos *p, bitmove &move)
+{
+	/* the changes are stored as xor masks, undoing is the same as doing */
+	dobitmove(p, move);
+}
+
+/*-------------- PART IV: ENDGAME DATABASE -----------------------------------*/
+static unsigned int reversebits(unsigned int x)
+{
+	/* bit i of x becomes bit 31 - i, which turns the board around */
+	x = ((x >> 1) & 0x55555555) | ((x & 0x55555555) << 1);
+	x = ((x >> 2) & 0x33333333) | ((x & 0x33333333) << 2);
+	x = ((x >> 4) & 0x0f0f0f0f) | ((x & 0x0f0f0f0f) << 4);
+	x = ((x >> 8) & 0x00ff00ff) | ((x & 0x00ff00ff) << 8);
+	return((x >> 16) | (x << 16));
+}
+
+static void dbinit(void)
+{
+	int i, j;
+
+	if (binomial[0][0])
+		return;
+	for (i = 0; i <= 32; i++) {
+		binomial[i][0] = 1;
+		for (j = 1; j <= i; j++)
+			binomial[i][j] = binomial[i - 1][j - 1] + binomial[i - 1][j];
+	}
+}
+
+static uint32_t subsetindex(unsigned int pieces, unsigned int excluded)
+{
+	/* index of the set of squares pieces among all sets of the same size
+	   which do not use the squares in excluded. the squares are numbered
+	   0, 1, ... skipping the excluded ones, the index of the set
+	   s1 < s2 < ... < sk is binomial[s1][1] + ... + binomial[sk][k]. */
+	uint32_t index = 0;
+	int square, k = 1;
+
+	while (pieces) {
+		square = lsb(pieces);
+		pieces &= pieces - 1;
+		index += binomial[square - bitcount(excluded & ((1u << square) - 1))][k++];
+	}
+	return(index);
+}
+
+static unsigned int subset(uint32_t index, int k, unsigned int excluded)
+/* the inverse of subsetindex */
+{
+	unsigned int pieces = 0, free;
+	int r, i;
+
+	r = 32 - bitcount(excluded);
+	for (; k > 0; k--) {
+		while (binomial[r][k] > index)
+			r--;
+		index -= binomial[r][k];
+		/* r-th square which is not excluded */
+		free = ~excluded;
+		for (i = 0; i < r; i++)
+			free &= free - 1;
+		pieces |= free & (0 - free);
+	}
+	return(pieces);
+}
+
+static uint32_t dbslicesize(int n[4])
+{
+	/* black men can not be on squares 28-31, white men not on 0-3 */
+	return(binomial[28][n[0]] * binomial[28][n[2]]
+		* binomial[32 - n[0] - n[2]][n[1]] * binomial[32 - n[0] - n[2] - n[1]][n[3]]);
+}
+
+static uint32_t dbindex(DBSLICE *s, pos *p)
+{
+	/* the men of each side are indexed on their 28 squares, the kings on
+	   the squares which are still free. the index of a position where black
+	   and white men overlap is unused. */
+	uint32_t index;
+	unsigned int men = p->bm | p->wm;
+
+	index = subsetindex(p->bm, 0);
+	index = index * binomial[28][s->n[2]] + subsetindex(p->wm, 0x0000000f);
+	index = index * binomial[32 - s->n[0] - s->n[2]][s->n[1]] + subsetindex(p->bk, men);
+	index = index * binomial[32 - s->n[0] - s->n[2] - s->n[1]][s->n[3]] + subsetindex(p->wk, men | p->bk);
+	return(index);
+}
+
+static int dbposition(DBSLICE *s, uint32_t index, pos *p)
+{
+	/* the inverse of dbindex. returns 0 for an unused index */
+	uint32_t nwk, nbk, nwm;
+
+	nwk = binomial[32 - s->n[0] - s->n[2] - s->n[1]][s->n[3]];
+	nbk = binomial[32 - s->n[0] - s->n[2]][s->n[1]];
+	nwm = binomial[28][s->n[2]];
+	p->bm = subset(index / nwk / nbk / nwm, s->n[0], 0xf0000000);
+	p->wm = subset(index / nwk / nbk % nwm, s->n[2], 0xf0000000) << 4;
+	if (p->bm & p->wm)
+		return(0);
+	p->bk = subset(index / nwk % nbk, s->n[1], p->bm | p->wm);
+	p->wk = subset(index % nwk, s->n[3], p->bm | p->wm | p->bk);
+	return(1);
+}
+
+static unsigned char dbcachebyte(DBSLICE *s, uint32_t offset);
+
+static inline int dbvalue(DBSLICE *s, uint32_t index)
+{
+	unsigned char values;
+
+	if (s->values != NULL)
+		values = s->values[index >> 2];
+	else
+		values = dbcachebyte(s, index >> 2);
+	return((values >> (2 * (index & 3))) & 3);
+}
+
+static inline void dbsetvalue(DBSLICE *s, uint32_t index, int value)
+{
+	s->values[index >> 2] = (unsigned char)((s->values[index >> 2] & ~(3 << (2 * (index & 3)))) | (value << (2 * (index & 3))));
+}
+
+static void dbblacktomove(pos *p, int color, pos *q)
+{
+	/* p with color to move as the same position with black to move */
+	if (color == BLACK)
+		*q = *p;
+	else {
+		q->bm = reversebits(p->wm);
+		q->bk = reversebits(p->wk);
+		q->wm = reversebits(p->bm);
+		q->wk = reversebits(p->bk);
+	}
+}
+
+int dblookup(pos *p, int color, int pieces)
+/*----------> purpose: look up p with color to move in the database slices with
+  ---------->          up to pieces pieces. returns DB_WIN, DB_LOSS or DB_DRAW
+  ---------->          for color, or DB_UNKNOWN if p is not in the database.
+  ----------> version: 1.0
+  ----------> date: 17th october 2026 */
+{
+	pos q;
+	int nb, nw;
+	DBSLICE *s;
+
+	dbblacktomove(p, color, &q);
+
+	nb = bitcount(q.bm | q.bk);
+	nw = bitcount(q.wm | q.wk);
+	if (nb + nw > pieces)
+		return(DB_UNKNOWN);
+	if (nb == 0)
+		return(DB_LOSS);
+	if (nw == 0)
+		return(DB_WIN);
+
+	s = dbslice[bitcount(q.bm)][bitcount(q.bk)][bitcount(q.wm)][bitcount(q.wk)];
+	if (s == NULL)
+		return(DB_UNKNOWN);
+	return(dbvalue(s, dbindex(s, &q)));
+}
+
+int dbprobe(SearchContext *ctx, pos *p, int color, int *value)
+/*----------> purpose: if p is in the database, return 1 and its score from
+  ---------->          black's point of view in *value. won positions are
+  ---------->          scored DBWIN plus the evaluation, so that the search
+  ---------->          still prefers the simpler wins.
+  ----------> version: 1.0
+  ----------> date: 17th october 2026 */
+{
+	int result;
+
+	if (!ctx->tables || ctx->eval.n[0] + ctx->eval.n[1] + ctx->eval.n[2] + ctx->eval.n[3] > dbprobepieces)
+		return(0);
+
+	result = dblookup(p, color, dbprobepieces);
+	if (result == DB_UNKNOWN)
+		return(0);
+#ifdef STATISTICS
+	ctx->dbhits++;
+#endif
+
+	if (result == DB_DRAW) {
+		*value = 0;
+		return(1);
+	}
+	*value = std::max(-DBWINRANGE, std::min(DBWINRANGE, evaluation(ctx, p, color)));
+	if ((result == DB_WIN) == (color == BLACK))
+		*value += DBWIN;
+	else
+		*value -= DBWIN;
+	return(1);
+}
+
+static void dbcache_resize(int mbytes)
+{
+	/* share the budget of mbytes among the cache shards, in whole blocks.
+	   the caller holds dbtables exclusively, no search reads the cache. */
+	int i, k, blocks;
+
+	blocks = (int)(((size_t)mbytes << 20) / DBBLOCKSIZE);
+	dbcacheshards = std::min(blocks, DBCACHESHARDS);
+	for (k = 0; k < DBCACHESHARDS; k++) {
+		DBCACHESHARD &shard = dbcache[k];
+		int n = k < dbcacheshards ? blocks / dbcacheshards + (k < blocks % dbcacheshards) : 0;
+
+		shard.index.clear();
+		shard.index.reserve(n);
+		shard.entries.assign(n, DBCACHEENTRY());
+		shard.memory.assign((size_t)n * DBBLOCKSIZE, 0);
+		for (i = 0; i < n; i++) {
+			shard.entries[i].key = DBNOKEY;
+			shard.entries[i].prev = i - 1;
+			shard.entries[i].next = i + 1 < n ? i + 1 : -1;
+			shard.entries[i].data = &shard.memory[(size_t)i * DBBLOCKSIZE];
+		}
+		shard.head = n ? 0 : -1;
+		shard.tail = n - 1;
+		shard.hits = shard.misses = shard.evictions = 0;
+	}
+}
+
+static void dbdecompress(const unsigned char *in, const unsigned char *end, unsigned char *out)
+{
+	/* blocks are run length encoded: a control byte c < 128 is followed by
+	   c + 1 bytes which are copied, a control byte c >= 128 by one byte
+	   which is repeated c - 125 times. */
+	unsigned char *outend = out + DBBLOCKSIZE;
+	int c, n;
+
+	while (in < end && out < outend) {
+		c = *in++;
+		if (in + (c < 128 ? c + 1 : 1) > end)
+			break;
+		if (c < 128) {
+			n = std::min(c + 1, (int)(outend - out));
+			memcpy(out, in, n);
+			in += c + 1;
+		}
+		else {
+			n = std::min(c - 125, (int)(outend - out));
+			memset(out, *in++, n);
+		}
+		out += n;
+	}
+	if (out < outend)
+		memset(out, 0, outend - out);
+}
+
+static int dbcompress(const unsigned char *in, unsigned char *out)
+{
+	/* the inverse of dbdecompress for one block. returns the number of bytes
+	   written to out, which has room for DBBLOCKSIZE + DBBLOCKSIZE / 128 + 1 */
+	int i = 0, j, n = 0, literal = -1;
+
+	while (i < DBBLOCKSIZE) {
+		for (j = i + 1; j < DBBLOCKSIZE && j - i < 130 && in[j] == in[i]; j++)
+			;
+		if (j - i >= 3) {
+			out[n++] = (unsigned char)(j - i + 125);
+			out[n++] = in[i];
+			literal = -1;
+			i = j;
+			continue;
+		}
+		if (literal < 0 || out[literal] == 127) {
+			literal = n++;
+			out[literal] = 0;
+		}
+		else
+			out[literal]++;
+		out[n++] = in[i++];
+	}
+	return(n);
+}
+
+static unsigned char dbcachebyte(DBSLICE *s, uint32_t offset)
+{
+	/* byte offset of the values of a mapped slice, through the cache */
+	uint32_t block = s->firstblock + offset / DBBLOCKSIZE;
+	uint64_t key = ((uint64_t)s->file->pieces << 32) | block;
+	DBCACHESHARD &shard = dbcache[(key * 0x9e3779b97f4a7c15ull >> 32) % dbcacheshards];
+	std::lock_guard<std::mutex> lock(shard.lock);
+	int i;
+
+	auto it = shard.index.find(key);
+	if (it != shard.index.end()) {
+		i = it->second;
+		shard.hits++;
+	}
+	else {
+		/* reuse the least recently used entry */
+		i = shard.tail;
+		shard.misses++;
+		if (shard.entries[i].key != DBNOKEY) {
+			shard.index.erase(shard.entries[i].key);
+			shard.evictions++;
+		}
+		shard.entries[i].key = key;
+		shard.index[key] = i;
+		dbdecompress(s->file->data + s->file->blockoffset[block],
+					 s->file->data + s->file->blockoffset[block + 1],
+					 shard.entries[i].data);
+	}
+
+	/* move entry i to the front of the list */
+	if (i != shard.head) {
+		DBCACHEENTRY &e = shard.entries[i];
+
+		shard.entries[e.prev].next = e.next;
+		if (e.next >= 0)
+			shard.entries[e.next].prev = e.prev;
+		else
+			shard.tail = e.prev;
+		e.prev = -1;
+		e.next = shard.head;
+		shard.entries[shard.head].prev = i;
+		shard.head = i;
+	}
+	return(shard.entries[i].data[offset % DBBLOCKSIZE]);
+}
+
+static void dbfree(void)
+{
+	int i;
+	DBSLICE **s = &dbslice[0][0][0][0];
+
+	for (i = 0; i < (MAXDBPIECES + 1) * (MAXDBPIECES + 1) * (MAXDBPIECES + 1) * (MAXDBPIECES + 1); i++) {
+		if (s[i] != NULL) {
+			free(s[i]->values);
+			free(s[i]);
+			s[i] = NULL;
+		}
+	}
+	for (i = 0; i <= MAXDBPIECES; i++) {
+		if (dbfile[i].file != NULL) {
+			dbfile[i].file->close();
+			delete dbfile[i].file;
+			dbfile[i].file = NULL;
+		}
+	}
+	dbpieces = 0;
+	dbprobepieces = 0;
+}
+
+static DBSLICE *dbnewslice(int nbm, int nbk, int nwm, int nwk, int allocate)
+{
+	/* a slice, with memory for its values if allocate is set */
+	DBSLICE *s;
+
+	s = (DBSLICE *)calloc(1, sizeof(DBSLICE));
+	if (s == NULL)
+		return(NULL);
+	s->n[0] = nbm;
+	s->n[1] = nbk;
+	s->n[2] = nwm;
+	s->n[3] = nwk;
+	s->size = dbslicesize(s->n);
+	if (allocate) {
+		s->values = (unsigned char *)calloc((s->size + 3) / 4, 1);
+		if (s->values == NULL) {
+			free(s);
+			return(NULL);
+		}
+	}
+	return(s);
+}
+
+/* the database files are called db2.wld, db3.wld, ... in dbpath. each one
+   holds all slices with that number of pieces, their values are split in
+   blocks of DBBLOCKSIZE bytes which are compressed one by one:
+	   "SCWLD2" and a 0 byte, the number of pieces (1 byte)
+	   for every slice: nbm, nbk, nwm, nwk (1 byte each), its first block (4 bytes)
+	   the number of blocks (4 bytes)
+	   for every block and one more: where it starts after the offsets (4 bytes)
+	   the compressed blocks
+   the numbers are stored in the byte order of the machine. */
+static void dbfilename(const char *path, int pieces, char *filename)
+{
+	sprintf(filename, "%s/db%i.wld", path, pieces);
+}
+
+static int dbslicecount(int pieces)
+{
+	/* slices with pieces pieces where both sides have at least one */
+	return((pieces + 1) * (pieces + 2) * (pieces + 3) / 6 - 2 * (pieces + 1));
+}
+
+static int dbmapfile(const char *path, int pieces)
+{
+	/* map the file with pieces pieces in path and create its slices.
+	   returns 0 if the file is missing or damaged. */
+	char filename[300];
+	const unsigned char *data, *toc;
+	int i, count, ok = 1;
+	uint32_t nblocks, blocks;
+	qint64 length;
+	DBFILE *f = &dbfile[pieces];
+	DBSLICE *s;
+
+	dbfilename(path, pieces, filename);
+	f->file = new QFile(QString::fromLocal8Bit(filename));
+	if (!f->file->open(QIODevice::ReadOnly)) {
+		delete f->file;
+		f->file = NULL;
+		return(0);
+	}
+	length = f->file->size();
+	count = dbslicecount(pieces);
+	data = length > 12 + 8 * count ? f->file->map(0, length) : NULL;
+	if (data == NULL || memcmp(data, "SCWLD2", 7) != 0 || data[7] != pieces) {
+		f->file->close();
+		delete f->file;
+		f->file = NULL;
+		return(0);
+	}
+
+	toc = data + 8;
+	memcpy(&nblocks, toc + 8 * count, 4);
+	f->pieces = pieces;
+	if (8 + 8 * count + 4 + 4 * ((qint64)nblocks + 1) > length)
+		ok = 0;
+	else {
+		f->blockoffset = (const uint32_t *)(toc + 8 * count + 4);
+		f->data = (const unsigned char *)(f->blockoffset + nblocks + 1);
+		if (f->blockoffset[nblocks] > length - (f->data - data))
+			ok = 0;
+		for (blocks = 0; blocks < nblocks && ok; blocks++) {
+			if (f->blockoffset[blocks] > f->blockoffset[blocks + 1])
+				ok = 0;
+		}
+	}
+
+	for (i = 0; i < count && ok; i++) {
+		const unsigned char *n = toc + 8 * i;
+
+		if (n[0] + n[1] + n[2] + n[3] != pieces || n[0] + n[1] == 0 || n[2] + n[3] == 0
+			|| dbslice[n[0]][n[1]][n[2]][n[3]] != NULL) {
+			ok = 0;
+			break;
+		}
+		s = dbnewslice(n[0], n[1], n[2], n[3], 0);
+		if (s == NULL) {
+			ok = 0;
+			break;
+		}
+		s->file = f;
+		memcpy(&s->firstblock, n + 4, 4);
+		blocks = ((s->size + 3) / 4 + DBBLOCKSIZE - 1) / DBBLOCKSIZE;
+		dbslice[n[0]][n[1]][n[2]][n[3]] = s;
+		if (s->firstblock + blocks > nblocks)
+			ok = 0;
+	}
+
+	if (!ok) {
+		for (i = 0; i < count; i++) {
+			const unsigned char *n = toc + 8 * i;
+
+			if (n[0] + n[1] + n[2] + n[3] != pieces)
+				break;
+			s = dbslice[n[0]][n[1]][n[2]][n[3]];
+			if (s != NULL && s->file == f) {
+				dbslice[n[0]][n[1]][n[2]][n[3]] = NULL;
+				free(s);
+			}
+		}
+		f->file->close();
+		delete f->file;
+		f->file = NULL;
+	}
+	return(ok);
+}
+
+static int dbreadfile(const char *path, int pieces)
+{
+	/* for the builder: map the file with pieces pieces in path and
+	   decompress all of its slices into memory. returns 0 if the file is
+	   missing, damaged or does not fit in memory. */
+	int nbm, nbk, nwm, nwk, ok = 1;
+	uint32_t block, blocks, bytes;
+	unsigned char buffer[DBBLOCKSIZE];
+	DBFILE *f = &dbfile[pieces];
+	DBSLICE *s;
+
+	if (!dbmapfile(path, pieces))
+		return(0);
+
+	for (nbm = 0; nbm <= pieces; nbm++)
+		for (nbk = 0; nbm + nbk <= pieces; nbk++)
+			for (nwm = 0; nbm + nbk + nwm <= pieces; nwm++) {
+				nwk = pieces - nbm - nbk - nwm;
+				s = dbslice[nbm][nbk][nwm][nwk];
+				if (s == NULL || !ok)
+					continue;
+				bytes = (s->size + 3) / 4;
+				s->values = (unsigned char *)malloc(bytes);
+				if (s->values == NULL) {
+					ok = 0;
+					continue;
+				}
+				blocks = (bytes + DBBLOCKSIZE - 1) / DBBLOCKSIZE;
+				for (block = 0; block < blocks; block++) {
+					dbdecompress(f->data + f->blockoffset[s->firstblock + block],
+								 f->data + f->blockoffset[s->firstblock + block + 1],
+								 buffer);
+					memcpy(s->values + block * DBBLOCKSIZE, buffer, std::min(bytes - block * DBBLOCKSIZE, (uint32_t)DBBLOCKSIZE));
+				}
+			}
+
+	f->file->close();
+	delete f->file;
+	f->file = NULL;
+	return(ok);
+}
+
+int db_load(void)
+/*----------> purpose: map the database files in dbpath, as many piece counts
+  ---------->          as are complete and allowed by max_dbpieces, and size
+  ---------->          the cache to dbmbytes. returns the number of pieces
+  ---------->          loaded. the caller holds dbmutex, and dbtables
+  ---------->          exclusively.
+  ----------> version: 1.1
+  ----------> date: 17th october 2026 */
+{
+	int pieces;
+
+	dbinit();
+	dbfree();
+	dbcache_resize(dbmbytes);
+	dbdirty = 0;
+	if (!enable_wld || dbcacheshards == 0)
+		return(0);
+
+	for (pieces = 2; pieces <= std::min(max_dbpieces, MAXDBPIECES); pieces++) {
+		if (!dbmapfile(dbpath, pieces))
+			break;
+		dbpieces = pieces;
+	}
+	dbprobepieces = dbpieces;
+	return(dbpieces);
+}
+
+void db_newsearch(void)
+{
+	/* reload the database and the moves to conversion tables if the settings
+	   changed since the last search. while other searches read them or a
+	   build is running, the reload waits for a later search. */
+	std::unique_lock<std::shared_mutex> tables(dbtables, std::try_to_lock);
+
+	if (!tables.owns_lock())
+		return;
+	std::lock_guard<std::mutex> lock(dbmutex);
+	if (dbdirty)
+		db_load();
+	if (mtcdirty)
+		mtc_load();
+}
+
+static void dbreload(void)
+{
+	/* after a build, load what the settings ask for. the caller holds
+	   dbtables exclusively. */
+	std::lock_guard<std::mutex> lock(dbmutex);
+
+	db_load();
+	mtc_load();
+}
+
+int dbcache_stats(uint64_t *hits, uint64_t *misses, uint64_t *evictions)
+{
+	/* returns 0 if the cache is being resized */
+	int k;
+	std::shared_lock<std::shared_mutex> tables(dbtables, std::try_to_lock);
+
+	if (!tables.owns_lock())
+		return(0);
+	*hits = *misses = *evictions = 0;
+	for (k = 0; k < dbcacheshards; k++) {
+		std::lock_guard<std::mutex> lock(dbcache[k].lock);
+
+		*hits += dbcache[k].hits;
+		*misses += dbcache[k].misses;
+		*evictions += dbcache[k].evictions;
+	}
+	return(1);
+}
+
+static void buildprogress(const char *fmt, ...)
+{
+	/* what the running build does, for "get buildstatus" */
+	va_list args;
+	std::lock_guard<std::mutex> lock(buildmutex);
+
+	va_start(args, fmt);
+	vsnprintf(buildstatus, sizeof(buildstatus), fmt, args);
+	va_end(args);
+}
+
+/* while a group of slices is built, every position has a counter byte: for
+   an undecided one, the number of its moves which do not lead to a position
+   known to be won for the opponent. DBPROPAGATE marks a position which was
+   decided and whose predecessors have not been told yet. */
+#define DBPROPAGATE 255
+
+typedef struct {
+	DBSLICE **slices;
+	unsigned char **counts;				/* the counter bytes of each slice */
+	int slot[MAXDBPIECES + 1][MAXDBPIECES + 1];	/* the slice with nbm black men and nbk black kings */
+	int pieces;
+} DBGROUP;
+
+static void dbdecide(DBGROUP *g, int slot, uint32_t index, int value)
+{
+	dbsetvalue(g->slices[slot], index, value);
+	g->counts[slot][index] = value == DB_DRAW ? 0 : DBPROPAGATE;
+}
+
+static void dbcountmoves(DBGROUP *g, int slot, uint32_t index, pos *p)
+{
+	/* decide p, black to move, from the moves which leave the group, or set
+	   its counter. captures and promotions leave it, their results are
+	   known. a position with a capture is always decided here. */
+	int i, n, value, ingroup = 0, count = 0;
+	bitmove movelist[MAXMOVES];
+
+	if (testbitcapture(p, BLACK))
+		n = generatebitcapturelist(p, movelist, BLACK);
+	else
+		n = generatebitmovelist(p, movelist, BLACK);
+
+	for (i = 0; i < n; i++) {
+		if (movelist[i].wm == 0 && movelist[i].wk == 0 && (movelist[i].bm == 0 || movelist[i].bk == 0)) {
+			ingroup = 1;
+			count++;
+			continue;
+		}
+		dobitmove(p, movelist[i]);
+		value = dblookup(p, WHITE, g->pieces);
+		undobitmove(p, movelist[i]);
+		if (value == DB_LOSS) {
+			dbdecide(g, slot, index, DB_WIN);
+			return;
+		}
+		if (value != DB_WIN)
+			count++;
+	}
+
+	if (count == 0)
+		dbdecide(g, slot, index, DB_LOSS);
+	else if (!ingroup)
+		dbdecide(g, slot, index, DB_DRAW);
+	else
+		g->counts[slot][index] = (unsigned char)count;
+}
+
+static void dbpropagate(DBGROUP *g, DBSLICE *s, pos *q, int value)
+{
+	/* q, black to move, was decided with value. it is the same position as
+	   r, q turned around with white to move, which black reached by a king
+	   move or a man move without promotion. undo each of these to find the
+	   predecessors in the group, and tell them. */
+	int d, slot;
+	unsigned int empty, pieces, to, from;
+	uint32_t index;
+	pos r, p;
+
+	r.bm = reversebits(q->wm);
+	r.bk = reversebits(q->wk);
+	r.wm = reversebits(q->bm);
+	r.wk = reversebits(q->bk);
+	empty = ~(r.bm | r.bk | r.wm | r.wk);
+	slot = g->slot[s->n[2]][s->n[3]];
+
+	for (d = 0; d < 4; d++) {
+		/* men only move up, towards white */
+		for (pieces = d < 2 ? r.bm | r.bk : r.bk; pieces; pieces &= pieces - 1) {
+			to = pieces & (0 - pieces);
+			from = step(to, d ^ 3) & empty;
+			if (from == 0)
+				continue;
+			p = r;
+			if (r.bm & to)
+				p.bm ^= from | to;
+			else
+				p.bk ^= from | to;
+
+			index = dbindex(g->slices[slot], &p);
+			if (dbvalue(g->slices[slot], index) != DB_UNKNOWN)
+				continue;
+			if (value == DB_LOSS)
+				dbdecide(g, slot, index, DB_WIN);
+			else if (value == DB_WIN && --g->counts[slot][index] == 0)
+				dbdecide(g, slot, index, DB_LOSS);
+		}
+	}
+}
+
+static int dbbuildgroup(DBSLICE **group, int count, int pieces)
+{
+	/* retrograde analysis of the slices in group, which only depend on each
+	   other and on slices which are complete. first every position is
+	   decided from its moves which leave the group, or gets a counter of
+	   its moves. then each pass goes over the positions decided since the
+	   last one and undoes the moves which led to them: a predecessor of a
+	   lost position is won, one of a won position is lost once its counter
+	   reaches 0. when a pass decides nothing, the undecided positions are
+	   draws. returns 1, 0 if the build was cancelled, -1 if there was not
+	   enough memory. */
+	int i, changed, pass = 0, result = 1;
+	uint32_t index;
+	pos p;
+	DBSLICE *s;
+	DBGROUP g;
+	std::vector<unsigned char *> counts(count, (unsigned char *)NULL);
+
+	g.slices = group;
+	g.counts = counts.data();
+	g.pieces = pieces;
+	for (i = 0; i < count; i++) {
+		g.slot[group[i]->n[0]][group[i]->n[1]] = i;
+		counts[i] = (unsigned char *)calloc(group[i]->size, 1);
+		if (counts[i] == NULL)
+			result = -1;
+	}
+
+	buildprogress("builddb: %i-piece database, %i men, counting moves", pieces, group[0]->n[0] + group[0]->n[2]);
+	for (i = 0; i < count && result == 1; i++) {
+		if (buildcancel.load(std::memory_order_relaxed)) {
+			result = 0;
+			break;
+		}
+		s = group[i];
+		for (index = 0; index < s->size; index++) {
+			if (!dbposition(s, index, &p))
+				dbsetvalue(s, index, DB_DRAW);
+			else
+				dbcountmoves(&g, i, index, &p);
+		}
+	}
+
+	for (changed = 1; changed && result == 1; ) {
+		changed = 0;
+		buildprogress("builddb: %i-piece database, %i men, pass %i", pieces, group[0]->n[0] + group[0]->n[2], ++pass);
+		for (i = 0; i < count; i++) {
+			if (buildcancel.load(std::memory_order_relaxed)) {
+				result = 0;
+				break;
+			}
+			s = group[i];
+			for (index = 0; index < s->size; index++) {
+				if (counts[i][index] != DBPROPAGATE)
+					continue;
+				counts[i][index] = 0;
+				changed = 1;
+				dbposition(s, index, &p);
+				dbpropagate(&g, s, &p, dbvalue(s, index));
+			}
+		}
+	}
+
+	for (i = 0; i < count; i++) {
+		s = group[i];
+		for (index = 0; index < s->size && result == 1; index++) {
+			if (dbvalue(s, index) == DB_UNKNOWN)
+				dbsetvalue(s, index, DB_DRAW);
+		}
+		free(counts[i]);
+	}
+	return(result);
+}
+
+static int dbsavefile(const char *path, int pieces)
+{
+	/* write the slices with pieces pieces, which are in memory, to path */
+	char filename[300];
+	unsigned char n[8];
+	unsigned char block[DBBLOCKSIZE];
+	int nbm, nbk, nwm, nwk, ok, length;
+	uint32_t b, blocks, bytes, nblocks = 0;
+	FILE *fp;
+	DBSLICE *s;
+	std::vector<uint32_t> offsets(1, 0);
+	std::vector<unsigned char> data;
+	unsigned char compressed[DBBLOCKSIZE + DBBLOCKSIZE / 128 + 1];
+
+	dbfilename(path, pieces, filename);
+	fp = fopen(filename, "wb");
+	if (fp == NULL)
+		return(0);
+	ok = fwrite("SCWLD2", 1, 7, fp) == 7 && fputc(pieces, fp) != EOF;
+
+	for (nbm = 0; nbm <= pieces; nbm++)
+		for (nbk = 0; nbm + nbk <= pieces; nbk++)
+			for (nwm = 0; nbm + nbk + nwm <= pieces; nwm++) {
+				nwk = pieces - nbm - nbk - nwm;
+				s = dbslice[nbm][nbk][nwm][nwk];
+				if (s == NULL)
+					continue;
+				n[0] = (unsigned char)nbm;
+				n[1] = (unsigned char)nbk;
+				n[2] = (unsigned char)nwm;
+				n[3] = (unsigned char)nwk;
+				memcpy(n + 4, &nblocks, 4);
+				ok = ok && fwrite(n, 1, 8, fp) == 8;
+
+				/* the last block of a slice is filled up with zeros */
+				bytes = (s->size + 3) / 4;
+				blocks = (bytes + DBBLOCKSIZE - 1) / DBBLOCKSIZE;
+				for (b = 0; b < blocks; b++) {
+					memset(block, 0, DBBLOCKSIZE);
+					memcpy(block, s->values + b * DBBLOCKSIZE, std::min(bytes - b * DBBLOCKSIZE, (uint32_t)DBBLOCKSIZE));
+					length = dbcompress(block, compressed);
+					data.insert(data.end(), compressed, compressed + length);
+					offsets.push_back((uint32_t)data.size());
+				}
+				nblocks += blocks;
+			}
+
+	ok = ok && fwrite(&nblocks, 4, 1, fp) == 1;
+	ok = ok && fwrite(offsets.data(), 4, offsets.size(), fp) == offsets.size();
+	ok = ok && fwrite(data.data(), 1, data.size(), fp) == data.size();
+	if (fclose(fp) != 0)
+		ok = 0;
+	return(ok);
+}
+
+int db_build(int pieces, char *reply)
+/*----------> purpose: build the databases with up to pieces pieces by
+  ---------->          retrograde analysis and write them to dbpath. piece
+  ---------->          counts for which a file is already there are read
+  ---------->          instead. the result is loaded for the search.
+  ---------->          searches which start during the build run without
+  ---------->          the database.
+  ----------> version: 1.3
+  ----------> date: 17th october 2026 */
+{
+	int n, men, nbm, nbk, nwm, nwk, count, result;
+	char path[256];
+	double t;
+	DBSLICE *group[(MAXDBPIECES + 1) * (MAXDBPIECES + 1) * (MAXDBPIECES + 1)];
+	DBSLICE *s;
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+	{
+		std::lock_guard<std::mutex> lock(dbmutex);
+		strcpy(path, dbpath);
+	}
+	std::unique_lock<std::shared_mutex> tables(dbtables);
+	dbinit();
+	dbfree();
+
+	for (n = 2; n <= pieces; n++) {
+		if (dbreadfile(path, n)) {
+			dbpieces = n;
+			continue;
+		}
+
+		/* promotions turn a man into a king, captures remove pieces: slices
+		   with fewer men only depend on the ones already built. slices with
+		   the same number of men depend on each other through the moves of
+		   the other side and are built together. */
+		for (men = 0; men <= n; men++) {
+			count = 0;
+			for (nbm = 0; nbm <= men; nbm++) {
+				nwm = men - nbm;
+				for (nbk = 0; nbm + nbk + nwm <= n; nbk++) {
+					nwk = n - nbm - nbk - nwm;
+					if (nbm + nbk == 0 || nwm + nwk == 0)
+						continue;
+					s = dbnewslice(nbm, nbk, nwm, nwk, 1);
+					if (s == NULL) {
+						sprintf(reply, "builddb: out of memory building the %i-piece database", n);
+						dbreload();
+						return(0);
+					}
+					dbslice[nbm][nbk][nwm][nwk] = s;
+					group[count++] = s;
+				}
+			}
+			result = dbbuildgroup(group, count, n);
+			if (result != 1) {
+				if (result == 0)
+					sprintf(reply, "builddb: cancelled while building the %i-piece database", n);
+				else
+					sprintf(reply, "builddb: out of memory building the %i-piece database", n);
+				dbreload();
+				return(0);
+			}
+		}
+
+		if (!dbsavefile(path, n)) {
+			sprintf(reply, "builddb: could not write %s/db%i.wld", path, n);
+			dbreload();
+			return(0);
+		}
+		dbpieces = n;
+	}
+
+	/* what the search uses is limited by the settings */
+	t = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	dbreload();
+	sprintf(reply, "built the %i-piece database in %.1fs, loaded %i pieces", pieces, t, dbpieces);
+	return(1);
+}
+
+/* the moves to conversion tables are called db2.mtc, db3.mtc, ... in mtcpath.
+   each one holds all slices with that number of pieces, one byte per
+   position, uncompressed:
+	   "SCMTC1" and a 0 byte, the number of pieces (1 byte)
+	   for every slice: nbm, nbk, nwm, nwk (1 byte each), where its values
+	   start after the slice list (4 bytes)
+	   the values of the slices
+   the numbers are stored in the byte order of the machine. */
+static void mtcfilename(const char *path, int pieces, char *filename)
+{
+	sprintf(filename, "%s/db%i.mtc", path, pieces);
+}
+
+static inline int isconversion(bitmove &move, int color)
+{
+	/* a man moves or a piece is captured: the position can not come back */
+	return((move.bm | move.wm | (color == BLACK ? move.wk : move.bk)) != 0);
+}
+
+int mtclookup(pos *p, int color)
+/*----------> purpose: look up the number of plies until p with color to move
+  ---------->          converts in the moves to conversion tables. returns
+  ---------->          MTC_UNKNOWN if p is not in the tables.
+  ----------> version: 1.0
+  ----------> date: 17th october 2026 */
+{
+	pos q;
+	DBSLICE *s;
+
+	dbblacktomove(p, color, &q);
+	if ((q.bm | q.bk) == 0 || (q.wm | q.wk) == 0)
+		return(MTC_UNKNOWN);
+	if (bitcount(q.bm | q.bk | q.wm | q.wk) > MAXDBPIECES)
+		return(MTC_UNKNOWN);
+	s = mtcslice[bitcount(q.bm)][bitcount(q.bk)][bitcount(q.wm)][bitcount(q.wk)];
+	if (s == NULL || s->values == NULL)
+		return(MTC_UNKNOWN);
+	return(s->values[dbindex(s, &q)]);
+}
+
+int mtcprobe(pos *p, int color, bitmove *best, int *plies)
+/*----------> purpose: if p is won for color and in the moves to conversion
+  ---------->          tables, find the winning move which converts fastest.
+  ---------->          every move of a won endgame comes from here, also
+  ---------->          close to the conversion: the search scores all
+  ---------->          database wins alike and may shuffle between them.
+  ---------->          returns 0 if the tables do not know p.
+  ----------> version: 1.1
+  ----------> date: 17th october 2026 */
+{
+	int i, n, value, pieces;
+	bitmove movelist[MAXMOVES];
+
+	pieces = bitcount(p->bm | p->bk | p->wm | p->wk);
+	if (!enable_mtc || pieces > mtcpieces || pieces > dbprobepieces)
+		return(0);
+	if (dblookup(p, color, dbprobepieces) != DB_WIN)
+		return(0);
+
+	if (testbitcapture(p, color))
+		n = generatebitcapturelist(p, movelist, color);
+	else
+		n = generatebitmovelist(p, movelist, color);
+
+	*plies = MTC_UNKNOWN;
+	for (i = 0; i < n; i++) {
+		dobitmove(p, movelist[i]);
+		if (dblookup(p, CB_CHANGECOLOR(color), dbprobepieces) == DB_LOSS) {
+			if (isconversion(movelist[i], color))
+				value = 0;
+			else
+				value = mtclookup(p, CB_CHANGECOLOR(color));
+			if (value != MTC_UNKNOWN && value + 1 < *plies) {
+				*plies = value + 1;
+				*best = movelist[i];
+			}
+		}
+		undobitmove(p, movelist[i]);
+	}
+	return(*plies != MTC_UNKNOWN);
+}
+
+static void mtcfree(void)
+{
+	/* the values of the slices are in the mapped files */
+	int i;
+	DBSLICE **s = &mtcslice[0][0][0][0];
+
+	for (i = 0; i < (MAXDBPIECES + 1) * (MAXDBPIECES + 1) * (MAXDBPIECES + 1) * (MAXDBPIECES + 1); i++) {
+		free(s[i]);
+		s[i] = NULL;
+	}
+	for (i = 0; i <= MAXDBPIECES; i++) {
+		if (mtcfile[i] != NULL) {
+			mtcfile[i]->close();
+			delete mtcfile[i];
+			mtcfile[i] = NULL;
+		}
+	}
+	mtcpieces = 0;
+}
+
+static int mtcmapfile(int pieces)
+{
+	/* map the file with pieces pieces and create its slices. returns 0 if
+	   the file is missing or damaged. */
+	char filename[300];
+	unsigned char *data;
+	const unsigned char *n;
+	int i, count, ok = 1;
+	uint32_t offset;
+	qint64 length, start;
+	DBSLICE *s;
+
+	mtcfilename(mtcpath, pieces, filename);
+	mtcfile[pieces] = new QFile(QString::fromLocal8Bit(filename));
+	count = dbslicecount(pieces);
+	start = 8 + 8 * count;
+	data = NULL;
+	if (mtcfile[pieces]->open(QIODevice::ReadOnly)) {
+		length = mtcfile[pieces]->size();
+		if (length > start)
+			data = mtcfile[pieces]->map(0, length);
+	}
+	if (data == NULL || memcmp(data, "SCMTC1", 7) != 0 || data[7] != pieces) {
+		mtcfile[pieces]->close();
+		delete mtcfile[pieces];
+		mtcfile[pieces] = NULL;
+		return(0);
+	}
+
+	for (i = 0; i < count && ok; i++) {
+		n = data + 8 + 8 * i;
+		if (n[0] + n[1] + n[2] + n[3] != pieces || n[0] + n[1] == 0 || n[2] + n[3] == 0
+			|| mtcslice[n[0]][n[1]][n[2]][n[3]] != NULL) {
+			ok = 0;
+			break;
+		}
+		s = dbnewslice(n[0], n[1], n[2], n[3], 0);
+		if (s == NULL) {
+			ok = 0;
+			break;
+		}
+		memcpy(&offset, n + 4, 4);
+		s->values = data + start + offset;
+		mtcslice[n[0]][n[1]][n[2]][n[3]] = s;
+		if (start + offset + s->size > length)
+			ok = 0;
+	}
+
+	if (!ok) {
+		for (i = 0; i < count; i++) {
+			n = data + 8 + 8 * i;
+			if (n[0] + n[1] + n[2] + n[3] != pieces)
+				break;
+			s = mtcslice[n[0]][n[1]][n[2]][n[3]];
+			if (s != NULL && s->values >= data && s->values < data + length) {
+				mtcslice[n[0]][n[1]][n[2]][n[3]] = NULL;
+				free(s);
+			}
+		}
+		mtcfile[pieces]->close();
+		delete mtcfile[pieces];
+		mtcfile[pieces] = NULL;
+	}
+	return(ok);
+}
+
+int mtc_load(void)
+/*----------> purpose: map the moves to conversion tables in mtcpath, as many
+  ---------->          piece counts as are complete and allowed by
+  ---------->          max_dbpieces. returns the number of pieces loaded. the
+  ---------->          caller holds dbmutex, and dbtables exclusively.
+  ----------> version: 1.0
+  ----------> date: 17th october 2026 */
+{
+	int pieces;
+
+	dbinit();
+	mtcfree();
+	mtcdirty = 0;
+	if (!enable_mtc)
+		return(0);
+
+	for (pieces = 2; pieces <= std::min(max_dbpieces, MAXDBPIECES); pieces++) {
+		if (!mtcmapfile(pieces))
+			break;
+		mtcpieces = pieces;
+	}
+	return(mtcpieces);
+}
+
+void mtc_checkdir(const char *path, char *reply)
+{
+	/* for the options dialog: which tables are in path */
+	char filename[300], header[8];
+	int pieces, found = 0;
+	FILE *fp;
+
+	for (pieces = 2; pieces <= MAXDBPIECES; pieces++) {
+		mtcfilename(path, pieces, filename);
+		fp = fopen(filename, "rb");
+		if (fp == NULL)
+			break;
+		if (fread(header, 1, 8, fp) != 8 || memcmp(header, "SCMTC1", 7) != 0 || header[7] != pieces) {
+			fclose(fp);
+			break;
+		}
+		fclose(fp);
+		found = pieces;
+	}
+	if (found)
+		sprintf(reply, "moves to conversion tables for 2 to %i pieces in %.200s", found, path);
+	else
+		sprintf(reply, "no moves to conversion tables in %.200s", path);
+}
+
+static int mtcsolve(pos *p, int result, int pieces, int k)
+{
+	/* plies until p, black to move, converts, from what is known about its
+	   successors so far: the winner converts as fast as possible, the loser
+	   as late as possible. MTC_UNKNOWN if that is more than k plies or not
+	   decided yet. result is the database value of p. */
+	int i, n, value, best = MTC_UNKNOWN, worst = 0;
+	bitmove movelist[MAXMOVES];
+
+	if (testbitcapture(p, BLACK))
+		n = generatebitcapturelist(p, movelist, BLACK);
+	else
+		n = generatebitmovelist(p, movelist, BLACK);
+	if (n == 0)
+		return(0);
+
+	for (i = 0; i < n; i++) {
+		dobitmove(p, movelist[i]);
+		if (result == DB_WIN && dblookup(p, WHITE, pieces) != DB_LOSS)
+			value = -1;
+		else if (isconversion(movelist[i], BLACK))
+			value = 0;
+		else
+			value = mtclookup(p, WHITE);
+		undobitmove(p, movelist[i]);
+
+		if (result == DB_WIN) {
+			if (value >= 0 && value < best)
+				best = value;
+		}
+		else {
+			if (value == MTC_UNKNOWN)
+				return(MTC_UNKNOWN);
+			worst = std::max(worst, value);
+		}
+	}
+
+	if (result == DB_LOSS)
+		best = worst;
+	if (best == MTC_UNKNOWN || best + 1 > k)
+		return(MTC_UNKNOWN);
+	return(std::min(best + 1, MTCMAXPLIES));
+}
+
+static int mtcbuildgroup(DBSLICE **group, int count, int pieces)
+{
+	/* moves to conversion of the won and lost positions in group, which only
+	   lead to each other without a conversion. pass k finds exactly the
+	   positions which convert in k plies: a won one if a winning move
+	   converts or leads to a position which converts in k - 1 plies, a lost
+	   one if all of its moves do so in at most k - 1. a position which
+	   converts in k plies leads to one which does in k - 1, so once a pass
+	   finds nothing, all are found. draws and unused indices get 0. returns
+	   0 if the build was cancelled. */
+	int i, k, changed, value;
+	uint32_t index;
+	pos p;
+	DBSLICE *s, *wld;
+
+	for (i = 0; i < count; i++) {
+		s = group[i];
+		wld = dbslice[s->n[0]][s->n[1]][s->n[2]][s->n[3]];
+		for (index = 0; index < s->size; index++) {
+			value = dbposition(s, index, &p) ? dbvalue(wld, index) : DB_DRAW;
+			s->values[index] = (value == DB_WIN || value == DB_LOSS) ? MTC_UNKNOWN : 0;
+		}
+	}
+
+	for (k = 1, changed = 1; changed; k++) {
+		changed = 0;
+		buildprogress("buildmtc: %i-piece tables, %i men, %i plies", pieces, group[0]->n[0] + group[0]->n[2], k);
+		for (i = 0; i < count; i++) {
+			if (buildcancel.load(std::memory_order_relaxed))
+				return(0);
+			s = group[i];
+			wld = dbslice[s->n[0]][s->n[1]][s->n[2]][s->n[3]];
+			for (index = 0; index < s->size; index++) {
+				if (s->values[index] != MTC_UNKNOWN)
+					continue;
+				dbposition(s, index, &p);
+				value = mtcsolve(&p, dbvalue(wld, index), pieces, k);
+				if (value != MTC_UNKNOWN) {
+					s->values[index] = (unsigned char)value;
+					changed = 1;
+				}
+			}
+		}
+	}
+	return(1);
+}
+
+int mtc_build(int pieces, char *reply)
+/*----------> purpose: build the moves to conversion tables with up to pieces
+  ---------->          pieces from the win/loss/draw database in dbpath, which
+  ---------->          must be complete, and write them to mtcpath. the
+  ---------->          result is loaded for the search. searches which
+  ---------->          start during the build run without the database.
+  ----------> version: 1.1
+  ----------> date: 17th october 2026 */
+{
+	int n, men, nbm, nbk, nwm, nwk, i, count, ok, cancelled = 0, longest = 0;
+	char path[256], tablepath[256], filename[300];
+	unsigned char header[8];
+	uint32_t offset;
+	double t;
+	FILE *fp;
+	DBSLICE *group[(MAXDBPIECES + 1) * (MAXDBPIECES + 1) * (MAXDBPIECES + 1)];
+	DBSLICE *s;
+	std::vector<uint32_t> offsets;
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+	{
+		std::lock_guard<std::mutex> lock(dbmutex);
+		strcpy(path, dbpath);
+		strcpy(tablepath, mtcpath);
+	}
+	std::unique_lock<std::shared_mutex> tables(dbtables);
+	dbinit();
+	dbfree();
+	mtcfree();
+
+	for (n = 2; n <= pieces; n++) {
+		if (!dbreadfile(path, n)) {
+			sprintf(reply, "buildmtc: the %i-piece database is not in %.200s, run builddb first", n, path);
+			dbreload();
+			return(0);
+		}
+		dbpieces = n;
+
+		/* the slice list, the values follow in the same order */
+		mtcfilename(tablepath, n, filename);
+		fp = fopen(filename, "wb");
+		if (fp == NULL) {
+			sprintf(reply, "buildmtc: could not write %.250s", filename);
+			dbreload();
+			return(0);
+		}
+		memcpy(header, "SCMTC1", 7);
+		header[7] = (unsigned char)n;
+		ok = fwrite(header, 1, 8, fp) == 8;
+		offset = 0;
+		offsets.assign((MAXDBPIECES + 1) * (MAXDBPIECES + 1) * (MAXDBPIECES + 1), 0);
+		for (nbm = 0; nbm <= n; nbm++)
+			for (nbk = 0; nbm + nbk <= n; nbk++)
+				for (nwm = 0; nbm + nbk + nwm <= n; nwm++) {
+					nwk = n - nbm - nbk - nwm;
+					if (nbm + nbk == 0 || nwm + nwk == 0)
+						continue;
+					header[0] = (unsigned char)nbm;
+					header[1] = (unsigned char)nbk;
+					header[2] = (unsigned char)nwm;
+					header[3] = (unsigned char)nwk;
+					memcpy(header + 4, &offset, 4);
+					ok = ok && fwrite(header, 1, 8, fp) == 8;
+					offsets[(nbm * (MAXDBPIECES + 1) + nbk) * (MAXDBPIECES + 1) + nwm] = offset;
+					offset += dbslice[nbm][nbk][nwm][nwk]->size;
+				}
+
+		/* conversions leave the slices with the same number of men, they
+		   are built together and written to their place in the file. */
+		for (men = 0; men <= n && ok; men++) {
+			count = 0;
+			for (nbm = 0; nbm <= men; nbm++) {
+				nwm = men - nbm;
+				for (nbk = 0; nbm + nbk + nwm <= n; nbk++) {
+					nwk = n - nbm - nbk - nwm;
+					if (nbm + nbk == 0 || nwm + nwk == 0)
+						continue;
+					s = dbnewslice(nbm, nbk, nwm, nwk, 0);
+					if (s != NULL)
+						s->values = (unsigned char *)malloc(s->size);
+					if (s == NULL || s->values == NULL) {
+						free(s);
+						ok = 0;
+						break;
+					}
+					mtcslice[nbm][nbk][nwm][nwk] = s;
+					group[count++] = s;
+				}
+			}
+			if (ok && !mtcbuildgroup(group, count, n)) {
+				ok = 0;
+				cancelled = 1;
+			}
+
+			for (i = 0; i < count; i++) {
+				s = group[i];
+				if (ok) {
+					offset = offsets[(s->n[0] * (MAXDBPIECES + 1) + s->n[1]) * (MAXDBPIECES + 1) + s->n[2]];
+					ok = fseek(fp, 8 + 8 * dbslicecount(n) + (long)offset, SEEK_SET) == 0
+						&& fwrite(s->values, 1, s->size, fp) == s->size;
+					longest = std::max(longest, (int)*std::max_element(s->values, s->values + s->size));
+				}
+				free(s->values);
+				s->values = NULL;
+			}
+			if (cancelled)
+				sprintf(reply, "buildmtc: cancelled while building the %i-piece tables", n);
+			else if (!ok)
+				sprintf(reply, "buildmtc: out of memory or disk space building the %i-piece tables", n);
+		}
+		mtcfree();
+		if (fclose(fp) != 0 && ok) {
+			sprintf(reply, "buildmtc: could not write %.250s", filename);
+			ok = 0;
+		}
+		if (!ok) {
+			remove(filename);
+			dbreload();
+			return(0);
+		}
+	}
+
+	/* what the search uses is limited by the settings */
+	t = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	dbreload();
+	sprintf(reply, "built the %i-piece moves to conversion tables in %.1fs, longest conversion %i plies, loaded %i pieces",
+			pieces, t, longest, mtcpieces);
+	return(1);
+}
+
+static void buildrun(int mtc, int pieces)
+{
+	char reply[256];
+
+	if (mtc)
+		mtc_build(pieces, reply);
+	else
+		db_build(pieces, reply);
+
+	std::lock_guard<std::mutex> lock(buildmutex);
+	strcpy(buildstatus, reply);
+	buildrunning = 0;
+}
+
+int build_start(int mtc, int pieces, char *reply)
+/*----------> purpose: start building the database (mtc 0) or the moves to
+  ---------->          conversion tables (mtc 1) with up to pieces pieces on
+  ---------->          the build thread. "get buildstatus" shows how far it
+  ---------->          got and then its result, "buildcancel" stops it.
+  ----------> version: 1.0
+  ----------> date: 17th october 2026 */
+{
+	std::lock_guard<std::mutex> lock(buildmutex);
+
+	if (buildrunning) {
+		sprintf(reply, "%s: a build is running, %.200s", mtc ? "buildmtc" : "builddb", buildstatus);
+		return(0);
+	}
+	/* the last build has finished, or is about to */
+	if (builder.thread.joinable())
+		builder.thread.join();
+	buildrunning = 1;
+	buildcancel.store(0, std::memory_order_relaxed);
+	sprintf(buildstatus, "%s %i: starting", mtc ? "buildmtc" : "builddb", pieces);
+	builder.thread = std::thread(buildrun, mtc, pieces);
+	sprintf(reply, "%s %i: started, see get buildstatus", mtc ? "buildmtc" : "builddb", pieces);
+	return(1);
+}
+
+/*-------------- PART V: OPENING BOOK ----------------------------------------*/
+static inline bool bookentryless(const BOOKENTRY &a, const BOOKENTRY &b)
+{
+	if (a.key != b.key)
+		return(a.key < b.key);
+	if (a.from != b.from)
+		return(a.from < b.from);
+	return(a.to < b.to);
+}
+
+static void bookfree(void)
+{
+	if (bookqfile != NULL) {
+		bookqfile->close();
+		delete bookqfile;
+		bookqfile = NULL;
+	}
+	book = NULL;
+	bookentries = 0;
+}
+
+int book_load(void)
+/*----------> purpose: map the book file. the entries are used where they are
+  ---------->          in the mapped file. returns the number of entries, 0 if
+  ---------->          the file is missing or damaged. the caller holds
+  ---------->          bookmutex, and dbtables exclusively.
+  ----------> version: 1.0
+  ----------> date: 17th october 2026 */
+{
+	unsigned char *data;
+	uint32_t count;
+	qint64 length;
+
+	bookfree();
+	bookdirty = 0;
+	if (bookfile[0] == 0)
+		return(0);
+
+	bookqfile = new QFile(QString::fromLocal8Bit(bookfile));
+	data = NULL;
+	length = 0;
+	if (bookqfile->open(QIODevice::ReadOnly)) {
+		length = bookqfile->size();
+		if (length >= BOOKHEADERSIZE)
+			data = bookqfile->map(0, length);
+	}
+	if (data != NULL && memcmp(data, "SCBOOK1", 8) == 0) {
+		memcpy(&count, data + 8, 4);
+		if (length == (qint64)(BOOKHEADERSIZE + (uint64_t)count * sizeof(BOOKENTRY))) {
+			book = (const BOOKENTRY *)(data + BOOKHEADERSIZE);
+			bookentries = count;
+			return(bookentries);
+		}
+	}
+	bookfree();
+	return(0);
+}
+
+void book_newsearch(void)
+{
+	/* reload the book if the settings changed since the last search. while
+	   other searches read it, the reload waits for a later search. */
+	std::unique_lock<std::shared_mutex> tables(dbtables, std::try_to_lock);
+
+	if (!tables.owns_lock())
+		return;
+	std::lock_guard<std::mutex> lock(bookmutex);
+	if (bookdirty)
+		book_load();
+}
+
+int bookmove(pos *p, int color, bitmove *best, char *str)
+/*----------> purpose: look p up in the opening book. if it is there, choose
+  ---------->          one of its moves according to booklevel: the one with
+  ---------->          the best results, or one of the good ones or any one at
+  ---------->          random, weighted by how often it was played.
+  ----------> returns 1 if a book move was found, and describes it in str.
+  ----------> version: 1.0
+  ----------> date: 17th october 2026 */
+{
+	int i, j, n, count, total, games;
+	double score[MAXMOVES], bestscore = -1;
+	const BOOKENTRY *entry[MAXMOVES], *chosen;
+	bitmove movelist[MAXMOVES], moves[MAXMOVES];
+	BOOKENTRY key;
+	char str2[80];
+
+	if (booklevel == BOOK_OFF || book == NULL)
+		return(0);
+
+	/* the moves of p are a run of entries with its key */
+	key.key = hashposition(p, color);
+	key.from = key.to = 0;
+	const BOOKENTRY *first = std::lower_bound(book, book + bookentries, key, bookentryless);
+
+	if (testbitcapture(p, color))
+		n = generatebitcapturelist(p, movelist, color);
+	else
+		n = generatebitmovelist(p, movelist, color);
+
+	/* only take entries which are legal moves here: a different position
+	   with the same key would find nonsense */
+	count = 0;
+	for (; first < book + bookentries && first->key == key.key; first++) {
+		for (i = 0; i < n; i++) {
+			if (movelist[i].from == first->from && movelist[i].to == first->to)
+				break;
+		}
+		if (i == n)
+			return(0);
+		games = first->wins + first->draws + first->losses;
+		if (games == 0)
+			continue;
+		moves[count] = movelist[i];
+		entry[count] = first;
+		score[count] = (first->wins + 0.5 * first->draws) / games;
+		bestscore = std::max(bestscore, score[count]);
+		count++;
+	}
+	if (count == 0)
+		return(0);
+
+	/* keep the candidates for booklevel at the start of the list */
+	for (i = 0, j = 0; i < count; i++) {
+		if (booklevel == BOOK_ALLKINDS
+			|| (booklevel == BOOK_GOOD && score[i] >= bestscore - BOOKGOODMARGIN)
+			|| (booklevel == BOOK_BEST && score[i] == bestscore
+				&& (j == 0 || entry[i]->weight > entry[0]->weight))) {
+			if (booklevel == BOOK_BEST)
+				j = 0;
+			moves[j] = moves[i];
+			entry[j] = entry[i];
+			score[j] = score[i];
+			j++;
+		}
+	}
+	count = j;
+
+	total = 0;
+	for (i = 0; i < count; i++)
+		total += entry[i]->weight;
+	j = total > 0 ? rand() % total : 0;
+	for (i = 0; i < count - 1 && j >= entry[i]->weight; i++)
+		j -= entry[i]->weight;
+	chosen = entry[i];
+	*best = moves[i];
+
+	movetonotation(*best, str2);
+	sprintf(str, "best:%s  book move, played %i times, +%u =%u -%u",
+			str2, chosen->weight, chosen->wins, chosen->draws, chosen->losses);
+	return(1);
+}
+
+static int bookgame(const char *game, std::vector<BOOKENTRY> &entries)
+{
+	/* add the first BOOKMAXPLY moves of a PDN game to entries. the result of
+	   the game counts for the side which made the move. games which do not
+	   start from the initial position are skipped. returns the number of
+	   moves added. */
+	char header[256], tag[256], token[256];
+	const char *start, *tagstart;
+	int i, n, ply, result = 0, color = BLACK;
+	Squarelist squares;
+	bitmove movelist[MAXMOVES];
+	BOOKENTRY entry;
+	pos p;
+
+	/* result from black's point of view: 1, -1, 0 for a draw, 2 unknown */
+	result = 2;
+	start = game;
+	while (PDNparseGetnextheader(&start, header, sizeof(header))) {
+		tagstart = header;
+		if (!PDNparseGetnexttag(&tagstart, tag, sizeof(tag)))
+			continue;
+		if (strncmp(header, "FEN", 3) == 0 || (strncmp(header, "SetUp", 5) == 0 && strcmp(tag, "1") == 0))
+			return(0);
+		if (strncmp(header, "GameType", 8) == 0 && atoi(tag) != GT_ENGLISH)
+			return(0);
+		if (strncmp(header, "Result", 6) == 0) {
+			if (strcmp(tag, "1-0") == 0)
+				result = 1;
+			else if (strcmp(tag, "0-1") == 0)
+				result = -1;
+			else if (strcmp(tag, "1/2-1/2") == 0)
+				result = 0;
+		}
+	}
+
+	p.bm = 0x00000fff;
+	p.bk = 0;
+	p.wm = 0xfff00000;
+	p.wk = 0;
+	for (ply = 0; ply < BOOKMAXPLY && PDNparseGetnextPDNtoken(&start, token, sizeof(token)); ) {
+		if (PDNparseMove(token, squares) == 0)
+			continue;
+
+		if (testbitcapture(&p, color))
+			n = generatebitcapturelist(&p, movelist, color);
+		else
+			n = generatebitmovelist(&p, movelist, color);
+		for (i = 0; i < n; i++) {
+			if (squarenumber(movelist[i].from) == squares.first() && squarenumber(movelist[i].to) == squares.last())
+				break;
+		}
+		if (i == n)
+			break;
+
+		entry.key = hashposition(&p, color);
+		entry.from = movelist[i].from;
+		entry.to = movelist[i].to;
+		entry.weight = 1;
+		entry.wins = result != 2 && result == (color == BLACK ? 1 : -1);
+		entry.losses = result != 2 && result == (color == BLACK ? -1 : 1);
+		entry.draws = result == 0;
+		entries.push_back(entry);
+
+		dobitmove(&p, movelist[i]);
+		color = CB_CHANGECOLOR(color);
+		ply++;
+	}
+	return(ply);
+}
+
+int book_build(const char *pdnfile, char *reply)
+/*----------> purpose: build the opening book from the games in pdnfile and
+  ---------->          write it to bookfile: every position of the openings
+  ---------->          with the moves played in it, how often and with which
+  ---------->          results. moves played less than BOOKMINGAMES times are
+  ---------->          left out. the result is loaded for the search.
+  ----------> version: 1.0
+  ----------> date: 17th october 2026 */
+{
+	int ngames = 0, i, j, ok;
+	unsigned char header[BOOKHEADERSIZE];
+	uint32_t count;
+	char *start;
+	FILE *fp;
+	QFile file(QString::fromLocal8Bit(pdnfile));
+	QByteArray text;
+	std::vector<char> game;
+	std::vector<BOOKENTRY> entries;
+
+	if (!file.open(QIODevice::ReadOnly)) {
+		sprintf(reply, "buildbook: could not read %.200s", pdnfile);
+		return(0);
+	}
+	text = file.readAll();
+	file.close();
+
+	std::call_once(hashkeysonce, inithashkeys);
+
+	/* a game is never longer than the file */
+	game.resize(text.size() + 1);
+	start = text.data();
+	while (PDNparseGetnextgame(&start, game.data(), (int)game.size())) {
+		if (bookgame(game.data(), entries))
+			ngames++;
+	}
+
+	/* the same move in the same position is merged into one entry */
+	std::sort(entries.begin(), entries.end(), bookentryless);
+	for (i = 0, j = -1; i < (int)entries.size(); i++) {
+		if (j >= 0 && entries[j].key == entries[i].key && entries[j].from == entries[i].from && entries[j].to == entries[i].to) {
+			entries[j].weight = (uint16_t)std::min(entries[j].weight + 1, 0xffff);
+			entries[j].wins += entries[i].wins;
+			entries[j].losses += entries[i].losses;
+			entries[j].draws += entries[i].draws;
+		}
+		else if (j < 0 || entries[j].weight >= BOOKMINGAMES)
+			entries[++j] = entries[i];
+		else
+			entries[j] = entries[i];
+	}
+	if (j >= 0 && entries[j].weight < BOOKMINGAMES)
+		j--;
+	entries.resize(j + 1);
+
+	/* the old book is mapped, wait until no search reads it */
+	std::unique_lock<std::shared_mutex> tables(dbtables);
+	std::lock_guard<std::mutex> lock(bookmutex);
+	bookfree();
+	fp = fopen(bookfile, "wb");
+	if (fp == NULL) {
+		sprintf(reply, "buildbook: could not write %.200s", bookfile);
+		return(0);
+	}
+	memset(header, 0, sizeof(header));
+	memcpy(header, "SCBOOK1", 8);
+	count = (uint32_t)entries.size();
+	memcpy(header + 8, &count, 4);
+	ok = fwrite(header, 1, BOOKHEADERSIZE, fp) == BOOKHEADERSIZE;
+	ok = ok && fwrite(entries.data(), sizeof(BOOKENTRY), entries.size(), fp) == entries.size();
+	if (fclose(fp) != 0)
+		ok = 0;
+	if (!ok) {
+		sprintf(reply, "buildbook: could not write %.200s", bookfile);
+		remove(bookfile);
+		return(0);
+	}
+
+	book_load();
+	sprintf(reply, "built the book from %i games: %u moves in %.200s", ngames, count, bookfile);
+	return(1);
+}
+
+#ifdef MTCGEN
+int main(int argc, char *argv[])
+{
+	/* the generator as a command line program: compile this file with MTCGEN
+	   defined, together with PDNparser.c and utility.c, link it with QtCore
+	   and run it as
+		   mtcgen pieces [dbpath [mtcpath]]
+	   it builds the win/loss/draw database first where it is missing. */
+	char reply[256];
+	int pieces;
+
+	if (argc < 2 || (pieces = atoi(argv[1])) < 2 || pieces > MAXDBPIECES) {
+		fprintf(stderr, "usage: mtcgen pieces [dbpath [mtcpath]], pieces 2 to %i\n", MAXDBPIECES);
+		return(1);
+	}
+	if (argc > 2)
+		snprintf(dbpath, sizeof(dbpath), "%s", argv[2]);
+	snprintf(mtcpath, sizeof(mtcpath), "%s", argc > 3 ? argv[3] : dbpath);
+	max_dbpieces = pieces;
+
+	if (!db_build(pieces, reply)) {
+		fprintf(stderr, "%s\n", reply);
+		return(1);
+	}
+	printf("%s\n", reply);
+	if (!mtc_build(pieces, reply)) {
+		fprintf(stderr, "%s\n", reply);
+		return(1);
+	}
+	printf("%s\n", reply);
+	return(0);
+}
+#endif
@@ -1 +1 @@
-#include <assert.h>
+#include <assert.h>
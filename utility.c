@@ -41,6 +41,45 @@ char *read_text_file_qt(const QString &filename, READ_TEXT_FILE_ERROR_TYPE &etyp
     return buffer;
 }
 
+// Maps the file instead of reading it: the pages are loaded by the OS as they
+// are touched, and nothing is copied. The bytes are not converted like
+// read_text_file_qt does, so line ends stay \r\n on Windows files.
+bool MappedTextFile::open(const QString &filename, READ_TEXT_FILE_ERROR_TYPE &etype)
+{
+    close();
+    m_file.setFileName(filename);
+    if (!m_file.open(QIODevice::ReadOnly)) {
+        qWarning() << "Error opening file:" << filename << m_file.errorString();
+        etype = RTF_FILE_ERROR;
+        return false;
+    }
+
+    // an empty file can not be mapped, its text is just empty
+    qint64 size = m_file.size();
+    if (size > 0) {
+        uchar *data = m_file.map(0, size);
+        if (!data) {
+            qWarning() << "Error mapping file:" << filename << m_file.errorString();
+            m_file.close();
+            etype = RTF_MALLOC_ERROR;
+            return false;
+        }
+        m_data = reinterpret_cast<const char *>(data);
+        m_size = (size_t)size;
+    }
+
+    etype = RTF_NO_ERROR;
+    return true;
+}
+
+void MappedTextFile::close()
+{
+    // closing the file also unmaps it
+    m_file.close();
+    m_data = nullptr;
+    m_size = 0;
+}
+
 
 // --- Keep other utility functions below if they exist ---
 // Example: CBlog (Needs porting if it uses Windows specifics)
@@ -1,22 +1,43 @@
-#ifndef UTILITY_H
-#define UTILITY_H
-
-#include <QString> // Include necessary Qt header
-#include "checkers_types.h" // For READ_TEXT_FILE_ERROR_TYPE
-
-// Function Prototypes
-
-// Replaces original read_text_file. Caller MUST free the returned char* buffer.
-char *read_text_file_qt(const QString &filename, READ_TEXT_FILE_ERROR_TYPE &etype);
-
-// Logging functions (simple qDebug wrappers for now)
-void CBlog(const char *fmt, ...);
-void cblog(const char *fmt, ...);
-
-// Safe string copy
-char *strncpy_terminated(char *dest, const char *src, size_t n);
-
-// Declare other utility functions if needed
-
-#endif // UTILITY_H
-
+#ifndef UTILITY_H
+#define UTILITY_H
+
+#include <QFile>
+#include <QString> // Include necessary Qt header
+#include <string_view>
+#include "checkers_types.h" // For READ_TEXT_FILE_ERROR_TYPE
+
+// Function Prototypes
+
+// Replaces original read_text_file. Caller MUST free the returned char* buffer.
+char *read_text_file_qt(const QString &filename, READ_TEXT_FILE_ERROR_TYPE &etype);
+
+// Read-only memory mapping of a whole file, e.g. of a PDN database. text()
+// views the contents of the file in place and stays valid until close().
+class MappedTextFile {
+public:
+    MappedTextFile() {}
+    ~MappedTextFile() { close(); }
+    MappedTextFile(const MappedTextFile &) = delete;
+    MappedTextFile &operator=(const MappedTextFile &) = delete;
+
+    bool open(const QString &filename, READ_TEXT_FILE_ERROR_TYPE &etype);
+    void close();
+    std::string_view text() const { return std::string_view(m_data, m_size); }
+
+private:
+    QFile m_file;
+    const char *m_data = nullptr;
+    size_t m_size = 0;
+};
+
+// Logging functions (simple qDebug wrappers for now)
+void CBlog(const char *fmt, ...);
+void cblog(const char *fmt, ...);
+
+// Safe string copy
+char *strncpy_terminated(char *dest, const char *src, size_t n);
+
+// Declare other utility functions if needed
+
+#endif // UTILITY_H
+